@@ -80,6 +80,121 @@ typedef void (FIXIE_APIENTRYP PFNGLGETOBJECTPTRLABELKHRPROC) (const void *ptr, G
 typedef void (FIXIE_APIENTRYP PFNGLGETPOINTERVKHRPROC) (GLenum pname, void **params);
 #endif
 
+#ifndef GL_EXT_disjoint_timer_query
+#define GL_QUERY_COUNTER_BITS_EXT                               0x8864
+#define GL_CURRENT_QUERY_EXT                                    0x8865
+#define GL_QUERY_RESULT_EXT                                     0x8866
+#define GL_QUERY_RESULT_AVAILABLE_EXT                           0x8867
+#define GL_TIME_ELAPSED_EXT                                     0x88BF
+#define GL_TIMESTAMP_EXT                                        0x8E28
+#define GL_GPU_DISJOINT_EXT                                     0x8FBB
+#endif
+
+#ifndef GL_EXT_disjoint_timer_query
+#define GL_EXT_disjoint_timer_query 1
+#ifdef GL_GLEXT_PROTOTYPES
+FIXIE_API void FIXIE_APIENTRY glGenQueriesEXT (GLsizei n, GLuint *ids);
+FIXIE_API void FIXIE_APIENTRY glDeleteQueriesEXT (GLsizei n, const GLuint *ids);
+FIXIE_API GLboolean FIXIE_APIENTRY glIsQueryEXT (GLuint id);
+FIXIE_API void FIXIE_APIENTRY glBeginQueryEXT (GLenum target, GLuint id);
+FIXIE_API void FIXIE_APIENTRY glEndQueryEXT (GLenum target);
+FIXIE_API void FIXIE_APIENTRY glQueryCounterEXT (GLuint id, GLenum target);
+FIXIE_API void FIXIE_APIENTRY glGetQueryivEXT (GLenum target, GLenum pname, GLint *params);
+FIXIE_API void FIXIE_APIENTRY glGetQueryObjectivEXT (GLuint id, GLenum pname, GLint *params);
+FIXIE_API void FIXIE_APIENTRY glGetQueryObjectuivEXT (GLuint id, GLenum pname, GLuint *params);
+FIXIE_API void FIXIE_APIENTRY glGetQueryObjecti64vEXT (GLuint id, GLenum pname, GLint64 *params);
+FIXIE_API void FIXIE_APIENTRY glGetQueryObjectui64vEXT (GLuint id, GLenum pname, GLuint64 *params);
+FIXIE_API void FIXIE_APIENTRY glGetInteger64vEXT (GLenum pname, GLint64 *params);
+#endif
+typedef void (FIXIE_APIENTRYP PFNGLGENQUERIESEXTPROC) (GLsizei n, GLuint *ids);
+typedef void (FIXIE_APIENTRYP PFNGLDELETEQUERIESEXTPROC) (GLsizei n, const GLuint *ids);
+typedef GLboolean (FIXIE_APIENTRYP PFNGLISQUERYEXTPROC) (GLuint id);
+typedef void (FIXIE_APIENTRYP PFNGLBEGINQUERYEXTPROC) (GLenum target, GLuint id);
+typedef void (FIXIE_APIENTRYP PFNGLENDQUERYEXTPROC) (GLenum target);
+typedef void (FIXIE_APIENTRYP PFNGLQUERYCOUNTEREXTPROC) (GLuint id, GLenum target);
+typedef void (FIXIE_APIENTRYP PFNGLGETQUERYIVEXTPROC) (GLenum target, GLenum pname, GLint *params);
+typedef void (FIXIE_APIENTRYP PFNGLGETQUERYOBJECTIVEXTPROC) (GLuint id, GLenum pname, GLint *params);
+typedef void (FIXIE_APIENTRYP PFNGLGETQUERYOBJECTUIVEXTPROC) (GLuint id, GLenum pname, GLuint *params);
+typedef void (FIXIE_APIENTRYP PFNGLGETQUERYOBJECTI64VEXTPROC) (GLuint id, GLenum pname, GLint64 *params);
+typedef void (FIXIE_APIENTRYP PFNGLGETQUERYOBJECTUI64VEXTPROC) (GLuint id, GLenum pname, GLuint64 *params);
+typedef void (FIXIE_APIENTRYP PFNGLGETINTEGER64VEXTPROC) (GLenum pname, GLint64 *params);
+#endif
+
+#ifndef FIXIE_entry_point_counters
+#define FIXIE_entry_point_counters 1
+typedef struct fixie_entry_point_counters
+{
+    const GLchar* name;
+    GLuint64 calls;
+    GLuint64 total_ns;
+    GLuint64 max_ns;
+    GLuint64 errors;
+} fixie_entry_point_counters;
+FIXIE_API GLuint FIXIE_APIENTRY fixie_get_entry_point_counters(GLuint count, fixie_entry_point_counters *counters);
+FIXIE_API void FIXIE_APIENTRY fixie_reset_entry_point_counters(void);
+#endif
+
+#ifndef FIXIE_statistics
+#define FIXIE_statistics 1
+typedef struct fixie_statistics
+{
+    GLuint64 draw_calls;
+    GLuint64 state_changes;
+    GLuint64 redundant_state_changes;
+    GLuint64 uniform_uploads;
+    GLuint64 shader_cache_hits;
+    GLuint64 shader_cache_misses;
+    GLuint64 shader_compile_ns;
+    GLuint64 buffer_upload_bytes;
+    GLuint64 texture_upload_bytes;
+} fixie_statistics;
+FIXIE_API void FIXIE_APIENTRY fixie_get_statistics(fixie_statistics *statistics, GLboolean reset);
+#endif
+
+#ifndef FIXIE_trace
+#define FIXIE_trace 1
+FIXIE_API void FIXIE_APIENTRY fixie_set_tracing_enabled(GLboolean enabled);
+FIXIE_API GLboolean FIXIE_APIENTRY fixie_dump_trace(const GLchar *path);
+FIXIE_API void FIXIE_APIENTRY fixie_clear_trace(void);
+#endif
+
+#ifndef FIXIE_lighting_hint
+#define FIXIE_lighting_hint 1
+#define GL_LIGHTING_HINT_FIXIE                                  0xFA00
+#endif
+
+#ifndef FIXIE_clear_invalidate_hint
+#define FIXIE_clear_invalidate_hint 1
+#define GL_CLEAR_INVALIDATE_HINT_FIXIE                          0xFA04
+#endif
+
+#ifndef FIXIE_draw_instanced
+#define FIXIE_draw_instanced 1
+#define GL_INSTANCE_MODEL_VIEW_ARRAY_FIXIE                      0xFA01
+#define GL_INSTANCE_COLOR_ARRAY_FIXIE                           0xFA02
+FIXIE_API void FIXIE_APIENTRY fixie_instance_model_view_pointer(GLenum type, GLsizei stride, const GLvoid *pointer);
+FIXIE_API void FIXIE_APIENTRY fixie_instance_color_pointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+FIXIE_API void FIXIE_APIENTRY fixie_draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+FIXIE_API void FIXIE_APIENTRY fixie_draw_elements_instanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLsizei instance_count);
+#endif
+
+#ifndef FIXIE_pack_reverse_row_order
+#define FIXIE_pack_reverse_row_order 1
+#define GL_PACK_REVERSE_ROW_ORDER_FIXIE                         0xFA03
+#endif
+
+#ifndef FIXIE_read_pixels_async
+#define FIXIE_read_pixels_async 1
+FIXIE_API GLuint FIXIE_APIENTRY fixie_read_pixels_async(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type);
+FIXIE_API GLboolean FIXIE_APIENTRY fixie_poll_read_pixels(GLuint request, GLvoid *pixels);
+FIXIE_API void FIXIE_APIENTRY fixie_wait_read_pixels(GLuint request, GLvoid *pixels);
+#endif
+
+#ifndef FIXIE_end_frame
+#define FIXIE_end_frame 1
+FIXIE_API void FIXIE_APIENTRY fixie_end_frame(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
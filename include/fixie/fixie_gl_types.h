@@ -19,6 +19,8 @@ typedef float            GLfloat;
 typedef float            GLclampf;
 typedef int32_t          GLfixed;
 typedef int32_t          GLclampx;
+typedef int64_t          GLint64;
+typedef uint64_t         GLuint64;
 
 typedef intptr_t         GLintptr;
 typedef signed long int  GLsizeiptr;
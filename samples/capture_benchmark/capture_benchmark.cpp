@@ -0,0 +1,177 @@
+#include "fixie/fixie.h"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+#include "fixie/fixie_ext.h"
+
+#include "GLFW/glfw3.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+// Frame capture benchmark rendering into a 1080p framebuffer and reading every frame back, once with a blocking
+// glReadPixels and once through fixie_read_pixels_async with a few frames in flight. Frame times are measured on
+// the CPU against a 60 fps budget, the GPU is not waited on so a stalling readback shows up as a long frame.
+
+static const GLsizei capture_width = 1920;
+static const GLsizei capture_height = 1080;
+static const size_t frames_per_mode = 300;
+static const size_t frames_in_flight = 3;
+static const double frame_budget_ms = 1000.0 / 60.0;
+
+struct capture_mode
+{
+    const char* name;
+    void (*capture)(std::deque<GLuint>& requests, std::vector<GLubyte>& pixels, size_t* captured);
+};
+
+static void capture_blocking(std::deque<GLuint>& requests, std::vector<GLubyte>& pixels, size_t* captured)
+{
+    glReadPixels(0, 0, capture_width, capture_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    (*captured)++;
+}
+
+static void capture_async(std::deque<GLuint>& requests, std::vector<GLubyte>& pixels, size_t* captured)
+{
+    requests.push_back(fixie_read_pixels_async(0, 0, capture_width, capture_height, GL_RGBA, GL_UNSIGNED_BYTE));
+
+    // Collect whatever has finished, only block once the ring is full
+    while (!requests.empty() && fixie_poll_read_pixels(requests.front(), pixels.data()))
+    {
+        requests.pop_front();
+        (*captured)++;
+    }
+    if (requests.size() > frames_in_flight)
+    {
+        fixie_wait_read_pixels(requests.front(), pixels.data());
+        requests.pop_front();
+        (*captured)++;
+    }
+}
+
+static const capture_mode capture_modes[] =
+{
+    { "blocking", capture_blocking },
+    { "async", capture_async },
+};
+
+static void draw_scene(size_t frame)
+{
+    static const GLfloat triangle[] =
+    {
+        -0.8f, -0.8f,
+         0.8f, -0.8f,
+         0.0f,  0.8f,
+    };
+
+    GLfloat t = static_cast<GLfloat>(frame) * 0.02f;
+    glClearColor(0.5f + 0.5f * sinf(t), 0.5f + 0.5f * sinf(t + 2.0f), 0.5f + 0.5f * sinf(t + 4.0f), 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    glRotatef(static_cast<GLfloat>(frame), 0.0f, 0.0f, 1.0f);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, triangle);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+int main(int argc, char** argv)
+{
+    if (!glfwInit())
+    {
+        return -1;
+    }
+
+    GLFWwindow* window = glfwCreateWindow(SAMPLE_WIDTH, SAMPLE_HEIGHT, SAMPLE_NAME, NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (extensions == NULL || strstr(extensions, "GL_OES_framebuffer_object") == NULL || strstr(extensions, "GL_OES_rgb8_rgba8") == NULL ||
+        strstr(extensions, "GL_FIXIE_read_pixels_async") == NULL)
+    {
+        printf("GL_OES_framebuffer_object, GL_OES_rgb8_rgba8 and GL_FIXIE_read_pixels_async are required.\n");
+        fixie_terminate();
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return -1;
+    }
+
+    GLuint renderbuffer;
+    glGenRenderbuffersOES(1, &renderbuffer);
+    glBindRenderbufferOES(GL_RENDERBUFFER_OES, renderbuffer);
+    glRenderbufferStorageOES(GL_RENDERBUFFER_OES, GL_RGBA8_OES, capture_width, capture_height);
+
+    GLuint framebuffer;
+    glGenFramebuffersOES(1, &framebuffer);
+    glBindFramebufferOES(GL_FRAMEBUFFER_OES, framebuffer);
+    glFramebufferRenderbufferOES(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES, GL_RENDERBUFFER_OES, renderbuffer);
+    glViewport(0, 0, capture_width, capture_height);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    std::vector<GLubyte> pixels(static_cast<size_t>(capture_width) * static_cast<size_t>(capture_height) * 4);
+
+    for (size_t mode = 0; mode < sizeof(capture_modes) / sizeof(capture_modes[0]) && !glfwWindowShouldClose(window); mode++)
+    {
+        std::deque<GLuint> requests;
+        size_t captured = 0;
+        size_t over_budget = 0;
+        double elapsed_ms = 0.0;
+        double worst_ms = 0.0;
+
+        for (size_t frame = 0; frame < frames_per_mode; frame++)
+        {
+            auto frame_start = std::chrono::steady_clock::now();
+            draw_scene(frame);
+            capture_modes[mode].capture(requests, pixels, &captured);
+            glFlush();
+            auto frame_end = std::chrono::steady_clock::now();
+
+            // Skip the first frame of each mode, it includes shader compilation and buffer allocation
+            if (frame > 0)
+            {
+                double frame_ms = std::chrono::duration<double, std::milli>(frame_end - frame_start).count();
+                elapsed_ms += frame_ms;
+                worst_ms = std::max(worst_ms, frame_ms);
+                over_budget += (frame_ms > frame_budget_ms) ? 1 : 0;
+            }
+
+            glfwPollEvents();
+        }
+
+        while (!requests.empty())
+        {
+            fixie_wait_read_pixels(requests.front(), pixels.data());
+            requests.pop_front();
+            captured++;
+        }
+
+        printf("%-10s %8.3f ms/frame, worst %8.3f ms, %u of %u frames over the 60 fps budget (%u %ux%u captures)\n", capture_modes[mode].name,
+               elapsed_ms / (frames_per_mode - 1), worst_ms, static_cast<unsigned int>(over_budget), static_cast<unsigned int>(frames_per_mode - 1),
+               static_cast<unsigned int>(captured), static_cast<unsigned int>(capture_width), static_cast<unsigned int>(capture_height));
+    }
+
+    glBindFramebufferOES(GL_FRAMEBUFFER_OES, 0);
+    glDeleteFramebuffersOES(1, &framebuffer);
+    glDeleteRenderbuffersOES(1, &renderbuffer);
+
+    fixie_terminate();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
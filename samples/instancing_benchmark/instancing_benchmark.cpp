@@ -0,0 +1,273 @@
+#include "fixie/fixie.h"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+#include "fixie/fixie_ext.h"
+
+#include "GLFW/glfw3.h"
+
+#include "sample_util/random.hpp"
+#include "sample_util/transformations.hpp"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// Instancing benchmark comparing one instanced draw of a prop field against the classic ES 1.1 loop of
+// glLoadMatrixf, glColor4ub and glDrawElements per prop. Both modes rebuild the instance matrices on the CPU
+// every frame, frame times include the glFinish so the driver and GPU work are counted.
+
+static const size_t prop_count = 10000;
+static const size_t frames_per_mode = 100;
+static const GLfloat field_size = 100.0f;
+
+struct prop
+{
+    GLfloat position[3];
+    GLfloat angle;
+    GLfloat spin;
+    GLubyte color[4];
+};
+
+struct instance
+{
+    GLfloat model_view[16];
+    GLubyte color[4];
+};
+
+struct instancing_mode
+{
+    const char* name;
+    void (*draw)(const std::vector<instance>& instances, GLuint instance_buffer);
+};
+
+static const GLsizei cube_index_count = 36;
+
+static void create_cube(GLuint* vertex_buffer, GLuint* index_buffer)
+{
+    static const GLfloat faces[6][3] =
+    {
+        {  1.0f,  0.0f,  0.0f }, { -1.0f,  0.0f,  0.0f },
+        {  0.0f,  1.0f,  0.0f }, {  0.0f, -1.0f,  0.0f },
+        {  0.0f,  0.0f,  1.0f }, {  0.0f,  0.0f, -1.0f },
+    };
+
+    // Interleaved positions and normals, four vertices per face
+    std::vector<GLfloat> vertices;
+    std::vector<GLushort> indices;
+    for (size_t face = 0; face < 6; face++)
+    {
+        const GLfloat* n = faces[face];
+        GLfloat u[3] = { n[1], n[2], n[0] };
+        GLfloat v[3] = { n[1] * u[2] - n[2] * u[1], n[2] * u[0] - n[0] * u[2], n[0] * u[1] - n[1] * u[0] };
+
+        GLushort base = static_cast<GLushort>(vertices.size() / 6);
+        for (size_t corner = 0; corner < 4; corner++)
+        {
+            GLfloat su = (corner & 1) ? 0.5f : -0.5f;
+            GLfloat sv = (corner & 2) ? 0.5f : -0.5f;
+            for (size_t i = 0; i < 3; i++)
+            {
+                vertices.push_back(n[i] * 0.5f + u[i] * su + v[i] * sv);
+            }
+            vertices.insert(vertices.end(), n, n + 3);
+        }
+
+        const GLushort face_indices[] = { 0, 1, 2, 2, 1, 3 };
+        for (size_t i = 0; i < 6; i++)
+        {
+            indices.push_back(static_cast<GLushort>(base + face_indices[i]));
+        }
+    }
+
+    glGenBuffers(1, vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, *vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(GLfloat) * vertices.size()), vertices.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, index_buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *index_buffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(GLushort) * indices.size()), indices.data(), GL_STATIC_DRAW);
+}
+
+static std::vector<prop> create_props()
+{
+    std::vector<prop> props(prop_count);
+    for (size_t i = 0; i < props.size(); i++)
+    {
+        prop& p = props[i];
+        p.position[0] = sample_util::random_between(-field_size, field_size);
+        p.position[1] = sample_util::random_between(-field_size, field_size);
+        p.position[2] = sample_util::random_between(-3.0f * field_size, -field_size);
+        p.angle = sample_util::random_between(0.0f, 6.2831853f);
+        p.spin = sample_util::random_between(-0.05f, 0.05f);
+        for (size_t j = 0; j < 3; j++)
+        {
+            p.color[j] = static_cast<GLubyte>(sample_util::random_between(64.0f, 255.0f));
+        }
+        p.color[3] = 255;
+    }
+    return props;
+}
+
+static void update_instances(std::vector<prop>& props, std::vector<instance>& instances)
+{
+    instances.resize(props.size());
+    for (size_t i = 0; i < props.size(); i++)
+    {
+        prop& p = props[i];
+        p.angle += p.spin;
+
+        // Rotation about the y axis followed by the prop translation, column major
+        GLfloat c = cosf(p.angle);
+        GLfloat s = sinf(p.angle);
+        const GLfloat model_view[16] =
+        {
+               c, 0.0f,   -s, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+               s, 0.0f,    c, 0.0f,
+            p.position[0], p.position[1], p.position[2], 1.0f,
+        };
+
+        instance& inst = instances[i];
+        std::copy(model_view, model_view + 16, inst.model_view);
+        std::copy(p.color, p.color + 4, inst.color);
+    }
+}
+
+static void draw_classic_loop(const std::vector<instance>& instances, GLuint instance_buffer)
+{
+    glMatrixMode(GL_MODELVIEW);
+    for (size_t i = 0; i < instances.size(); i++)
+    {
+        const instance& inst = instances[i];
+        glLoadMatrixf(inst.model_view);
+        glColor4ub(inst.color[0], inst.color[1], inst.color[2], inst.color[3]);
+        glDrawElements(GL_TRIANGLES, cube_index_count, GL_UNSIGNED_SHORT, 0);
+    }
+}
+
+static void draw_instanced(const std::vector<instance>& instances, GLuint instance_buffer)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(instance) * instances.size()), instances.data(), GL_DYNAMIC_DRAW);
+
+    glEnableClientState(GL_INSTANCE_MODEL_VIEW_ARRAY_FIXIE);
+    fixie_instance_model_view_pointer(GL_FLOAT, sizeof(instance), reinterpret_cast<const GLvoid*>(offsetof(instance, model_view)));
+    glEnableClientState(GL_INSTANCE_COLOR_ARRAY_FIXIE);
+    fixie_instance_color_pointer(4, GL_UNSIGNED_BYTE, sizeof(instance), reinterpret_cast<const GLvoid*>(offsetof(instance, color)));
+
+    fixie_draw_elements_instanced(GL_TRIANGLES, cube_index_count, GL_UNSIGNED_SHORT, 0, static_cast<GLsizei>(instances.size()));
+
+    glDisableClientState(GL_INSTANCE_COLOR_ARRAY_FIXIE);
+    glDisableClientState(GL_INSTANCE_MODEL_VIEW_ARRAY_FIXIE);
+}
+
+static const instancing_mode instancing_modes[] =
+{
+    { "classic_loop", draw_classic_loop },
+    { "instanced", draw_instanced },
+};
+
+int main(int argc, char** argv)
+{
+    if (!glfwInit())
+    {
+        return -1;
+    }
+
+    GLFWwindow* window = glfwCreateWindow(SAMPLE_WIDTH, SAMPLE_HEIGHT, SAMPLE_NAME, NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (extensions == NULL || strstr(extensions, "GL_FIXIE_draw_instanced") == NULL)
+    {
+        printf("GL_FIXIE_draw_instanced is not supported by this context.\n");
+        fixie_terminate();
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return -1;
+    }
+
+    GLuint vertex_buffer, index_buffer;
+    create_cube(&vertex_buffer, &index_buffer);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(GLfloat) * 6, reinterpret_cast<const GLvoid*>(0));
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_FLOAT, sizeof(GLfloat) * 6, reinterpret_cast<const GLvoid*>(sizeof(GLfloat) * 3));
+
+    GLuint instance_buffer;
+    glGenBuffers(1, &instance_buffer);
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_LIGHT0);
+
+    std::vector<prop> props = create_props();
+    std::vector<instance> instances;
+
+    std::vector<double> elapsed_ms(sizeof(instancing_modes) / sizeof(instancing_modes[0]), 0.0);
+    std::vector<size_t> timed_frames(elapsed_ms.size(), 0);
+
+    size_t frame = 0;
+    while (!glfwWindowShouldClose(window) && frame < frames_per_mode * elapsed_ms.size())
+    {
+        size_t mode = frame / frames_per_mode;
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        glViewport(0, 0, width, height);
+
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        sample_util::perspective_matrix(60.0f, static_cast<GLfloat>(width) / static_cast<GLfloat>(height), 1.0f, 4.0f * field_size);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+
+        auto frame_start = std::chrono::steady_clock::now();
+        update_instances(props, instances);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        instancing_modes[mode].draw(instances, instance_buffer);
+        glFinish();
+        auto frame_end = std::chrono::steady_clock::now();
+
+        // Skip the first frame of each mode, it includes shader compilation
+        if ((frame % frames_per_mode) != 0)
+        {
+            elapsed_ms[mode] += std::chrono::duration<double, std::milli>(frame_end - frame_start).count();
+            timed_frames[mode]++;
+        }
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        frame++;
+    }
+
+    for (size_t i = 0; i < elapsed_ms.size(); i++)
+    {
+        double average_ms = timed_frames[i] > 0 ? elapsed_ms[i] / timed_frames[i] : 0.0;
+        printf("%-16s %8.3f ms/frame over %u frames (%u props)\n", instancing_modes[i].name, average_ms,
+               static_cast<unsigned int>(timed_frames[i]), static_cast<unsigned int>(prop_count));
+    }
+
+    glDeleteBuffers(1, &instance_buffer);
+    glDeleteBuffers(1, &index_buffer);
+    glDeleteBuffers(1, &vertex_buffer);
+
+    fixie_terminate();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "fixie/fixie.h"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+#include "fixie/fixie_ext.h"
+
+#include "GLFW/glfw3.h"
+
+#include "sample_util/lighting.hpp"
+#include "sample_util/material.hpp"
+#include "sample_util/random.hpp"
+
+#include <stdio.h>
+#include <vector>
+
+// Fill-rate benchmark comparing per-vertex and per-fragment lighting. Each frame draws a stack of
+// full screen, lit quads so the cost is dominated by fragment shading.
+
+static const size_t light_count = 8;
+static const size_t overdraw = 16;
+static const size_t frames_per_mode = 200;
+
+struct lighting_mode
+{
+    const char* name;
+    GLenum hint;
+};
+
+static const lighting_mode lighting_modes[] =
+{
+    { "per_vertex", GL_DONT_CARE },
+    { "per_fragment", GL_NICEST },
+};
+
+static void initialize_lights()
+{
+    for (size_t i = 0; i < light_count; i++)
+    {
+        sample_util::light light;
+        light.enabled = true;
+        light.diffuse = sample_util::construct_array(sample_util::random_between(0.0f, 0.25f),
+                                                     sample_util::random_between(0.0f, 0.25f),
+                                                     sample_util::random_between(0.0f, 0.25f),
+                                                     1.0f);
+        light.specular = light.diffuse;
+        light.position = sample_util::construct_array(sample_util::random_between(-1.0f, 1.0f),
+                                                      sample_util::random_between(-1.0f, 1.0f),
+                                                      0.5f,
+                                                      1.0f);
+        light.linear_attenuation = 0.5f;
+        sample_util::sync_light(GL_LIGHT0 + static_cast<GLenum>(i), light);
+    }
+}
+
+static void draw_frame()
+{
+    static const GLfloat positions[] =
+    {
+        -1.0f, -1.0f, 0.0f,
+         1.0f, -1.0f, 0.0f,
+        -1.0f,  1.0f, 0.0f,
+         1.0f,  1.0f, 0.0f,
+    };
+    static const GLfloat normals[] =
+    {
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 1.0f,
+    };
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, positions);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_FLOAT, 0, normals);
+
+    for (size_t i = 0; i < overdraw; i++)
+    {
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (!glfwInit())
+    {
+        return -1;
+    }
+
+    GLFWwindow* window = glfwCreateWindow(SAMPLE_WIDTH, SAMPLE_HEIGHT, SAMPLE_NAME, NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    sample_util::material material;
+    material.specular_exponent = 32.0f;
+    sample_util::sync_material(GL_FRONT_AND_BACK, material);
+    initialize_lights();
+    glEnable(GL_LIGHTING);
+
+    GLuint query;
+    glGenQueriesEXT(1, &query);
+
+    std::vector<GLuint64> elapsed_ns(sizeof(lighting_modes) / sizeof(lighting_modes[0]), 0);
+    std::vector<size_t> timed_frames(elapsed_ns.size(), 0);
+
+    size_t frame = 0;
+    while (!glfwWindowShouldClose(window) && frame < frames_per_mode * elapsed_ns.size())
+    {
+        size_t mode = frame / frames_per_mode;
+        glHint(GL_LIGHTING_HINT_FIXIE, lighting_modes[mode].hint);
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        glViewport(0, 0, width, height);
+
+        glBeginQueryEXT(GL_TIME_ELAPSED_EXT, query);
+        glClear(GL_COLOR_BUFFER_BIT);
+        draw_frame();
+        glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+
+        GLuint64 frame_ns = 0;
+        glGetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &frame_ns);
+
+        GLint disjoint = GL_FALSE;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+        // Skip the first frame of each mode, it includes shader compilation
+        if (!disjoint && (frame % frames_per_mode) != 0)
+        {
+            elapsed_ns[mode] += frame_ns;
+            timed_frames[mode]++;
+        }
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        frame++;
+    }
+
+    for (size_t i = 0; i < elapsed_ns.size(); i++)
+    {
+        double average_ms = timed_frames[i] > 0 ? (elapsed_ns[i] / 1.0e6) / timed_frames[i] : 0.0;
+        printf("%-16s %8.3f ms/frame over %u frames (%dx%d, %u lights, %ux overdraw)\n", lighting_modes[i].name,
+               average_ms, static_cast<unsigned int>(timed_frames[i]), SAMPLE_WIDTH, SAMPLE_HEIGHT,
+               static_cast<unsigned int>(light_count), static_cast<unsigned int>(overdraw));
+    }
+
+    glDeleteQueriesEXT(1, &query);
+
+    fixie_terminate();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "fixie/fixie.h"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+#include "fixie/fixie_ext.h"
+
+#include "GLFW/glfw3.h"
+
+#include "sample_util/random.hpp"
+
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+
+// Particle benchmark comparing point sprites with a per vertex size array against quads expanded on the
+// CPU every frame. Frame times are measured on the CPU and include the glFinish so both the expansion
+// and the GPU work are counted.
+
+static const size_t particle_count = 1 << 20;
+static const size_t frames_per_mode = 100;
+static const size_t sprite_texture_size = 32;
+static const GLfloat max_particle_size = 4.0f;
+
+struct particle
+{
+    GLfloat position[3];
+    GLfloat velocity[3];
+    GLfloat size;
+};
+
+struct particle_mode
+{
+    const char* name;
+    void (*draw)(const std::vector<particle>& particles, int width, int height);
+};
+
+static std::vector<particle> create_particles()
+{
+    std::vector<particle> particles(particle_count);
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        particle& p = particles[i];
+        for (size_t j = 0; j < 3; j++)
+        {
+            p.position[j] = sample_util::random_between(-1.0f, 1.0f);
+            p.velocity[j] = sample_util::random_between(-0.005f, 0.005f);
+        }
+        p.size = sample_util::random_between(1.0f, max_particle_size);
+    }
+    return particles;
+}
+
+static void update_particles(std::vector<particle>& particles)
+{
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        particle& p = particles[i];
+        for (size_t j = 0; j < 3; j++)
+        {
+            p.position[j] += p.velocity[j];
+            if (p.position[j] < -1.0f || p.position[j] > 1.0f)
+            {
+                p.velocity[j] = -p.velocity[j];
+            }
+        }
+    }
+}
+
+static GLuint create_sprite_texture()
+{
+    std::vector<GLubyte> pixels(sprite_texture_size * sprite_texture_size);
+    for (size_t y = 0; y < sprite_texture_size; y++)
+    {
+        for (size_t x = 0; x < sprite_texture_size; x++)
+        {
+            GLfloat dx = (x + 0.5f) / sprite_texture_size - 0.5f;
+            GLfloat dy = (y + 0.5f) / sprite_texture_size - 0.5f;
+            GLfloat falloff = 1.0f - 4.0f * (dx * dx + dy * dy);
+            pixels[y * sprite_texture_size + x] = static_cast<GLubyte>((falloff > 0.0f ? falloff : 0.0f) * 255.0f);
+        }
+    }
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, sprite_texture_size, sprite_texture_size, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    return texture;
+}
+
+static void draw_point_sprites(const std::vector<particle>& particles, int width, int height)
+{
+    glEnable(GL_POINT_SPRITE_OES);
+    glTexEnvi(GL_POINT_SPRITE_OES, GL_COORD_REPLACE_OES, GL_TRUE);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(particle), particles[0].position);
+    glEnableClientState(GL_POINT_SIZE_ARRAY_OES);
+    glPointSizePointerOES(GL_FLOAT, sizeof(particle), &particles[0].size);
+
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(particles.size()));
+
+    glDisableClientState(GL_POINT_SIZE_ARRAY_OES);
+    glDisable(GL_POINT_SPRITE_OES);
+}
+
+static void draw_cpu_quads(const std::vector<particle>& particles, int width, int height)
+{
+    static const GLfloat corners[6][2] =
+    {
+        { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f },
+        { 0.0f, 1.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f },
+    };
+
+    static std::vector<GLfloat> positions;
+    static std::vector<GLfloat> texcoords;
+    positions.resize(particles.size() * 6 * 3);
+    texcoords.resize(particles.size() * 6 * 2);
+
+    // Convert the pixel sizes into clip space half extents, the projection is identity
+    GLfloat pixel_width = 2.0f / width;
+    GLfloat pixel_height = 2.0f / height;
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        const particle& p = particles[i];
+        GLfloat half_width = 0.5f * p.size * pixel_width;
+        GLfloat half_height = 0.5f * p.size * pixel_height;
+        for (size_t j = 0; j < 6; j++)
+        {
+            GLfloat* position = &positions[(i * 6 + j) * 3];
+            position[0] = p.position[0] + (corners[j][0] * 2.0f - 1.0f) * half_width;
+            position[1] = p.position[1] + (corners[j][1] * 2.0f - 1.0f) * half_height;
+            position[2] = p.position[2];
+
+            GLfloat* texcoord = &texcoords[(i * 6 + j) * 2];
+            texcoord[0] = corners[j][0];
+            texcoord[1] = corners[j][1];
+        }
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, positions.data());
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glTexCoordPointer(2, GL_FLOAT, 0, texcoords.data());
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(particles.size() * 6));
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+}
+
+static const particle_mode particle_modes[] =
+{
+    { "point_sprites", draw_point_sprites },
+    { "cpu_quads", draw_cpu_quads },
+};
+
+int main(int argc, char** argv)
+{
+    if (!glfwInit())
+    {
+        return -1;
+    }
+
+    GLFWwindow* window = glfwCreateWindow(SAMPLE_WIDTH, SAMPLE_HEIGHT, SAMPLE_NAME, NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    GLuint texture = create_sprite_texture();
+    glEnable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+    std::vector<particle> particles = create_particles();
+
+    std::vector<double> elapsed_ms(sizeof(particle_modes) / sizeof(particle_modes[0]), 0.0);
+    std::vector<size_t> timed_frames(elapsed_ms.size(), 0);
+
+    size_t frame = 0;
+    while (!glfwWindowShouldClose(window) && frame < frames_per_mode * elapsed_ms.size())
+    {
+        size_t mode = frame / frames_per_mode;
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        glViewport(0, 0, width, height);
+
+        update_particles(particles);
+
+        auto frame_start = std::chrono::steady_clock::now();
+        glClear(GL_COLOR_BUFFER_BIT);
+        particle_modes[mode].draw(particles, width, height);
+        glFinish();
+        auto frame_end = std::chrono::steady_clock::now();
+
+        // Skip the first frame of each mode, it includes shader compilation
+        if ((frame % frames_per_mode) != 0)
+        {
+            elapsed_ms[mode] += std::chrono::duration<double, std::milli>(frame_end - frame_start).count();
+            timed_frames[mode]++;
+        }
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        frame++;
+    }
+
+    for (size_t i = 0; i < elapsed_ms.size(); i++)
+    {
+        double average_ms = timed_frames[i] > 0 ? elapsed_ms[i] / timed_frames[i] : 0.0;
+        printf("%-16s %8.3f ms/frame over %u frames (%u particles)\n", particle_modes[i].name, average_ms,
+               static_cast<unsigned int>(timed_frames[i]), static_cast<unsigned int>(particle_count));
+    }
+
+    glDeleteTextures(1, &texture);
+
+    fixie_terminate();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
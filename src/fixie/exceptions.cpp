@@ -1,11 +1,16 @@
 #include "fixie/exceptions.hpp"
 #include "fixie_lib/context.hpp"
 #include "fixie_lib/debug.hpp"
+#include "fixie_lib/profiler.hpp"
 
 namespace fixie
 {
     void handle_entry_point_exception()
     {
+#if defined(FIXIE_PROFILING)
+        record_entry_point_error();
+#endif
+
         try
         {
             throw;
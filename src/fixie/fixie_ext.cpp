@@ -1,68 +1,1083 @@
 #include <stddef.h>
 #include <vector>
 #include <set>
+#include <string>
+#include <algorithm>
 
 #include "fixie/fixie.h"
 #include "fixie/fixie_ext.h"
 #include "fixie/fixie_gl_es.h"
 #include "fixie/fixie_gl_es_ext.h"
+#include "fixie/exceptions.hpp"
 
 #include "fixie_lib/debug.hpp"
 #include "fixie_lib/context.hpp"
 #include "fixie_lib/exceptions.hpp"
+#include "fixie_lib/util.hpp"
+#include "fixie_lib/enum_names.hpp"
+#include "fixie_lib/profiler.hpp"
+#include "fixie_lib/tracer.hpp"
+
+namespace fixie
+{
+    static bool is_valid_debug_source(GLenum source)
+    {
+        switch (source)
+        {
+        case GL_DEBUG_SOURCE_API_KHR:
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM_KHR:
+        case GL_DEBUG_SOURCE_SHADER_COMPILER_KHR:
+        case GL_DEBUG_SOURCE_THIRD_PARTY_KHR:
+        case GL_DEBUG_SOURCE_APPLICATION_KHR:
+        case GL_DEBUG_SOURCE_OTHER_KHR:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static bool is_valid_debug_type(GLenum type)
+    {
+        switch (type)
+        {
+        case GL_DEBUG_TYPE_ERROR_KHR:
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR_KHR:
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR_KHR:
+        case GL_DEBUG_TYPE_PORTABILITY_KHR:
+        case GL_DEBUG_TYPE_PERFORMANCE_KHR:
+        case GL_DEBUG_TYPE_OTHER_KHR:
+        case GL_DEBUG_TYPE_MARKER_KHR:
+        case GL_DEBUG_TYPE_PUSH_GROUP_KHR:
+        case GL_DEBUG_TYPE_POP_GROUP_KHR:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static bool is_valid_debug_severity(GLenum severity)
+    {
+        switch (severity)
+        {
+        case GL_DEBUG_SEVERITY_HIGH_KHR:
+        case GL_DEBUG_SEVERITY_MEDIUM_KHR:
+        case GL_DEBUG_SEVERITY_LOW_KHR:
+        case GL_DEBUG_SEVERITY_NOTIFICATION_KHR:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static void validate_application_source(GLenum source)
+    {
+        if (source != GL_DEBUG_SOURCE_APPLICATION_KHR && source != GL_DEBUG_SOURCE_THIRD_PARTY_KHR)
+        {
+            throw invalid_enum_error(format("invalid debug source, must be GL_DEBUG_SOURCE_APPLICATION_KHR or "
+                                            "GL_DEBUG_SOURCE_THIRD_PARTY_KHR, %s provided.", get_gl_enum_name(source).c_str()));
+        }
+    }
+
+    static std::string get_debug_string(GLsizei length, const GLchar* str, GLsizei max_length)
+    {
+        if (str == nullptr)
+        {
+            return std::string();
+        }
+
+        std::string result = (length < 0) ? std::string(str) : std::string(str, length);
+        if (result.length() >= static_cast<size_t>(max_length))
+        {
+            throw invalid_value_error(format("string length must be less than %i, %u provided.", max_length, result.length()));
+        }
+
+        return result;
+    }
+
+    static void copy_debug_string(const std::string& str, GLsizei buf_size, GLsizei* length, GLchar* output)
+    {
+        if (buf_size < 0)
+        {
+            throw invalid_value_error(format("buffer size cannot be negative, %i provided.", buf_size));
+        }
+
+        GLsizei written = 0;
+        if (output != nullptr && buf_size > 0)
+        {
+            written = std::min(static_cast<GLsizei>(str.length()), buf_size - 1);
+            std::copy(str.begin(), str.begin() + written, output);
+            output[written] = '\0';
+        }
+        else if (output == nullptr)
+        {
+            written = static_cast<GLsizei>(str.length());
+        }
+
+        if (length != nullptr)
+        {
+            *length = written;
+        }
+    }
+
+    static void validate_timer_queries_supported(std::shared_ptr<context> ctx)
+    {
+        if (!ctx->caps().supports_timer_queries())
+        {
+            throw invalid_operation_error("timer queries are not supported.");
+        }
+    }
+
+    static std::shared_ptr<query> get_query_object(std::shared_ptr<context> ctx, GLuint id)
+    {
+        std::shared_ptr<query> query_object = ctx->queries().get_object(id).lock();
+        if (query_object == nullptr || query_object->target() == 0)
+        {
+            throw invalid_operation_error(format("%u is not the name of a query object.", id));
+        }
+
+        return query_object;
+    }
+
+    template <typename output_type>
+    static void get_query_object_parameter(GLuint id, GLenum pname, output_type* params)
+    {
+        std::shared_ptr<context> ctx = get_current_context();
+        validate_timer_queries_supported(ctx);
+
+        std::shared_ptr<query> query_object = get_query_object(ctx, id);
+        if (query_object->active())
+        {
+            throw invalid_operation_error(format("query %u is currently active.", id));
+        }
+
+        switch (pname)
+        {
+        case GL_QUERY_RESULT_AVAILABLE_EXT:
+            params[0] = static_cast<output_type>(query_object->result_available());
+            break;
+
+        case GL_QUERY_RESULT_EXT:
+            if (query_object->result_available())
+            {
+                params[0] = static_cast<output_type>(query_object->result());
+            }
+            else
+            {
+                // Waiting would stall the pipeline, leave the output untouched and let the caller poll GL_QUERY_RESULT_AVAILABLE_EXT
+                if (is_message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 0, GL_DEBUG_SEVERITY_MEDIUM_KHR))
+                {
+                    log_message(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 0, GL_DEBUG_SEVERITY_MEDIUM_KHR,
+                                format("result of query %u requested before it was available.", id));
+                }
+            }
+            break;
+
+        default:
+            throw invalid_enum_error(format("invalid query object parameter, %s.", get_gl_enum_name(pname).c_str()));
+        }
+    }
+
+    static void validate_draw_mode(GLenum mode)
+    {
+        switch (mode)
+        {
+        case GL_POINTS:
+        case GL_LINE_STRIP:
+        case GL_LINE_LOOP:
+        case GL_LINES:
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+        case GL_TRIANGLES:
+            break;
+        default:
+            throw invalid_enum_error(format("invalid draw mode, %s", get_gl_enum_name(mode).c_str()));
+        }
+    }
+
+    static void validate_instance_count(GLsizei instance_count)
+    {
+        if (instance_count < 0)
+        {
+            throw invalid_value_error(format("instance count cannot be negative, %i provided.", instance_count));
+        }
+    }
+}
 
 extern "C"
 {
 
 void FIXIE_APIENTRY glDebugMessageControlKHR(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (source != GL_DONT_CARE && !fixie::is_valid_debug_source(source))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid debug source, %s.", fixie::get_gl_enum_name(source).c_str()));
+        }
+
+        if (type != GL_DONT_CARE && !fixie::is_valid_debug_type(type))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid debug type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (severity != GL_DONT_CARE && !fixie::is_valid_debug_severity(severity))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid debug severity, %s.", fixie::get_gl_enum_name(severity).c_str()));
+        }
+
+        if (count < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("id count cannot be negative, %i provided.", count));
+        }
+
+        if (count > 0)
+        {
+            if (source == GL_DONT_CARE || type == GL_DONT_CARE || severity != GL_DONT_CARE)
+            {
+                throw fixie::invalid_operation_error("controlling message ids requires a specific source and type and a severity of GL_DONT_CARE.");
+            }
+
+            fixie::for_each_n(0, count, [&](size_t i){ ctx->log().set_message_enabled(source, type, ids[i], enabled); });
+        }
+        else
+        {
+            ctx->log().set_messages_enabled(source, type, severity, enabled);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glDebugMessageInsertKHR(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        fixie::validate_application_source(source);
+
+        if (!fixie::is_valid_debug_type(type))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid debug type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (!fixie::is_valid_debug_severity(severity))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid debug severity, %s.", fixie::get_gl_enum_name(severity).c_str()));
+        }
+
+        if (ctx->log().message_enabled(source, type, id, severity))
+        {
+            fixie::log_message(source, type, id, severity, fixie::get_debug_string(length, buf, fixie::log::max_message_length));
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glDebugMessageCallbackKHR(GLDEBUGPROCKHR callback, const void *userParam)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        ctx->log().application_callback() = callback;
+        ctx->log().user_param() = const_cast<GLvoid*>(userParam);
+
+        if (callback != nullptr)
+        {
+            ctx->log().callback() = [callback](GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message,
+                                               const GLvoid* user_param)
+            {
+                callback(source, type, id, severity, length, message, const_cast<GLvoid*>(user_param));
+            };
+        }
+        else
+        {
+            ctx->log().callback() = nullptr;
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 GLuint FIXIE_APIENTRY glGetDebugMessageLogKHR(GLuint count, GLsizei bufsize, GLenum *sources, GLenum *types, GLuint *ids, GLenum *severities, GLsizei *lengths, GLchar *messageLog)
 {
-    UNIMPLEMENTED();
-    return 0;
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (bufsize < 0 && messageLog != nullptr)
+        {
+            throw fixie::invalid_value_error(fixie::format("buffer size cannot be negative, %i provided.", bufsize));
+        }
+
+        GLuint fetched = 0;
+        GLsizei written = 0;
+        while (fetched < count && ctx->log().message_count() > 0)
+        {
+            const fixie::debug_message& message = ctx->log().next_message();
+            GLsizei message_length = static_cast<GLsizei>(message.message().length() + 1);
+
+            if (messageLog != nullptr)
+            {
+                if (written + message_length > bufsize)
+                {
+                    break;
+                }
+
+                std::copy(message.message().begin(), message.message().end(), messageLog + written);
+                messageLog[written + message_length - 1] = '\0';
+                written += message_length;
+            }
+
+            if (sources != nullptr)
+            {
+                sources[fetched] = message.source();
+            }
+            if (types != nullptr)
+            {
+                types[fetched] = message.type();
+            }
+            if (ids != nullptr)
+            {
+                ids[fetched] = message.id();
+            }
+            if (severities != nullptr)
+            {
+                severities[fetched] = message.severity();
+            }
+            if (lengths != nullptr)
+            {
+                lengths[fetched] = message_length;
+            }
+
+            ctx->log().pop_message();
+            fetched++;
+        }
+
+        return fetched;
+    }
+    catch (...)
+    {
+        return fixie::handle_entry_point_exception(0);
+    }
 }
 
 void FIXIE_APIENTRY glPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar *message)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        fixie::validate_application_source(source);
+        ctx->push_debug_group(source, id, fixie::get_debug_string(length, message, fixie::log::max_message_length));
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glPopDebugGroupKHR(void)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        ctx->pop_debug_group();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glObjectLabelKHR(GLenum identifier, GLuint name, GLsizei length, const GLchar *label)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        ctx->set_object_label(identifier, name, fixie::get_debug_string(length, label, fixie::log::max_label_length));
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
-void FIXIE_APIENTRY glGetObjectLabeKHRl(GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label)
+void FIXIE_APIENTRY glGetObjectLabelKHR(GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::copy_debug_string(ctx->object_label(identifier, name), bufSize, length, label);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glObjectPtrLabelKHR(const void *ptr, GLsizei length, const GLchar *label)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        throw fixie::invalid_value_error("ptr is not a valid sync object.");
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glGetObjectPtrLabelKHR(const void *ptr, GLsizei bufSize, GLsizei *length, GLchar *label)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        throw fixie::invalid_value_error("ptr is not a valid sync object.");
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glGetPointervKHR(GLenum pname, void **params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    glGetPointerv(pname, params);
+}
+
+void FIXIE_APIENTRY glGenQueriesEXT(GLsizei n, GLuint *ids)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        if (n < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("invalid number of queries, at least 0 required, %i provided.", n));
+        }
+
+        std::fill(ids, ids + n, 0);
+
+        try
+        {
+            std::generate_n(ids, n, [&](){ return ctx->create_query(); });
+        }
+        catch (...)
+        {
+            try
+            {
+                std::for_each(ids, ids + n, [&](GLuint id){ ctx->queries().erase_object(id); });
+            }
+            catch (...)
+            {
+                // error while deleting a query, ignore it
+            }
+
+            throw;
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glDeleteQueriesEXT(GLsizei n, const GLuint *ids)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        if (n < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("invalid number of queries, at least 0 required, %i provided.", n));
+        }
+
+        for (GLsizei i = 0; i < n; i++)
+        {
+            std::shared_ptr<fixie::query> query_object = ctx->queries().get_object(ids[i]).lock();
+            if (query_object != nullptr && query_object->active())
+            {
+                query_object->end();
+                ctx->state().set_active_query(std::weak_ptr<fixie::query>());
+            }
+            ctx->queries().erase_object(ids[i]);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+GLboolean FIXIE_APIENTRY glIsQueryEXT(GLuint id)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        std::shared_ptr<const fixie::query> query_object = ctx->queries().get_object(id).lock();
+        return (query_object != nullptr && query_object->target() != 0) ? GL_TRUE : GL_FALSE;
+    }
+    catch (...)
+    {
+        return fixie::handle_entry_point_exception(GL_FALSE);
+    }
+}
+
+void FIXIE_APIENTRY glBeginQueryEXT(GLenum target, GLuint id)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        if (target != GL_TIME_ELAPSED_EXT)
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid query target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        if (ctx->state().active_query().lock() != nullptr)
+        {
+            throw fixie::invalid_operation_error("a query is already active.");
+        }
+
+        std::shared_ptr<fixie::query> query_object = ctx->queries().get_object(id).lock();
+        if (query_object == nullptr)
+        {
+            throw fixie::invalid_operation_error(fixie::format("%u is not a name returned by glGenQueriesEXT.", id));
+        }
+
+        if (query_object->target() != 0 && query_object->target() != target)
+        {
+            throw fixie::invalid_operation_error(fixie::format("query %u was previously used with target %s.", id,
+                                                               fixie::get_gl_enum_name(query_object->target()).c_str()));
+        }
+
+        query_object->begin(target);
+        ctx->state().set_active_query(query_object);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glEndQueryEXT(GLenum target)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        if (target != GL_TIME_ELAPSED_EXT)
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid query target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        std::shared_ptr<fixie::query> query_object = ctx->state().active_query().lock();
+        if (query_object == nullptr)
+        {
+            throw fixie::invalid_operation_error("no query is active.");
+        }
+
+        query_object->end();
+        ctx->state().set_active_query(std::weak_ptr<fixie::query>());
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glQueryCounterEXT(GLuint id, GLenum target)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        if (target != GL_TIMESTAMP_EXT)
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid query counter target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        std::shared_ptr<fixie::query> query_object = ctx->queries().get_object(id).lock();
+        if (query_object == nullptr)
+        {
+            throw fixie::invalid_operation_error(fixie::format("%u is not a name returned by glGenQueriesEXT.", id));
+        }
+
+        if (query_object->active())
+        {
+            throw fixie::invalid_operation_error(fixie::format("query %u is currently active.", id));
+        }
+
+        if (query_object->target() != 0 && query_object->target() != target)
+        {
+            throw fixie::invalid_operation_error(fixie::format("query %u was previously used with target %s.", id,
+                                                               fixie::get_gl_enum_name(query_object->target()).c_str()));
+        }
+
+        query_object->query_counter(target);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glGetQueryivEXT(GLenum target, GLenum pname, GLint *params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::validate_timer_queries_supported(ctx);
+
+        if (target != GL_TIME_ELAPSED_EXT && target != GL_TIMESTAMP_EXT)
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid query target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        switch (pname)
+        {
+        case GL_CURRENT_QUERY_EXT:
+            {
+                std::shared_ptr<const fixie::query> active_query = ctx->state().active_query().lock();
+                params[0] = (target == GL_TIME_ELAPSED_EXT && active_query != nullptr) ? static_cast<GLint>(ctx->queries().get_handle(active_query)) : 0;
+            }
+            break;
+
+        case GL_QUERY_COUNTER_BITS_EXT:
+            params[0] = ctx->caps().query_counter_bits();
+            break;
+
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid query parameter, %s.", fixie::get_gl_enum_name(pname).c_str()));
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glGetQueryObjectivEXT(GLuint id, GLenum pname, GLint *params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        fixie::get_query_object_parameter(id, pname, params);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glGetQueryObjectuivEXT(GLuint id, GLenum pname, GLuint *params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        fixie::get_query_object_parameter(id, pname, params);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glGetQueryObjecti64vEXT(GLuint id, GLenum pname, GLint64 *params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        fixie::get_query_object_parameter(id, pname, params);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glGetQueryObjectui64vEXT(GLuint id, GLenum pname, GLuint64 *params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        fixie::get_query_object_parameter(id, pname, params);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+GLuint FIXIE_APIENTRY fixie_get_entry_point_counters(GLuint count, fixie_entry_point_counters *counters)
+{
+#if defined(FIXIE_PROFILING)
+    std::vector<fixie::entry_point_counters> entry_points = fixie::get_entry_point_counters();
+    entry_points.erase(std::remove_if(begin(entry_points), end(entry_points), [](const fixie::entry_point_counters& entry_point){ return entry_point.calls == 0; }),
+                       end(entry_points));
+
+    if (counters == nullptr)
+    {
+        return static_cast<GLuint>(entry_points.size());
+    }
+
+    GLuint written = std::min(count, static_cast<GLuint>(entry_points.size()));
+    for (GLuint i = 0; i < written; i++)
+    {
+        counters[i].name = fixie::make_static(entry_points[i].name);
+        counters[i].calls = entry_points[i].calls;
+        counters[i].total_ns = entry_points[i].total_ns;
+        counters[i].max_ns = entry_points[i].max_ns;
+        counters[i].errors = entry_points[i].errors;
+    }
+    return written;
+#else
+    return 0;
+#endif
+}
+
+void FIXIE_APIENTRY fixie_reset_entry_point_counters(void)
+{
+#if defined(FIXIE_PROFILING)
+    fixie::reset_entry_point_counters();
+#endif
+}
+
+void FIXIE_APIENTRY fixie_get_statistics(fixie_statistics *statistics, GLboolean reset)
+{
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        fixie::statistics& context_statistics = ctx->impl()->statistics();
+
+        if (statistics != nullptr)
+        {
+            statistics->draw_calls = context_statistics.draw_calls();
+            statistics->state_changes = context_statistics.state_changes();
+            statistics->redundant_state_changes = context_statistics.redundant_state_changes();
+            statistics->uniform_uploads = context_statistics.uniform_uploads();
+            statistics->shader_cache_hits = context_statistics.shader_cache_hits();
+            statistics->shader_cache_misses = context_statistics.shader_cache_misses();
+            statistics->shader_compile_ns = context_statistics.shader_compile_time();
+            statistics->buffer_upload_bytes = context_statistics.buffer_upload_bytes();
+            statistics->texture_upload_bytes = context_statistics.texture_upload_bytes();
+        }
+
+        if (reset)
+        {
+            context_statistics = fixie::statistics();
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY fixie_set_tracing_enabled(GLboolean enabled)
+{
+    fixie::set_tracing_enabled(enabled != GL_FALSE);
+}
+
+GLboolean FIXIE_APIENTRY fixie_dump_trace(const GLchar *path)
+{
+    try
+    {
+        const std::string trace_path = (path != nullptr) ? path : fixie::default_trace_path();
+        if (trace_path.empty())
+        {
+            throw fixie::invalid_value_error("no trace path was provided and FIXIE_TRACE is not set.");
+        }
+
+        return fixie::dump_trace(trace_path) ? GL_TRUE : GL_FALSE;
+    }
+    catch (...)
+    {
+        return fixie::handle_entry_point_exception(GL_FALSE);
+    }
+}
+
+void FIXIE_APIENTRY fixie_clear_trace(void)
+{
+    fixie::clear_trace();
+}
+
+void FIXIE_APIENTRY fixie_instance_model_view_pointer(GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        switch (type)
+        {
+        case GL_FIXED:
+        case GL_FLOAT:
+            break;
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid instance model view pointer type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (stride < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("instance model view stride cannot be negative, %i provided.", stride));
+        }
+
+        std::shared_ptr<fixie::vertex_array> vertex_array = ctx->state().bound_vertex_array().lock();
+        if (vertex_array == nullptr)
+        {
+            throw fixie::state_error("null vertex array bound.");
+        }
+
+        fixie::vertex_attribute& attribute = vertex_array->instance_model_view_attribute();
+        attribute.type() = type;
+        attribute.stride() = stride;
+        attribute.pointer() = pointer;
+        attribute.buffer() = ctx->state().bound_array_buffer();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY fixie_instance_color_pointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (size != 4)
+        {
+            throw fixie::invalid_value_error(fixie::format("instance color size must be 4, %i provided.", size));
+        }
+
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE:
+        case GL_FIXED:
+        case GL_FLOAT:
+            break;
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid instance color pointer type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (stride < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("instance color stride cannot be negative, %i provided.", stride));
+        }
+
+        std::shared_ptr<fixie::vertex_array> vertex_array = ctx->state().bound_vertex_array().lock();
+        if (vertex_array == nullptr)
+        {
+            throw fixie::state_error("null vertex array bound.");
+        }
+
+        fixie::vertex_attribute& attribute = vertex_array->instance_color_attribute();
+        attribute.size() = size;
+        attribute.type() = type;
+        attribute.stride() = stride;
+        attribute.pointer() = pointer;
+        attribute.buffer() = ctx->state().bound_array_buffer();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY fixie_draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        fixie::validate_draw_mode(mode);
+
+        if (first < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("first cannot be negative (undefined behaviour), %i provided.", first));
+        }
+
+        if (count < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("draw count cannot be negative, %i provided.", count));
+        }
+
+        fixie::validate_instance_count(instance_count);
+
+        ctx->draw_arrays_instanced(mode, first, count, instance_count);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY fixie_draw_elements_instanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLsizei instance_count)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        fixie::validate_draw_mode(mode);
+
+        if (count < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("draw count cannot be negative, %i provided.", count));
+        }
+
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE:
+        case GL_UNSIGNED_SHORT:
+            break;
+        default:
+            throw fixie::invalid_enum_error("unknown index type.");
+        }
+
+        fixie::validate_instance_count(instance_count);
+
+        ctx->draw_elements_instanced(mode, count, type, indices, instance_count);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+GLuint FIXIE_APIENTRY fixie_read_pixels_async(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        std::shared_ptr<fixie::framebuffer> framebuffer = ctx->state().bound_framebuffer().lock();
+        if (framebuffer == nullptr)
+        {
+            throw fixie::state_error("null framebuffer bound.");
+        }
+
+        if (width < 0 || height < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("read pixels width and height must be at least 0, %i and %i provided.",
+                                                           width, height));
+        }
+
+        if (format != GL_RGBA && format != framebuffer->preferred_read_format())
+        {
+            throw fixie::invalid_operation_error(fixie::format("read pixels format must be GL_RGBA or IMPLEMENTATION_COLOR_READ_FORMAT, "
+                                                               "%s provided.", fixie::get_gl_enum_name(format).c_str()));
+        }
+
+        if (type != GL_UNSIGNED_BYTE && type != framebuffer->preferred_read_type())
+        {
+            throw fixie::invalid_operation_error(fixie::format("read pixels type must be GL_UNSIGNED_BYTE or IMPLEMENTATION_COLOR_READ_TYPE, "
+                                                               "%s provided.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        return ctx->begin_read_pixels(x, y, width, height, format, type);
+    }
+    catch (...)
+    {
+        return fixie::handle_entry_point_exception(0);
+    }
+}
+
+GLboolean FIXIE_APIENTRY fixie_poll_read_pixels(GLuint request, GLvoid *pixels)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (pixels == nullptr)
+        {
+            throw fixie::invalid_value_error("read pixels destination cannot be null.");
+        }
+
+        return ctx->end_read_pixels(request, GL_FALSE, pixels);
+    }
+    catch (...)
+    {
+        return fixie::handle_entry_point_exception(GL_FALSE);
+    }
+}
+
+void FIXIE_APIENTRY fixie_wait_read_pixels(GLuint request, GLvoid *pixels)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (pixels == nullptr)
+        {
+            throw fixie::invalid_value_error("read pixels destination cannot be null.");
+        }
+
+        ctx->end_read_pixels(request, GL_TRUE, pixels);
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY fixie_end_frame(void)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context_without_submit();
+        ctx->end_frame();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 }
@@ -1,4 +1,5 @@
 #include <stddef.h>
+#include <math.h>
 #include <vector>
 #include <set>
 #include <limits>
@@ -12,11 +13,13 @@
 
 #include "fixie_lib/debug.hpp"
 #include "fixie_lib/context.hpp"
+#include "fixie_lib/profiler.hpp"
 #include "fixie_lib/fixed_point.hpp"
 #include "fixie_lib/exceptions.hpp"
 #include "fixie_lib/util.hpp"
 #include "fixie_lib/math_util.hpp"
 #include "fixie_lib/enum_names.hpp"
+#include "fixie_lib/compressed_texture.hpp"
 
 namespace fixie
 {
@@ -158,7 +161,16 @@ namespace fixie
                 {
                     throw invalid_enum_error("multi-valued parameter name, GL_POSITION, passed to non-vector light function.");
                 }
-                light.position() = vector4(params.as_float(0), params.as_float(1), params.as_float(2), params.as_float(3));
+                light.position() = ctx->state().model_view_matrix_stack().top_multiplied() * vector4(params.as_float(0), params.as_float(1), params.as_float(2), params.as_float(3));
+                if (light.position().w() == 0.0f)
+                {
+                    vector3 light_direction = vector3::normalize(vector3(light.position().x(), light.position().y(), light.position().z()));
+                    light.half_vector() = vector3::normalize(vector3(light_direction.x(), light_direction.y(), light_direction.z() + 1.0f));
+                }
+                else
+                {
+                    light.half_vector() = vector3(0.0f, 0.0f, 1.0f);
+                }
                 break;
 
             case GL_SPOT_DIRECTION:
@@ -166,7 +178,10 @@ namespace fixie
                 {
                     throw invalid_enum_error("multi-valued parameter name, GL_SPOT_DIRECTION, passed to non-vector light function.");
                 }
-                light.spot_direction() = vector3(params.as_float(0), params.as_float(1), params.as_float(2));
+                {
+                    vector4 eye_direction = ctx->state().model_view_matrix_stack().top_multiplied() * vector4(params.as_float(0), params.as_float(1), params.as_float(2), 0.0f);
+                    light.spot_direction() = vector3(eye_direction.x(), eye_direction.y(), eye_direction.z());
+                }
                 break;
 
             case GL_SPOT_EXPONENT:
@@ -183,6 +198,7 @@ namespace fixie
                     throw invalid_value_error(format("spot light cutoff angle must be in the range [0, 90.0] or 180.0, %g provided.", params.as_float(0)));
                 }
                 light.spot_cutoff() = params.as_float(0);
+                light.spot_cutoff_cosine() = cosf(params.as_float(0) * 0.0174532925f);
                 break;
 
             case GL_CONSTANT_ATTENUATION:
@@ -249,15 +265,39 @@ namespace fixie
         }
     }
 
+    static bool is_texture_env_source(const caps& caps, GLint source)
+    {
+        switch (source)
+        {
+        case GL_TEXTURE:
+        case GL_CONSTANT:
+        case GL_PRIMARY_COLOR:
+        case GL_PREVIOUS:
+            return true;
+
+        default:
+            // OES_texture_env_crossbar allows sourcing the texture of any unit
+            return source >= GL_TEXTURE0 && source < static_cast<GLint>(GL_TEXTURE0 + caps.max_texture_units());
+        }
+    }
+
+    static void set_texture_env_int_parameters(GLenum target, GLenum pname, const GLint* params, bool vector_call);
+
     static void set_texture_env_real_parameters(GLenum target, GLenum pname, const const_real_ptr& params, bool vector_call)
     {
         try
         {
             std::shared_ptr<context> ctx = get_current_context();
 
-            if (target != GL_TEXTURE_ENV)
+            if (target != GL_TEXTURE_ENV && target != GL_POINT_SPRITE_OES)
+            {
+                throw invalid_enum_error("texture environment target must be GL_TEXTURE_ENV or GL_POINT_SPRITE_OES.");
+            }
+
+            if ((target == GL_POINT_SPRITE_OES) != (pname == GL_COORD_REPLACE_OES))
             {
-                throw invalid_enum_error("texture environment target must be GL_TEXTURE_ENV.");
+                throw invalid_enum_error(format("invalid parameter name for texture environment target %s, %s.", get_gl_enum_name(target).c_str(),
+                                                get_gl_enum_name(pname).c_str()));
             }
 
             texture_environment& environment = ctx->state().texture_environment(ctx->state().active_texture_unit());
@@ -290,7 +330,12 @@ namespace fixie
                 break;
 
             default:
-                throw invalid_enum_error(format("invalid texture environment parameter name, %s.", get_gl_enum_name(pname).c_str()));
+                {
+                    // Remaining parameters are all enums, share the validation of the integer entry points
+                    GLint int_param = static_cast<GLint>(params.as_enum(0));
+                    set_texture_env_int_parameters(target, pname, &int_param, false);
+                }
+                break;
             }
 
         }
@@ -306,15 +351,25 @@ namespace fixie
         {
             std::shared_ptr<context> ctx = get_current_context();
 
-            if (target != GL_TEXTURE_ENV)
+            if (target != GL_TEXTURE_ENV && target != GL_POINT_SPRITE_OES)
+            {
+                throw invalid_enum_error("texture environment target must be GL_TEXTURE_ENV or GL_POINT_SPRITE_OES.");
+            }
+
+            if ((target == GL_POINT_SPRITE_OES) != (pname == GL_COORD_REPLACE_OES))
             {
-                throw invalid_enum_error("texture environment target must be GL_TEXTURE_ENV.");
+                throw invalid_enum_error(format("invalid parameter name for texture environment target %s, %s.", get_gl_enum_name(target).c_str(),
+                                                get_gl_enum_name(pname).c_str()));
             }
 
             texture_environment& environment = ctx->state().texture_environment(ctx->state().active_texture_unit());
 
             switch (pname)
             {
+            case GL_COORD_REPLACE_OES:
+                environment.coord_replace() = (params[0] != 0) ? GL_TRUE : GL_FALSE;
+                break;
+
             case GL_TEXTURE_ENV_MODE:
                 switch (params[0])
                 {
@@ -378,84 +433,48 @@ namespace fixie
                 break;
 
             case GL_SRC0_RGB:
-                switch (params[0])
+                if (!is_texture_env_source(ctx->caps(), params[0]))
                 {
-                case GL_TEXTURE:
-                case GL_CONSTANT:
-                case GL_PRIMARY_COLOR:
-                case GL_PREVIOUS:
-                    break;
-                default:
                     throw invalid_value_error(format("invalid texture environment source 0 rgb function, %s.", get_gl_enum_name(params[0]).c_str()));
                 }
                 environment.source0_rgb() = params[0];
                 break;
 
             case GL_SRC1_RGB:
-                switch (params[0])
+                if (!is_texture_env_source(ctx->caps(), params[0]))
                 {
-                case GL_TEXTURE:
-                case GL_CONSTANT:
-                case GL_PRIMARY_COLOR:
-                case GL_PREVIOUS:
-                    break;
-                default:
                     throw invalid_value_error(format("invalid texture environment source 1 rgb function, %s.", get_gl_enum_name(params[0]).c_str()));
                 }
                 environment.source1_rgb() = params[0];
                 break;
 
             case GL_SRC2_RGB:
-                switch (params[0])
+                if (!is_texture_env_source(ctx->caps(), params[0]))
                 {
-                case GL_TEXTURE:
-                case GL_CONSTANT:
-                case GL_PRIMARY_COLOR:
-                case GL_PREVIOUS:
-                    break;
-                default:
                     throw invalid_value_error(format("invalid texture environment source 2 rgb function, %s.", get_gl_enum_name(params[0]).c_str()));
                 }
                 environment.source2_rgb() = params[0];
                 break;
 
             case GL_SRC0_ALPHA:
-                switch (params[0])
+                if (!is_texture_env_source(ctx->caps(), params[0]))
                 {
-                case GL_TEXTURE:
-                case GL_CONSTANT:
-                case GL_PRIMARY_COLOR:
-                case GL_PREVIOUS:
-                    break;
-                default:
                     throw invalid_value_error(format("invalid texture environment source 0 alpha function, %s.", get_gl_enum_name(params[0]).c_str()));
                 }
                 environment.source0_alpha() = params[0];
                 break;
 
             case GL_SRC1_ALPHA:
-                switch (params[0])
+                if (!is_texture_env_source(ctx->caps(), params[0]))
                 {
-                case GL_TEXTURE:
-                case GL_CONSTANT:
-                case GL_PRIMARY_COLOR:
-                case GL_PREVIOUS:
-                    break;
-                default:
                     throw invalid_value_error(format("invalid texture environment source 1 alpha function, %s.", get_gl_enum_name(params[0]).c_str()));
                 }
                 environment.source1_alpha() = params[0];
                 break;
 
             case GL_SRC2_ALPHA:
-                switch (params[0])
+                if (!is_texture_env_source(ctx->caps(), params[0]))
                 {
-                case GL_TEXTURE:
-                case GL_CONSTANT:
-                case GL_PRIMARY_COLOR:
-                case GL_PREVIOUS:
-                    break;
-                default:
                     throw invalid_value_error(format("invalid texture environment source 2 alpha function, %s.", get_gl_enum_name(params[0]).c_str()));
                 }
                 environment.source2_alpha() = params[0];
@@ -655,6 +674,19 @@ namespace fixie
                 }
                 break;
 
+            case GL_TEXTURE_CROP_RECT_OES:
+                if (!vector_call)
+                {
+                    throw invalid_enum_error("multi-valued texture parameter name, GL_TEXTURE_CROP_RECT_OES, passed to non-vector texture parameter function.");
+                }
+
+                if (texture)
+                {
+                    texture->crop_rect() = rectangle(static_cast<GLint>(params.as_float(0)), static_cast<GLint>(params.as_float(1)),
+                                                     static_cast<GLsizei>(params.as_float(2)), static_cast<GLsizei>(params.as_float(3)));
+                }
+                break;
+
             default:
                 throw invalid_enum_error(format("invalid texture parameter name, %s.", get_gl_enum_name(pname).c_str()));
             }
@@ -755,6 +787,18 @@ namespace fixie
                 }
                 break;
 
+            case GL_TEXTURE_CROP_RECT_OES:
+                if (!vector_call)
+                {
+                    throw invalid_enum_error("multi-valued texture parameter name, GL_TEXTURE_CROP_RECT_OES, passed to non-vector texture parameter function.");
+                }
+
+                if (texture)
+                {
+                    texture->crop_rect() = rectangle(params[0], params[1], params[2], params[3]);
+                }
+                break;
+
             default:
                 throw invalid_enum_error(format("invalid texture parameter name, %s.", get_gl_enum_name(pname).c_str()));
             }
@@ -915,12 +959,14 @@ namespace fixie
             std::shared_ptr<context> ctx = get_current_context();
 
             GLsizei max_clip_planes = ctx->caps().max_clip_planes();
-            if (p < GL_CLIP_PLANE0 || static_cast<GLsizei>(p - GL_CLIP_PLANE0) > max_clip_planes)
+            if (p < GL_CLIP_PLANE0 || static_cast<GLsizei>(p - GL_CLIP_PLANE0) >= max_clip_planes)
             {
                 throw invalid_enum_error(format("invalid clip plane, must be between GL_CLIP_PLANE0 and GL_CLIP_PLANE%i, %s provided.", max_clip_planes - 1, get_gl_enum_name(p).c_str()));
             }
 
-            ctx->state().clip_plane(p - GL_CLIP_PLANE0).equation() = vector4(params.as_float(0), params.as_float(1), params.as_float(2), params.as_float(3));
+            // Planes are stored in eye space, transformed by the inverse of the current model view matrix
+            vector4 equation(params.as_float(0), params.as_float(1), params.as_float(2), params.as_float(3));
+            ctx->state().clip_plane(p - GL_CLIP_PLANE0).equation() = ctx->state().model_view_matrix_stack().top_inverse_transpose() * equation;
         }
         catch (...)
         {
@@ -936,7 +982,7 @@ namespace fixie
             std::shared_ptr<context> ctx = get_current_context();
 
             GLsizei max_clip_planes = ctx->caps().max_clip_planes();
-            if (p < GL_CLIP_PLANE0 || static_cast<GLsizei>(p - GL_CLIP_PLANE0) > max_clip_planes)
+            if (p < GL_CLIP_PLANE0 || static_cast<GLsizei>(p - GL_CLIP_PLANE0) >= max_clip_planes)
             {
                 throw invalid_enum_error(format("invalid clip plane, must be between GL_CLIP_PLANE0 and GL_CLIP_PLANE%i, %s provided.", max_clip_planes - 1, get_gl_enum_name(p).c_str()));
             }
@@ -974,6 +1020,10 @@ namespace fixie
                 stack = &ctx->state().projection_matrix_stack();
                 break;
 
+            case GL_MATRIX_PALETTE_OES:
+                stack = &ctx->state().palette_matrix_stack(ctx->state().current_palette_matrix());
+                break;
+
             default:
                 UNREACHABLE();
                 throw state_error(format("invalid matrix mode, %s.", get_gl_enum_name(ctx->state().matrix_mode()).c_str()));
@@ -1044,10 +1094,18 @@ namespace fixie
             {
             case GL_TEXTURE_2D:   return ctx->state().texture_environment(ctx->state().active_texture_unit()).texture_enabled();
             case GL_SCISSOR_TEST: return ctx->state().scissor_state().scissor_test_enabled();
+            case GL_ALPHA_TEST:   return ctx->state().color_buffer_state().alpha_test_enabled();
             case GL_DEPTH_TEST:   return ctx->state().depth_buffer_state().depth_test_enabled();
             case GL_LIGHTING:     return ctx->state().lighting_state().lighting_enabled();
+            case GL_NORMALIZE:    return ctx->state().lighting_state().normalize_enabled();
+            case GL_RESCALE_NORMAL: return ctx->state().lighting_state().rescale_normal_enabled();
             case GL_FOG:          return ctx->state().fog_state().fog_enabled();
+            case GL_POINT_SMOOTH: return ctx->state().point_state().point_smooth_enabled();
+            case GL_POINT_SPRITE_OES: return ctx->state().point_state().point_sprite_enabled();
+            case GL_MATRIX_PALETTE_OES: return ctx->state().matrix_palette_enabled();
             case GL_CULL_FACE:    return ctx->state().polygon_state().cull_face_enabled();
+            case GL_DEBUG_OUTPUT_KHR:             return ctx->log().output_enabled();
+            case GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR: return ctx->log().output_synchronous();
             default: throw invalid_enum_error(format("invalid cap, %s.", get_gl_enum_name(target).c_str()));
             }
         }
@@ -1115,7 +1173,7 @@ namespace fixie
         case GL_MODELVIEW_MATRIX:
             if (output != nullptr)
             {
-                matrix4 matrix = ctx->state().model_view_matrix_stack().top_multiplied();
+                const matrix4& matrix = ctx->state().model_view_matrix_stack().top_multiplied();
                 std::copy_n(matrix.data(), 16, output);
             }
             return 16;
@@ -1123,7 +1181,7 @@ namespace fixie
         case GL_PROJECTION_MATRIX:
             if (output != nullptr)
             {
-                matrix4 matrix = ctx->state().projection_matrix_stack().top_multiplied();
+                const matrix4& matrix = ctx->state().projection_matrix_stack().top_multiplied();
                 std::copy_n(matrix.data(), 16, output);
             }
             return 16;
@@ -1131,7 +1189,7 @@ namespace fixie
         case GL_TEXTURE_MATRIX:
             if (output != nullptr)
             {
-                matrix4 matrix = ctx->state().texture_matrix_stack(ctx->state().active_client_texture()).top_multiplied();
+                const matrix4& matrix = ctx->state().texture_matrix_stack(ctx->state().active_client_texture()).top_multiplied();
                 std::copy_n(matrix.data(), 16, output);
             }
             return 16;
@@ -1252,6 +1310,105 @@ namespace fixie
             }
             return 1;
 
+        case GL_POINT_SIZE_ARRAY_TYPE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->point_size_attribute().type();
+            }
+            return 1;
+
+        case GL_POINT_SIZE_ARRAY_STRIDE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->point_size_attribute().stride();
+            }
+            return 1;
+
+        case GL_MATRIX_INDEX_ARRAY_SIZE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->matrix_index_attribute().size();
+            }
+            return 1;
+
+        case GL_MATRIX_INDEX_ARRAY_TYPE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->matrix_index_attribute().type();
+            }
+            return 1;
+
+        case GL_MATRIX_INDEX_ARRAY_STRIDE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->matrix_index_attribute().stride();
+            }
+            return 1;
+
+        case GL_WEIGHT_ARRAY_SIZE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->weight_attribute().size();
+            }
+            return 1;
+
+        case GL_WEIGHT_ARRAY_TYPE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->weight_attribute().type();
+            }
+            return 1;
+
+        case GL_WEIGHT_ARRAY_STRIDE_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = vao->weight_attribute().stride();
+            }
+            return 1;
+
+        case GL_NUM_COMPRESSED_TEXTURE_FORMATS:
+            if (output != nullptr)
+            {
+                output[0] = static_cast<GLint>(ctx->caps().compressed_format_count());
+            }
+            return 1;
+
+        case GL_COMPRESSED_TEXTURE_FORMATS:
+            if (output != nullptr)
+            {
+                for_each_n<size_t>(0U, ctx->caps().compressed_format_count(), [&](size_t i){ output[i] = ctx->caps().compressed_format(i); });
+            }
+            return std::max<size_t>(ctx->caps().compressed_format_count(), 1);
+
+        case GL_MAX_PALETTE_MATRICES_OES:
+            if (output != nullptr)
+            {
+                output[0] = ctx->caps().max_palette_matrices();
+            }
+            return 1;
+
+        case GL_MAX_VERTEX_UNITS_OES:
+            if (output != nullptr)
+            {
+                output[0] = ctx->caps().max_vertex_units();
+            }
+            return 1;
+
+        case GL_CURRENT_PALETTE_MATRIX_OES:
+            if (output != nullptr)
+            {
+                output[0] = static_cast<GLint>(ctx->state().current_palette_matrix());
+            }
+            return 1;
+
         case GL_ARRAY_BUFFER_BINDING:
             if (output != nullptr)
             {
@@ -1291,6 +1448,30 @@ namespace fixie
             }
             return 1;
 
+        case GL_POINT_SIZE_ARRAY_BUFFER_BINDING_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = ctx->buffers().get_handle(vao->point_size_attribute().buffer());
+            }
+            return 1;
+
+        case GL_MATRIX_INDEX_ARRAY_BUFFER_BINDING_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = ctx->buffers().get_handle(vao->matrix_index_attribute().buffer());
+            }
+            return 1;
+
+        case GL_WEIGHT_ARRAY_BUFFER_BINDING_OES:
+            if (output != nullptr)
+            {
+                std::shared_ptr<vertex_array> vao = ctx->state().bound_vertex_array().lock();
+                output[0] = ctx->buffers().get_handle(vao->weight_attribute().buffer());
+            }
+            return 1;
+
         case GL_ELEMENT_ARRAY_BUFFER_BINDING:
             if (output != nullptr)
             {
@@ -1301,7 +1482,7 @@ namespace fixie
         case GL_MODELVIEW_MATRIX_FLOAT_AS_INT_BITS_OES:
             if (output != nullptr)
             {
-                matrix4 matrix = ctx->state().model_view_matrix_stack().top_multiplied();
+                const matrix4& matrix = ctx->state().model_view_matrix_stack().top_multiplied();
                 for_each_n(0, 16, [&](size_t i){ output[i] = bit_cast<GLint>(matrix.data() + i); });
             }
             return 16;
@@ -1309,7 +1490,7 @@ namespace fixie
         case GL_PROJECTION_MATRIX_FLOAT_AS_INT_BITS_OES:
             if (output != nullptr)
             {
-                matrix4 matrix = ctx->state().projection_matrix_stack().top_multiplied();
+                const matrix4& matrix = ctx->state().projection_matrix_stack().top_multiplied();
                 for_each_n(0, 16, [&](size_t i){ output[i] = bit_cast<GLint>(matrix.data() + i); });
             }
             return 16;
@@ -1317,7 +1498,7 @@ namespace fixie
         case GL_TEXTURE_MATRIX_FLOAT_AS_INT_BITS_OES:
             if (output != nullptr)
             {
-                matrix4 matrix = ctx->state().texture_matrix_stack(ctx->state().active_client_texture()).top_multiplied();
+                const matrix4& matrix = ctx->state().texture_matrix_stack(ctx->state().active_client_texture()).top_multiplied();
                 for_each_n(0, 16, [&](size_t i){ output[i] = bit_cast<GLint>(matrix.data() + i); });
             }
             return 16;
@@ -1398,11 +1579,113 @@ namespace fixie
             }
             return 1;
 
+        case GL_MAX_SAMPLES_EXT:
+            if (ctx->caps().max_samples() == 0)
+            {
+                throw invalid_enum_error("multisampled render to texture is not supported.");
+            }
+            if (output != nullptr)
+            {
+                output[0] = ctx->caps().max_samples();
+            }
+            return 1;
+
+        case GL_MAX_DEBUG_MESSAGE_LENGTH_KHR:
+            if (output != nullptr)
+            {
+                output[0] = log::max_message_length;
+            }
+            return 1;
+
+        case GL_MAX_DEBUG_LOGGED_MESSAGES_KHR:
+            if (output != nullptr)
+            {
+                output[0] = log::max_logged_messages;
+            }
+            return 1;
+
+        case GL_DEBUG_LOGGED_MESSAGES_KHR:
+            if (output != nullptr)
+            {
+                output[0] = static_cast<GLint>(ctx->log().message_count());
+            }
+            return 1;
+
+        case GL_DEBUG_NEXT_LOGGED_MESSAGE_LENGTH_KHR:
+            if (output != nullptr)
+            {
+                output[0] = (ctx->log().message_count() > 0) ? static_cast<GLint>(ctx->log().next_message().message().length() + 1) : 0;
+            }
+            return 1;
+
+        case GL_MAX_DEBUG_GROUP_STACK_DEPTH_KHR:
+            if (output != nullptr)
+            {
+                output[0] = log::max_group_depth;
+            }
+            return 1;
+
+        case GL_DEBUG_GROUP_STACK_DEPTH_KHR:
+            if (output != nullptr)
+            {
+                output[0] = static_cast<GLint>(ctx->log().group_depth());
+            }
+            return 1;
+
+        case GL_MAX_LABEL_LENGTH_KHR:
+            if (output != nullptr)
+            {
+                output[0] = log::max_label_length;
+            }
+            return 1;
+
+        case GL_GPU_DISJOINT_EXT:
+            if (!ctx->caps().supports_timer_queries())
+            {
+                return 0;
+            }
+            if (output != nullptr)
+            {
+                output[0] = GL_FALSE;
+            }
+            return 1;
+
         default:
             return 0;
         }
     }
 
+    template <>
+    size_t get_parameter_specialized(std::shared_ptr<context> ctx, GLenum pname, GLint64* output)
+    {
+        switch (pname)
+        {
+        case GL_TIMESTAMP_EXT:
+            if (!ctx->caps().supports_timer_queries())
+            {
+                return 0;
+            }
+            if (output != nullptr)
+            {
+                output[0] = static_cast<GLint64>(ctx->impl()->timestamp());
+            }
+            return 1;
+
+        default:
+            {
+                // Everything else is an integer query widened to 64 bits
+                size_t count = get_parameter_specialized(ctx, pname, static_cast<GLint*>(nullptr));
+                if (output != nullptr && count > 0)
+                {
+                    std::vector<GLint> values(count);
+                    get_parameter_specialized(ctx, pname, values.data());
+                    std::copy(begin(values), end(values), output);
+                }
+                return count;
+            }
+        }
+    }
+
     template <typename output_type>
     size_t get_parameter(GLenum pname, output_type output)
     {
@@ -1464,6 +1747,41 @@ namespace fixie
                 }
                 return 1;
 
+            case GL_POINT_SIZE_ARRAY_POINTER_OES:
+                if (output != nullptr)
+                {
+                    output[0] = const_cast<GLvoid*>(vertex_array->point_size_attribute().pointer());
+                }
+                return 1;
+
+            case GL_MATRIX_INDEX_ARRAY_POINTER_OES:
+                if (output != nullptr)
+                {
+                    output[0] = const_cast<GLvoid*>(vertex_array->matrix_index_attribute().pointer());
+                }
+                return 1;
+
+            case GL_WEIGHT_ARRAY_POINTER_OES:
+                if (output != nullptr)
+                {
+                    output[0] = const_cast<GLvoid*>(vertex_array->weight_attribute().pointer());
+                }
+                return 1;
+
+            case GL_DEBUG_CALLBACK_FUNCTION_KHR:
+                if (output != nullptr)
+                {
+                    output[0] = reinterpret_cast<GLvoid*>(ctx->log().application_callback());
+                }
+                return 1;
+
+            case GL_DEBUG_CALLBACK_USER_PARAM_KHR:
+                if (output != nullptr)
+                {
+                    output[0] = const_cast<GLvoid*>(ctx->log().user_param());
+                }
+                return 1;
+
             default:
                 throw invalid_enum_error(format("invalid pointer parameter name, %s.", get_gl_enum_name(pname).c_str()));
             }
@@ -1613,6 +1931,11 @@ namespace fixie
             case GL_NORMAL_ARRAY:        attribute = &vertex_array->normal_attribute();                                       break;
             case GL_COLOR_ARRAY:         attribute = &vertex_array->color_attribute();                                        break;
             case GL_TEXTURE_COORD_ARRAY: attribute = &vertex_array->texcoord_attribute(ctx->state().active_client_texture()); break;
+            case GL_POINT_SIZE_ARRAY_OES: attribute = &vertex_array->point_size_attribute();                                 break;
+            case GL_MATRIX_INDEX_ARRAY_OES: attribute = &vertex_array->matrix_index_attribute();                             break;
+            case GL_WEIGHT_ARRAY_OES:    attribute = &vertex_array->weight_attribute();                                       break;
+            case GL_INSTANCE_MODEL_VIEW_ARRAY_FIXIE: attribute = &vertex_array->instance_model_view_attribute();           break;
+            case GL_INSTANCE_COLOR_ARRAY_FIXIE: attribute = &vertex_array->instance_color_attribute();                     break;
             default: throw invalid_enum_error(format("invalid client state, %s.", get_gl_enum_name(array).c_str()));
             }
 
@@ -1646,7 +1969,7 @@ namespace fixie
             }
 
             ctx->state().color_buffer_state().alpha_test_func() = func;
-            ctx->state().color_buffer_state().alpha_test_ref() = ref.as_float();
+            ctx->state().color_buffer_state().alpha_test_ref() = clamp(ref.as_float(), 0.0f, 1.0f);
         }
         catch (...)
         {
@@ -1660,11 +1983,13 @@ extern "C"
 
 void FIXIE_APIENTRY glAlphaFunc(GLenum func, GLclampf ref)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_alpha_func(func, ref);
 }
 
 void FIXIE_APIENTRY glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1678,6 +2003,7 @@ void FIXIE_APIENTRY glClearColor(GLclampf red, GLclampf green, GLclampf blue, GL
 
 void FIXIE_APIENTRY glClearDepthf(GLclampf depth)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1691,11 +2017,13 @@ void FIXIE_APIENTRY glClearDepthf(GLclampf depth)
 
 void FIXIE_APIENTRY glClipPlanef(GLenum plane, const GLfloat *equation)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_clip_plane(plane, equation);
 }
 
 void FIXIE_APIENTRY glColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1717,6 +2045,7 @@ void FIXIE_APIENTRY glColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat
 
 void FIXIE_APIENTRY glDepthRangef(GLclampf zNear, GLclampf zFar)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1730,16 +2059,19 @@ void FIXIE_APIENTRY glDepthRangef(GLclampf zNear, GLclampf zFar)
 
 void FIXIE_APIENTRY glFogf(GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_fog_parameters(pname, &param, false);
 }
 
 void FIXIE_APIENTRY glFogfv(GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_fog_parameters(pname, params, true);
 }
 
 void FIXIE_APIENTRY glFrustumf(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         if (zNear <= 0.0f || zFar < 0.0f)
@@ -1772,81 +2104,97 @@ void FIXIE_APIENTRY glFrustumf(GLfloat left, GLfloat right, GLfloat bottom, GLfl
 
 void FIXIE_APIENTRY glGetClipPlanef(GLenum pname, GLfloat eqn[4])
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_clip_plane(pname, eqn);
 }
 
 void FIXIE_APIENTRY glGetFloatv(GLenum pname, GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_parameter(pname, params);
 }
 
 void FIXIE_APIENTRY glGetLightfv(GLenum light, GLenum pname, GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_light_parameter(light, pname, params);
 }
 
 void FIXIE_APIENTRY glGetMaterialfv(GLenum face, GLenum pname, GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_material_parameter(face, pname, params);
 }
 
 void FIXIE_APIENTRY glGetTexEnvfv(GLenum env, GLenum pname, GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_texture_evironment_parameter(env, pname, params);
 }
 
 void FIXIE_APIENTRY glGetTexParameterfv(GLenum target, GLenum pname, GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_texture_parameter(target, pname, params);
 }
 
 void FIXIE_APIENTRY glLightModelf(GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_model_parameters(pname, &param, false);
 }
 
 void FIXIE_APIENTRY glLightModelfv(GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_model_parameters(pname, params, true);
 }
 
 void FIXIE_APIENTRY glLightf(GLenum light, GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_parameters(light, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glLightfv(GLenum light, GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_parameters(light, pname, params, true);
 }
 
 void FIXIE_APIENTRY glLineWidth(GLfloat width)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_line_width(width);
 }
 
 void FIXIE_APIENTRY glLoadMatrixf(const GLfloat *m)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(m, false);
 }
 
 void FIXIE_APIENTRY glMaterialf(GLenum face, GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_material_parameters(face, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glMaterialfv(GLenum face, GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_material_parameters(face, pname, params, true);
 }
 
 void FIXIE_APIENTRY glMultMatrixf(const GLfloat *m)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(m, true);
 }
 
 void FIXIE_APIENTRY glMultiTexCoord4f(GLenum target, GLfloat s, GLfloat t, GLfloat r, GLfloat q)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1875,6 +2223,7 @@ void FIXIE_APIENTRY glMultiTexCoord4f(GLenum target, GLfloat s, GLfloat t, GLflo
 
 void FIXIE_APIENTRY glNormal3f(GLfloat nx, GLfloat ny, GLfloat nz)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1896,6 +2245,7 @@ void FIXIE_APIENTRY glNormal3f(GLfloat nx, GLfloat ny, GLfloat nz)
 
 void FIXIE_APIENTRY glOrthof(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         if (left == right)
@@ -1923,61 +2273,73 @@ void FIXIE_APIENTRY glOrthof(GLfloat left, GLfloat right, GLfloat bottom, GLfloa
 
 void FIXIE_APIENTRY glPointParameterf(GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_point_parameters(pname, &param, false);
 }
 
 void FIXIE_APIENTRY glPointParameterfv(GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_point_parameters(pname, params, true);
 }
 
 void FIXIE_APIENTRY glPointSize(GLfloat size)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_point_size(size);
 }
 
 void FIXIE_APIENTRY glPolygonOffset(GLfloat factor, GLfloat units)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_polgyon_offset(factor, units);
 }
 
 void FIXIE_APIENTRY glRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::rotate(angle, fixie::vector3(x, y, z)), true);
 }
 
 void FIXIE_APIENTRY glScalef(GLfloat x, GLfloat y, GLfloat z)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::scale(fixie::vector3(x, y, z)), true);
 }
 
 void FIXIE_APIENTRY glTexEnvf(GLenum target, GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_env_real_parameters(target, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glTexEnvfv(GLenum target, GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_env_real_parameters(target, pname, params, true);
 }
 
 void FIXIE_APIENTRY glTexParameterf(GLenum target, GLenum pname, GLfloat param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_real_parameters(target, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glTexParameterfv(GLenum target, GLenum pname, const GLfloat *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_real_parameters(target, pname, params, true);
 }
 
 void FIXIE_APIENTRY glTranslatef(GLfloat x, GLfloat y, GLfloat z)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::translate(fixie::vector3(x, y, z)), true);
 }
 
 void FIXIE_APIENTRY glActiveTexture(GLenum texture)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -1999,11 +2361,13 @@ void FIXIE_APIENTRY glActiveTexture(GLenum texture)
 
 void FIXIE_APIENTRY glAlphaFuncx(GLenum func, GLclampx ref)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_alpha_func(func, ref);
 }
 
 void FIXIE_APIENTRY glBindBuffer(GLenum target, GLuint buffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2032,6 +2396,7 @@ void FIXIE_APIENTRY glBindBuffer(GLenum target, GLuint buffer)
 
 void FIXIE_APIENTRY glBindTexture(GLenum target, GLuint texture)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2056,6 +2421,7 @@ void FIXIE_APIENTRY glBindTexture(GLenum target, GLuint texture)
 
 void FIXIE_APIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2104,6 +2470,7 @@ void FIXIE_APIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor)
 
 void FIXIE_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const GLvoid *data, GLenum usage)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2152,6 +2519,7 @@ void FIXIE_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const GLvoid *d
 
 void FIXIE_APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2196,6 +2564,7 @@ void FIXIE_APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr s
 
 void FIXIE_APIENTRY glClear(GLbitfield mask)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2216,6 +2585,7 @@ void FIXIE_APIENTRY glClear(GLbitfield mask)
 
 void FIXIE_APIENTRY glClearColorx(GLclampx red, GLclampx green, GLclampx blue, GLclampx alpha)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2230,6 +2600,7 @@ void FIXIE_APIENTRY glClearColorx(GLclampx red, GLclampx green, GLclampx blue, G
 
 void FIXIE_APIENTRY glClearDepthx(GLclampx depth)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2243,6 +2614,7 @@ void FIXIE_APIENTRY glClearDepthx(GLclampx depth)
 
 void FIXIE_APIENTRY glClearStencil(GLint s)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2256,6 +2628,7 @@ void FIXIE_APIENTRY glClearStencil(GLint s)
 
 void FIXIE_APIENTRY glClientActiveTexture(GLenum texture)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2277,11 +2650,13 @@ void FIXIE_APIENTRY glClientActiveTexture(GLenum texture)
 
 void FIXIE_APIENTRY glClipPlanex(GLenum plane, const GLfixed *equation)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_clip_plane(plane, equation);
 }
 
 void FIXIE_APIENTRY glColor4ub(GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2305,6 +2680,7 @@ void FIXIE_APIENTRY glColor4ub(GLubyte red, GLubyte green, GLubyte blue, GLubyte
 
 void FIXIE_APIENTRY glColor4x(GLfixed red, GLfixed green, GLfixed blue, GLfixed alpha)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2326,6 +2702,7 @@ void FIXIE_APIENTRY glColor4x(GLfixed red, GLfixed green, GLfixed blue, GLfixed
 
 void FIXIE_APIENTRY glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2343,6 +2720,7 @@ void FIXIE_APIENTRY glColorMask(GLboolean red, GLboolean green, GLboolean blue,
 
 void FIXIE_APIENTRY glColorPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2391,26 +2769,271 @@ void FIXIE_APIENTRY glColorPointer(GLint size, GLenum type, GLsizei stride, cons
 
 void FIXIE_APIENTRY glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid *data)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        std::shared_ptr<fixie::texture> texture = nullptr;
+        switch (target)
+        {
+        case GL_TEXTURE_2D:
+            texture = ctx->state().bound_texture(ctx->state().active_texture_unit()).lock();
+            break;
+
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid texture target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        if (!ctx->caps().supports_compressed_format(internalformat))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid compressed internal format, %s.", fixie::get_gl_enum_name(internalformat).c_str()));
+        }
+
+        GLsizei max_texture_size = ctx->caps().max_texture_size();
+        GLsizei max_levels = fixie::log_two(max_texture_size);
+
+        // Paletted images carry every mip level, a level of -n holds levels 0 through n
+        GLboolean paletted = fixie::is_paletted_format(internalformat);
+        GLint base_level = paletted ? 0 : level;
+        if (paletted ? (level > 0 || -level >= max_levels) : (level < 0 || level >= max_levels))
+        {
+            throw fixie::invalid_value_error(fixie::format("invalid level for %s, %i provided.", fixie::get_gl_enum_name(internalformat).c_str(), level));
+        }
+
+        GLsizei max_level_size = (max_texture_size >> base_level);
+        if (width < 0 || width > max_level_size || height < 0 || height > max_level_size)
+        {
+            throw fixie::invalid_value_error(fixie::format("width and height must be between 0 and %i for level %i, %i and %i provided.",
+                                                           max_level_size, base_level, width, height));
+        }
+
+        if (border != 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("border must be zero, %i provided.", border));
+        }
+
+        GLsizei levels = paletted ? (1 - level) : 1;
+        GLsizei expected_image_size = fixie::compressed_image_size(internalformat, width, height, levels);
+        if (imageSize < 0 || (expected_image_size > 0 && imageSize != expected_image_size))
+        {
+            throw fixie::invalid_value_error(fixie::format("invalid image size for a %ix%i %s image, %i provided.", width, height,
+                                                           fixie::get_gl_enum_name(internalformat).c_str(), imageSize));
+        }
+
+        if (texture != nullptr)
+        {
+            texture->set_compressed_data(ctx->state().pixel_store_state(), level, internalformat, width, height, imageSize, data);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid *data)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        std::shared_ptr<fixie::texture> texture = nullptr;
+        switch (target)
+        {
+        case GL_TEXTURE_2D:
+            texture = ctx->state().bound_texture(ctx->state().active_texture_unit()).lock();
+            break;
+
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid texture target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        if (!ctx->caps().supports_compressed_format(format))
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid compressed format, %s.", fixie::get_gl_enum_name(format).c_str()));
+        }
+
+        // Neither OES_compressed_paletted_texture nor OES_compressed_ETC1_RGB8_texture allow sub image updates
+        if (fixie::is_paletted_format(format) || fixie::is_etc1_format(format))
+        {
+            throw fixie::invalid_operation_error(fixie::format("%s textures cannot be partially updated.", fixie::get_gl_enum_name(format).c_str()));
+        }
+
+        GLsizei max_texture_size = ctx->caps().max_texture_size();
+        GLsizei max_levels = fixie::log_two(max_texture_size);
+        if (level < 0 || level >= max_levels)
+        {
+            throw fixie::invalid_value_error(fixie::format("level must be between 0 and %i, %i provided.", max_levels, level));
+        }
+
+        if (xoffset < 0 || width < 0 || yoffset < 0 || height < 0 || imageSize < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("xoffset, yoffset, width, height and image size must be at least 0, %i, %i, %i, %i and %i provided.",
+                                                           xoffset, yoffset, width, height, imageSize));
+        }
+
+        if (texture != nullptr)
+        {
+            if (static_cast<size_t>(level) >= texture->mip_levels() || texture->mip_level_internal_format(level) != format)
+            {
+                throw fixie::invalid_operation_error("format must match the internal format of the texture level.");
+            }
+
+            texture->set_compressed_sub_data(ctx->state().pixel_store_state(), level, xoffset, yoffset, width, height, format, imageSize, data);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        std::shared_ptr<fixie::texture> texture = nullptr;
+        switch (target)
+        {
+        case GL_TEXTURE_2D:
+            texture = ctx->state().bound_texture(ctx->state().active_texture_unit()).lock();
+            break;
+
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid texture target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        switch (internalformat)
+        {
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+        case GL_LUMINANCE_ALPHA:
+        case GL_RGB:
+        case GL_RGBA:
+            break;
+
+        default:
+            throw fixie::invalid_value_error(fixie::format("invalid internal format, %s", fixie::get_gl_enum_name(internalformat).c_str()));
+        }
+
+        GLsizei max_texture_size = ctx->caps().max_texture_size();
+        GLsizei max_levels = fixie::log_two(max_texture_size);
+        if (level < 0 || level >= max_levels)
+        {
+            throw fixie::invalid_value_error(fixie::format("level must be between 0 and %i, %i provided.", max_levels, level));
+        }
+
+        GLsizei max_level_size = (max_texture_size >> level);
+        if (width < 0 || width > max_level_size || height < 0 || height > max_level_size)
+        {
+            throw fixie::invalid_value_error(fixie::format("width and height must be between 0 and %i for level %i, %i and %i provided.",
+                                                           max_level_size, level, width, height));
+        }
+
+        if (border != 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("border must be zero, %i provided.", border));
+        }
+
+        std::shared_ptr<const fixie::framebuffer> framebuffer = ctx->state().bound_framebuffer().lock();
+        if (framebuffer == nullptr)
+        {
+            throw fixie::state_error("null framebuffer bound.");
+        }
+
+        if (framebuffer->status() != GL_FRAMEBUFFER_COMPLETE_OES)
+        {
+            throw fixie::invalid_framebuffer_operation_error("the bound framebuffer is not complete.");
+        }
+
+        if (texture != nullptr)
+        {
+            texture->copy_data(level, internalformat, x, y, width, height, framebuffer);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    UNIMPLEMENTED();
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        std::shared_ptr<fixie::texture> texture = nullptr;
+        switch (target)
+        {
+        case GL_TEXTURE_2D:
+            texture = ctx->state().bound_texture(ctx->state().active_texture_unit()).lock();
+            break;
+
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid texture target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        GLsizei max_texture_size = ctx->caps().max_texture_size();
+        GLsizei max_levels = fixie::log_two(max_texture_size);
+        if (level < 0 || level >= max_levels)
+        {
+            throw fixie::invalid_value_error(fixie::format("level must be between 0 and %i, %i provided.", max_levels, level));
+        }
+
+        if (xoffset < 0 || width < 0 || yoffset < 0 || height < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("xoffset, yoffset, width, and height must be at least 0, %i, %i %i and %i provided.",
+                                                           xoffset, yoffset, width, height));
+        }
+
+        std::shared_ptr<const fixie::framebuffer> framebuffer = ctx->state().bound_framebuffer().lock();
+        if (framebuffer == nullptr)
+        {
+            throw fixie::state_error("null framebuffer bound.");
+        }
+
+        if (framebuffer->status() != GL_FRAMEBUFFER_COMPLETE_OES)
+        {
+            throw fixie::invalid_framebuffer_operation_error("the bound framebuffer is not complete.");
+        }
+
+        if (texture != nullptr)
+        {
+            if (static_cast<size_t>(level) >= texture->mip_levels())
+            {
+                throw fixie::invalid_operation_error(fixie::format("level %i of the texture has not been defined.", level));
+            }
+
+            if (xoffset + width > texture->mip_level_width(level) || yoffset + height > texture->mip_level_height(level))
+            {
+                throw fixie::invalid_value_error(fixie::format("xoffset + width and yoffset + height must be within the %ix%i texture level, %i and %i provided.",
+                                                               texture->mip_level_width(level), texture->mip_level_height(level), xoffset + width, yoffset + height));
+            }
+
+            if (texture->mip_level_compressed(level))
+            {
+                throw fixie::invalid_operation_error("compressed texture levels cannot be copied into.");
+            }
+
+            texture->copy_sub_data(level, xoffset, yoffset, x, y, width, height, framebuffer);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
 }
 
 void FIXIE_APIENTRY glCullFace(GLenum mode)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2436,6 +3059,7 @@ void FIXIE_APIENTRY glCullFace(GLenum mode)
 
 void FIXIE_APIENTRY glDeleteBuffers(GLsizei n, const GLuint *buffers)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2455,6 +3079,7 @@ void FIXIE_APIENTRY glDeleteBuffers(GLsizei n, const GLuint *buffers)
 
 void FIXIE_APIENTRY glDeleteTextures(GLsizei n, const GLuint *textures)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2474,6 +3099,7 @@ void FIXIE_APIENTRY glDeleteTextures(GLsizei n, const GLuint *textures)
 
 void FIXIE_APIENTRY glDepthFunc(GLenum func)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2503,6 +3129,7 @@ void FIXIE_APIENTRY glDepthFunc(GLenum func)
 
 void FIXIE_APIENTRY glDepthMask(GLboolean flag)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2516,6 +3143,7 @@ void FIXIE_APIENTRY glDepthMask(GLboolean flag)
 
 void FIXIE_APIENTRY glDepthRangex(GLclampx zNear, GLclampx zFar)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2529,16 +3157,19 @@ void FIXIE_APIENTRY glDepthRangex(GLclampx zNear, GLclampx zFar)
 
 void FIXIE_APIENTRY glDisable(GLenum cap)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     GLboolean& property = fixie::get_property(cap) = GL_FALSE;
 }
 
 void FIXIE_APIENTRY glDisableClientState(GLenum array)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_client_state(array, false);
 }
 
 void FIXIE_APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2577,6 +3208,7 @@ void FIXIE_APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
 
 void FIXIE_APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2619,19 +3251,22 @@ void FIXIE_APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, cons
 
 void FIXIE_APIENTRY glEnable(GLenum cap)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_property(cap) = GL_TRUE;
 }
 
 void FIXIE_APIENTRY glEnableClientState(GLenum array)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_client_state(array, true);
 }
 
 void FIXIE_APIENTRY glFinish(void)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
-        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context_without_submit();
         ctx->finish();
     }
     catch (...)
@@ -2642,9 +3277,10 @@ void FIXIE_APIENTRY glFinish(void)
 
 void FIXIE_APIENTRY glFlush(void)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
-        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context_without_submit();
         ctx->flush();
     }
     catch (...)
@@ -2655,16 +3291,19 @@ void FIXIE_APIENTRY glFlush(void)
 
 void FIXIE_APIENTRY glFogx(GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_fog_parameters(pname, &param, false);
 }
 
 void FIXIE_APIENTRY glFogxv(GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_fog_parameters(pname, params, true);
 }
 
 void FIXIE_APIENTRY glFrontFace(GLenum mode)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2688,6 +3327,7 @@ void FIXIE_APIENTRY glFrontFace(GLenum mode)
 
 void FIXIE_APIENTRY glFrustumx(GLfixed left, GLfixed right, GLfixed bottom, GLfixed top, GLfixed zNear, GLfixed zFar)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         if (fixie::fixed_to_float(zNear) <= 0.0f || fixie::fixed_to_float(zFar) < 0.0f)
@@ -2726,21 +3366,25 @@ void FIXIE_APIENTRY glFrustumx(GLfixed left, GLfixed right, GLfixed bottom, GLfi
 
 void FIXIE_APIENTRY glGetBooleanv(GLenum pname, GLboolean *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_parameter(pname, params);
 }
 
 void FIXIE_APIENTRY glGetBufferParameteriv(GLenum target, GLenum pname, GLint *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_buffer_parameter(target, pname, params);
 }
 
 void FIXIE_APIENTRY glGetClipPlanex(GLenum pname, GLfixed eqn[4])
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_clip_plane(pname, eqn);
 }
 
 void FIXIE_APIENTRY glGenBuffers(GLsizei n, GLuint *buffers)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2778,6 +3422,7 @@ void FIXIE_APIENTRY glGenBuffers(GLsizei n, GLuint *buffers)
 
 void FIXIE_APIENTRY glGenTextures(GLsizei n, GLuint *textures)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2815,6 +3460,7 @@ void FIXIE_APIENTRY glGenTextures(GLsizei n, GLuint *textures)
 
 GLenum FIXIE_APIENTRY glGetError(void)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2831,6 +3477,7 @@ GLenum FIXIE_APIENTRY glGetError(void)
 
 void FIXIE_APIENTRY glGetFixedv(GLenum pname, GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_parameter(pname, fixie::real_ptr(params));
     //std::vector<GLfloat> float_values(write_count);
     //fixie::get_parameter(pname, float_values.data());
@@ -2839,11 +3486,19 @@ void FIXIE_APIENTRY glGetFixedv(GLenum pname, GLfixed *params)
 
 void FIXIE_APIENTRY glGetIntegerv(GLenum pname, GLint *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::get_parameter(pname, params);
+}
+
+void FIXIE_APIENTRY glGetInteger64vEXT(GLenum pname, GLint64 *params)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_parameter(pname, params);
 }
 
 void FIXIE_APIENTRY glGetLightxv(GLenum light, GLenum pname, GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_light_parameter(light, pname, fixie::real_ptr(params));
     //std::vector<GLfloat> float_values(write_count);
     //fixie::get_light_parameter(light, pname, float_values.data());
@@ -2852,6 +3507,7 @@ void FIXIE_APIENTRY glGetLightxv(GLenum light, GLenum pname, GLfixed *params)
 
 void FIXIE_APIENTRY glGetMaterialxv(GLenum face, GLenum pname, GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_material_parameter(face, pname, fixie::real_ptr(params));
     //std::vector<GLfloat> float_values(write_count);
     //fixie::get_material_parameter(face, pname, float_values.data());
@@ -2860,11 +3516,13 @@ void FIXIE_APIENTRY glGetMaterialxv(GLenum face, GLenum pname, GLfixed *params)
 
 void FIXIE_APIENTRY glGetPointerv(GLenum pname, GLvoid **params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_pointer_parameter(pname, params);
 }
 
 const GLubyte * FIXIE_APIENTRY glGetString(GLenum name)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2886,11 +3544,13 @@ const GLubyte * FIXIE_APIENTRY glGetString(GLenum name)
 
 void FIXIE_APIENTRY glGetTexEnviv(GLenum env, GLenum pname, GLint *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_texture_evironment_parameter(env, pname, params);
 }
 
 void FIXIE_APIENTRY glGetTexEnvxv(GLenum env, GLenum pname, GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_texture_evironment_parameter(env, pname, fixie::real_ptr(params));
     //std::vector<GLfloat> float_values(write_count);
     //fixie::get_texture_evironment_parameter(env, pname, float_values.data());
@@ -2899,11 +3559,13 @@ void FIXIE_APIENTRY glGetTexEnvxv(GLenum env, GLenum pname, GLfixed *params)
 
 void FIXIE_APIENTRY glGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_texture_parameter(target, pname, params);
 }
 
 void FIXIE_APIENTRY glGetTexParameterxv(GLenum target, GLenum pname, GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_texture_parameter(target, pname, fixie::real_ptr(params));
     //std::vector<GLfloat> float_values(write_count);
     //fixie::get_texture_parameter(target, pname, float_values.data());
@@ -2912,6 +3574,7 @@ void FIXIE_APIENTRY glGetTexParameterxv(GLenum target, GLenum pname, GLfixed *pa
 
 void FIXIE_APIENTRY glHint(GLenum target, GLenum mode)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2936,6 +3599,8 @@ void FIXIE_APIENTRY glHint(GLenum target, GLenum mode)
         case GL_LINE_SMOOTH_HINT:            hint_state.line_smooth_hint() = mode;            break;
         case GL_FOG_HINT:                    hint_state.fog_hint() = mode;                    break;
         case GL_GENERATE_MIPMAP_HINT:        hint_state.generate_mipmap_hint() = mode;        break;
+        case GL_LIGHTING_HINT_FIXIE:         hint_state.lighting_hint() = mode;               break;
+        case GL_CLEAR_INVALIDATE_HINT_FIXIE: hint_state.clear_invalidate_hint() = mode;       break;
 
         default:
             throw fixie::invalid_enum_error(fixie::format("invalid hint target, %s.", fixie::get_gl_enum_name(target).c_str()));
@@ -2949,6 +3614,7 @@ void FIXIE_APIENTRY glHint(GLenum target, GLenum mode)
 
 GLboolean FIXIE_APIENTRY glIsBuffer(GLuint buffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2962,11 +3628,13 @@ GLboolean FIXIE_APIENTRY glIsBuffer(GLuint buffer)
 
 GLboolean FIXIE_APIENTRY glIsEnabled(GLenum cap)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     return fixie::get_property(cap);
 }
 
 GLboolean FIXIE_APIENTRY glIsTexture(GLuint texture)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -2980,41 +3648,49 @@ GLboolean FIXIE_APIENTRY glIsTexture(GLuint texture)
 
 void FIXIE_APIENTRY glLightModelx(GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_model_parameters(pname, &param, false);
 }
 
 void FIXIE_APIENTRY glLightModelxv(GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_model_parameters(pname, params, true);
 }
 
 void FIXIE_APIENTRY glLightx(GLenum light, GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_parameters(light, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glLightxv(GLenum light, GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_light_parameters(light, pname, params, true);
 }
 
 void FIXIE_APIENTRY glLineWidthx(GLfixed width)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_line_width(width);
 }
 
 void FIXIE_APIENTRY glLoadIdentity(void)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::identity(), false);
 }
 
 void FIXIE_APIENTRY glLoadMatrixx(const GLfixed *m)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(m, false);
 }
 
 void FIXIE_APIENTRY glLogicOp(GLenum opcode)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3053,16 +3729,19 @@ void FIXIE_APIENTRY glLogicOp(GLenum opcode)
 
 void FIXIE_APIENTRY glMaterialx(GLenum face, GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_material_parameters(face, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glMaterialxv(GLenum face, GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_material_parameters(face, pname, params, true);
 }
 
 void FIXIE_APIENTRY glMatrixMode(GLenum mode)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3074,6 +3753,13 @@ void FIXIE_APIENTRY glMatrixMode(GLenum mode)
         case GL_PROJECTION:
             break;
 
+        case GL_MATRIX_PALETTE_OES:
+            if (ctx->caps().max_palette_matrices() == 0)
+            {
+                throw fixie::invalid_enum_error("matrix palettes are not supported.");
+            }
+            break;
+
         default:
             throw fixie::invalid_enum_error(fixie::format("invalid matrix mode, %s.", fixie::get_gl_enum_name(mode).c_str()));
         }
@@ -3088,11 +3774,13 @@ void FIXIE_APIENTRY glMatrixMode(GLenum mode)
 
 void FIXIE_APIENTRY glMultMatrixx(const GLfixed *m)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(m, true);
 }
 
 void FIXIE_APIENTRY glMultiTexCoord4x(GLenum target, GLfixed s, GLfixed t, GLfixed r, GLfixed q)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3121,6 +3809,7 @@ void FIXIE_APIENTRY glMultiTexCoord4x(GLenum target, GLfixed s, GLfixed t, GLfix
 
 void FIXIE_APIENTRY glNormal3x(GLfixed nx, GLfixed ny, GLfixed nz)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3142,6 +3831,7 @@ void FIXIE_APIENTRY glNormal3x(GLfixed nx, GLfixed ny, GLfixed nz)
 
 void FIXIE_APIENTRY glNormalPointer(GLenum type, GLsizei stride, const GLvoid *pointer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3183,6 +3873,7 @@ void FIXIE_APIENTRY glNormalPointer(GLenum type, GLsizei stride, const GLvoid *p
 
 void FIXIE_APIENTRY glOrthox(GLfixed left, GLfixed right, GLfixed bottom, GLfixed top, GLfixed zNear, GLfixed zFar)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         if (fixie::fixed_to_float(left) == fixie::fixed_to_float(right))
@@ -3215,6 +3906,7 @@ void FIXIE_APIENTRY glOrthox(GLfixed left, GLfixed right, GLfixed bottom, GLfixe
 
 void FIXIE_APIENTRY glPixelStorei(GLenum pname, GLint param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3236,6 +3928,11 @@ void FIXIE_APIENTRY glPixelStorei(GLenum pname, GLint param)
             }
             ctx->state().pixel_store_state().pack_alignment() = param;
             break;
+
+        case GL_PACK_REVERSE_ROW_ORDER_FIXIE:
+            ctx->state().pixel_store_state().pack_reverse_row_order() = (param != 0) ? GL_TRUE : GL_FALSE;
+            break;
+
         default:
             throw fixie::invalid_enum_error(fixie::format("invalid pixel store parameter, %s", fixie::get_gl_enum_name(pname).c_str()));
         }
@@ -3248,26 +3945,71 @@ void FIXIE_APIENTRY glPixelStorei(GLenum pname, GLint param)
 
 void FIXIE_APIENTRY glPointParameterx(GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_point_parameters(pname, &param, false);
 }
 
 void FIXIE_APIENTRY glPointParameterxv(GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_point_parameters(pname, params, true);
 }
 
+void FIXIE_APIENTRY glPointSizePointerOES(GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        switch (type)
+        {
+        case GL_FIXED:
+        case GL_FLOAT:
+            break;
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid point size pointer type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (stride < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("point size stride cannot be negative, %i provided.", stride));
+        }
+
+        std::shared_ptr<fixie::vertex_array> vertex_array = ctx->state().bound_vertex_array().lock();
+        if (vertex_array == nullptr)
+        {
+            throw fixie::state_error("null vertex array bound.");
+        }
+
+        fixie::vertex_attribute& attribute = vertex_array->point_size_attribute();
+        attribute.size() = 1;
+        attribute.type() = type;
+        attribute.stride() = stride;
+        attribute.pointer() = pointer;
+        attribute.buffer() = ctx->state().bound_array_buffer();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
 void FIXIE_APIENTRY glPointSizex(GLfixed size)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_point_size(size);
 }
 
 void FIXIE_APIENTRY glPolygonOffsetx(GLfixed factor, GLfixed units)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_polgyon_offset(factor, units);
 }
 
 void FIXIE_APIENTRY glPopMatrix(void)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3287,6 +4029,10 @@ void FIXIE_APIENTRY glPopMatrix(void)
             stack = &ctx->state().projection_matrix_stack();
             break;
 
+        case GL_MATRIX_PALETTE_OES:
+            stack = &ctx->state().palette_matrix_stack(ctx->state().current_palette_matrix());
+            break;
+
         default:
             UNREACHABLE();
             throw fixie::state_error("unknown matrix mode.");
@@ -3306,6 +4052,7 @@ void FIXIE_APIENTRY glPopMatrix(void)
 
 void FIXIE_APIENTRY glPushMatrix(void)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3329,6 +4076,12 @@ void FIXIE_APIENTRY glPushMatrix(void)
             max_stack_depth = ctx->caps().max_projection_stack_depth();
             break;
 
+        case GL_MATRIX_PALETTE_OES:
+            // Palette matrices are single matrices, not stacks
+            stack = &ctx->state().palette_matrix_stack(ctx->state().current_palette_matrix());
+            max_stack_depth = 1;
+            break;
+
         default:
             UNREACHABLE();
             throw fixie::state_error("unknown matrix mode.");
@@ -3349,6 +4102,7 @@ void FIXIE_APIENTRY glPushMatrix(void)
 
 void FIXIE_APIENTRY glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3365,13 +4119,13 @@ void FIXIE_APIENTRY glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height
                                                            width, height));
         }
 
-        if (format != GL_RGBA || format != framebuffer->preferred_read_format())
+        if (format != GL_RGBA && format != framebuffer->preferred_read_format())
         {
             throw fixie::invalid_operation_error(fixie::format("read pixels format must be GL_RGBA or IMPLEMENTATION_COLOR_READ_FORMAT, "
                                                                "%s provided.", fixie::get_gl_enum_name(format).c_str()));
         }
 
-        if (type != GL_UNSIGNED_BYTE || type != framebuffer->preferred_read_type())
+        if (type != GL_UNSIGNED_BYTE && type != framebuffer->preferred_read_type())
         {
             throw fixie::invalid_operation_error(fixie::format("read pixels type must be GL_UNSIGNED_BYTE or IMPLEMENTATION_COLOR_READ_TYPE, "
                                                                "%s provided.", fixie::get_gl_enum_name(type).c_str()));
@@ -3387,6 +4141,7 @@ void FIXIE_APIENTRY glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height
 
 void FIXIE_APIENTRY glRotatex(GLfixed angle, GLfixed x, GLfixed y, GLfixed z)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::rotate(fixie::fixed_to_float(angle),
                                              fixie::vector3(fixie::fixed_to_float(x), fixie::fixed_to_float(y), fixie::fixed_to_float(z))),
                       true);
@@ -3394,6 +4149,7 @@ void FIXIE_APIENTRY glRotatex(GLfixed angle, GLfixed x, GLfixed y, GLfixed z)
 
 void FIXIE_APIENTRY glSampleCoverage(GLclampf value, GLboolean invert)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3409,6 +4165,7 @@ void FIXIE_APIENTRY glSampleCoverage(GLclampf value, GLboolean invert)
 
 void FIXIE_APIENTRY glSampleCoveragex(GLclampx value, GLboolean invert)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3424,11 +4181,13 @@ void FIXIE_APIENTRY glSampleCoveragex(GLclampx value, GLboolean invert)
 
 void FIXIE_APIENTRY glScalex(GLfixed x, GLfixed y, GLfixed z)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::scale(fixie::vector3(fixie::fixed_to_float(x), fixie::fixed_to_float(y), fixie::fixed_to_float(z))), true);
 }
 
 void FIXIE_APIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3448,6 +4207,7 @@ void FIXIE_APIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
 
 void FIXIE_APIENTRY glShadeModel(GLenum mode)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3471,6 +4231,7 @@ void FIXIE_APIENTRY glShadeModel(GLenum mode)
 
 void FIXIE_APIENTRY glStencilFunc(GLenum func, GLint ref, GLuint mask)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3502,6 +4263,7 @@ void FIXIE_APIENTRY glStencilFunc(GLenum func, GLint ref, GLuint mask)
 
 void FIXIE_APIENTRY glStencilMask(GLuint mask)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3515,6 +4277,7 @@ void FIXIE_APIENTRY glStencilMask(GLuint mask)
 
 void FIXIE_APIENTRY glStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3554,6 +4317,7 @@ void FIXIE_APIENTRY glStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
 
 void FIXIE_APIENTRY glTexCoordPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3605,26 +4369,31 @@ void FIXIE_APIENTRY glTexCoordPointer(GLint size, GLenum type, GLsizei stride, c
 
 void FIXIE_APIENTRY glTexEnvi(GLenum target, GLenum pname, GLint param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_env_int_parameters(target, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glTexEnvx(GLenum target, GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_env_real_parameters(target, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glTexEnviv(GLenum target, GLenum pname, const GLint *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_env_int_parameters(target, pname, params, true);
 }
 
 void FIXIE_APIENTRY glTexEnvxv(GLenum target, GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_env_real_parameters(target, pname, params, true);
 }
 
 void FIXIE_APIENTRY glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3696,26 +4465,31 @@ void FIXIE_APIENTRY glTexImage2D(GLenum target, GLint level, GLint internalforma
 
 void FIXIE_APIENTRY glTexParameteri(GLenum target, GLenum pname, GLint param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_int_parameters(target, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glTexParameterx(GLenum target, GLenum pname, GLfixed param)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_real_parameters(target, pname, &param, false);
 }
 
 void FIXIE_APIENTRY glTexParameteriv(GLenum target, GLenum pname, const GLint *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_int_parameters(target, pname, params, true);
 }
 
 void FIXIE_APIENTRY glTexParameterxv(GLenum target, GLenum pname, const GLfixed *params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_texture_real_parameters(target, pname, params, true);
 }
 
 void FIXIE_APIENTRY glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3789,11 +4563,13 @@ void FIXIE_APIENTRY glTexSubImage2D(GLenum target, GLint level, GLint xoffset, G
 
 void FIXIE_APIENTRY glTranslatex(GLfixed x, GLfixed y, GLfixed z)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::set_matrix(fixie::matrix4::translate(fixie::vector3(fixie::fixed_to_float(x), fixie::fixed_to_float(y), fixie::fixed_to_float(z))), true);
 }
 
 void FIXIE_APIENTRY glVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -3845,6 +4621,7 @@ void FIXIE_APIENTRY glVertexPointer(GLint size, GLenum type, GLsizei stride, con
 
 void FIXIE_APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -11,10 +11,12 @@
 
 #include "fixie_lib/debug.hpp"
 #include "fixie_lib/context.hpp"
+#include "fixie_lib/profiler.hpp"
 #include "fixie_lib/exceptions.hpp"
 #include "fixie_lib/util.hpp"
 #include "fixie_lib/math_util.hpp"
 #include "fixie_lib/enum_names.hpp"
+#include "fixie_lib/fixed_point.hpp"
 
 namespace fixie
 {
@@ -101,6 +103,17 @@ namespace fixie
                 }
                 return 1;
 
+            case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_SAMPLES_EXT:
+                if (framebuffer_attachment->is_texture())
+                {
+                    output[0] = static_cast<output_type>((framebuffer_attachment->texture_samples() > 1) ? framebuffer_attachment->texture_samples() : 0);
+                }
+                else
+                {
+                    throw invalid_operation_error("GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_SAMPLES_EXT is not a valid query when a texture is not bound.");
+                }
+                return 1;
+
             case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE_OES:
                 if (framebuffer_attachment->is_texture())
                 {
@@ -209,6 +222,13 @@ namespace fixie
                 }
                 return 1;
 
+            case GL_RENDERBUFFER_SAMPLES_EXT:
+                if (output != nullptr && renderbuffer != nullptr)
+                {
+                    output[0] = static_cast<output_type>((renderbuffer->samples() > 1) ? renderbuffer->samples() : 0);
+                }
+                return 1;
+
             default:
                 throw invalid_enum_error(format("invalid renderbuffer parameter name, %s.", get_gl_enum_name(pname).c_str()));
             }
@@ -218,6 +238,170 @@ namespace fixie
             return handle_entry_point_exception(0);
         }
     }
+
+    static void renderbuffer_storage(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+    {
+        try
+        {
+            std::shared_ptr<context> ctx = get_current_context();
+
+            if (!ctx->caps().supports_framebuffer_objects())
+            {
+                throw invalid_operation_error("renderbuffers are not supported.");
+            }
+
+            if (target != GL_RENDERBUFFER_OES)
+            {
+                throw invalid_enum_error(format("renderbuffer target must be GL_RENDERBUFFER_OES, %s provided.", get_gl_enum_name(target).c_str()));
+            }
+
+            if (samples < 0 || samples > ctx->caps().max_samples())
+            {
+                throw invalid_value_error(format("samples must be between zero and GL_MAX_SAMPLES_EXT, %i provided.", samples));
+            }
+
+            std::set<GLenum> valid_internal_formats;
+            valid_internal_formats.insert(GL_RGB565_OES);
+            valid_internal_formats.insert(GL_RGBA4_OES);
+            valid_internal_formats.insert(GL_RGB5_A1_OES);
+            valid_internal_formats.insert(GL_DEPTH_COMPONENT16_OES);
+            if (ctx->caps().supports_rgb8_rgba8())
+            {
+                valid_internal_formats.insert(GL_RGBA8_OES);
+                valid_internal_formats.insert(GL_RGB8_OES);
+            }
+            if (ctx->caps().supports_depth24())
+            {
+                valid_internal_formats.insert(GL_DEPTH_COMPONENT24_OES);
+            }
+            if (ctx->caps().supports_depth32())
+            {
+                valid_internal_formats.insert(GL_DEPTH_COMPONENT32_OES);
+            }
+            if (ctx->caps().supports_stencil1())
+            {
+                valid_internal_formats.insert(GL_DEPTH_COMPONENT32_OES);
+            }
+            if (ctx->caps().supports_stencil4())
+            {
+                valid_internal_formats.insert(GL_STENCIL_INDEX4_OES);
+            }
+            if (ctx->caps().supports_stencil8())
+            {
+                valid_internal_formats.insert(GL_STENCIL_INDEX8_OES);
+            }
+
+            if (valid_internal_formats.find(internalformat) == valid_internal_formats.end())
+            {
+                throw invalid_value_error(format("invalid internal format, %s", get_gl_enum_name(internalformat).c_str()));
+            }
+
+            std::shared_ptr<renderbuffer> renderbuffer = ctx->state().bound_renderbuffer().lock();
+            if (renderbuffer != nullptr)
+            {
+                if (samples > 0)
+                {
+                    renderbuffer->set_storage_multisample(target, samples, internalformat, width, height);
+                }
+                else
+                {
+                    renderbuffer->set_storage(target, internalformat, width, height);
+                }
+            }
+        }
+        catch (...)
+        {
+            handle_entry_point_exception();
+        }
+    }
+
+    static void framebuffer_texture_2d(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples)
+    {
+        try
+        {
+            std::shared_ptr<context> ctx = get_current_context();
+
+            if (!ctx->caps().supports_framebuffer_objects())
+            {
+                throw invalid_operation_error("framebuffers are not supported.");
+            }
+
+            std::shared_ptr<framebuffer> framebuffer;
+            switch (target)
+            {
+            case GL_FRAMEBUFFER_OES:
+                framebuffer = ctx->state().bound_framebuffer().lock();
+                break;
+
+            default:
+                throw invalid_enum_error(format("unknown framebuffer target, %s.", get_gl_enum_name(target).c_str()));
+            }
+
+            if (framebuffer == nullptr)
+            {
+                throw state_error("null framebuffer bound.");
+            }
+
+            if (samples < 0 || samples > ctx->caps().max_samples())
+            {
+                throw invalid_value_error(format("samples must be between zero and GL_MAX_SAMPLES_EXT, %i provided.", samples));
+            }
+
+            if (samples > 0 && attachment != GL_COLOR_ATTACHMENT0_OES)
+            {
+                throw invalid_enum_error(format("multisampled textures can only be attached to GL_COLOR_ATTACHMENT0_OES, %s provided.",
+                                                get_gl_enum_name(attachment).c_str()));
+            }
+
+            std::weak_ptr<fixie::texture> tex;
+            switch (textarget)
+            {
+            case GL_TEXTURE_2D:
+                tex = ctx->textures().get_object(texture);
+                break;
+
+            default:
+                throw invalid_enum_error(format("unknown texture target, %s.", get_gl_enum_name(textarget).c_str()));
+            }
+
+            framebuffer_attachment attach(tex, level, std::max(samples, 1));
+            switch (attachment)
+            {
+            case GL_COLOR_ATTACHMENT0_OES:
+                framebuffer->set_color_attachment(attach);
+                break;
+
+            case GL_DEPTH_ATTACHMENT_OES:
+                framebuffer->set_depth_attachment(attach);
+                break;
+
+            case GL_STENCIL_ATTACHMENT_OES:
+                framebuffer->set_stencil_attachment(attach);
+                break;
+
+            default:
+                throw invalid_enum_error(format("unknown framebuffer attachment, %s.", get_gl_enum_name(attachment).c_str()));
+            }
+        }
+        catch (...)
+        {
+            handle_entry_point_exception();
+        }
+    }
+
+    static void draw_texture(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height)
+    {
+        try
+        {
+            // Skip the pending rectangle submission so consecutive draw texture calls build up one batch
+            std::shared_ptr<context> ctx = get_current_context_without_submit();
+            ctx->draw_texture(x, y, z, width, height);
+        }
+        catch (...)
+        {
+            handle_entry_point_exception();
+        }
+    }
 }
 
 extern "C"
@@ -225,6 +409,7 @@ extern "C"
 
 GLboolean FIXIE_APIENTRY glIsRenderbufferOES(GLuint renderbuffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -244,6 +429,7 @@ GLboolean FIXIE_APIENTRY glIsRenderbufferOES(GLuint renderbuffer)
 
 void FIXIE_APIENTRY glBindRenderbufferOES(GLenum target, GLuint renderbuffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -273,6 +459,7 @@ void FIXIE_APIENTRY glBindRenderbufferOES(GLenum target, GLuint renderbuffer)
 
 void FIXIE_APIENTRY glDeleteRenderbuffersOES(GLsizei n, const GLuint* renderbuffers)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -297,6 +484,7 @@ void FIXIE_APIENTRY glDeleteRenderbuffersOES(GLsizei n, const GLuint* renderbuff
 
 void FIXIE_APIENTRY glGenRenderbuffersOES(GLsizei n, GLuint* renderbuffers)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -339,75 +527,19 @@ void FIXIE_APIENTRY glGenRenderbuffersOES(GLsizei n, GLuint* renderbuffers)
 
 void FIXIE_APIENTRY glRenderbufferStorageOES(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
 {
-    try
-    {
-        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
-
-        if (!ctx->caps().supports_framebuffer_objects())
-        {
-            throw fixie::invalid_operation_error("renderbuffers are not supported.");
-        }
-
-        if (target != GL_RENDERBUFFER_OES)
-        {
-            throw fixie::invalid_enum_error(fixie::format("renderbuffer target must be GL_RENDERBUFFER_OES, %s provided.", fixie::get_gl_enum_name(target).c_str()));
-        }
-
-        std::set<GLenum> valid_internal_formats;
-        valid_internal_formats.insert(GL_RGB565_OES);
-        valid_internal_formats.insert(GL_RGBA4_OES);
-        valid_internal_formats.insert(GL_RGB5_A1_OES);
-        valid_internal_formats.insert(GL_DEPTH_COMPONENT16_OES);
-        if (ctx->caps().supports_rgb8_rgba8())
-        {
-            valid_internal_formats.insert(GL_RGBA8_OES);
-            valid_internal_formats.insert(GL_RGB8_OES);
-        }
-        if (ctx->caps().supports_depth24())
-        {
-            valid_internal_formats.insert(GL_DEPTH_COMPONENT24_OES);
-        }
-        if (ctx->caps().supports_depth32())
-        {
-            valid_internal_formats.insert(GL_DEPTH_COMPONENT32_OES);
-        }
-        if (ctx->caps().supports_stencil1())
-        {
-            valid_internal_formats.insert(GL_DEPTH_COMPONENT32_OES);
-        }
-        if (ctx->caps().supports_stencil4())
-        {
-            valid_internal_formats.insert(GL_STENCIL_INDEX4_OES);
-        }
-        if (ctx->caps().supports_stencil8())
-        {
-            valid_internal_formats.insert(GL_STENCIL_INDEX8_OES);
-        }
-
-        if (valid_internal_formats.find(internalformat) == valid_internal_formats.end())
-        {
-            throw fixie::invalid_value_error(fixie::format("invalid internal format, %s", fixie::get_gl_enum_name(internalformat).c_str()));
-        }
-
-        std::shared_ptr<fixie::renderbuffer> renderbuffer = ctx->state().bound_renderbuffer().lock();
-        if (renderbuffer != nullptr)
-        {
-            renderbuffer->set_storage(target, internalformat, width, height);
-        }
-    }
-    catch (...)
-    {
-        fixie::handle_entry_point_exception();
-    }
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::renderbuffer_storage(target, 0, internalformat, width, height);
 }
 
 void FIXIE_APIENTRY glGetRenderbufferParameterivOES(GLenum target, GLenum pname, GLint* params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_renderbuffer_parameter(target, pname, params);
 }
 
 GLboolean FIXIE_APIENTRY glIsFramebufferOES(GLuint framebuffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -427,6 +559,7 @@ GLboolean FIXIE_APIENTRY glIsFramebufferOES(GLuint framebuffer)
 
 void FIXIE_APIENTRY glBindFramebufferOES(GLenum target, GLuint framebuffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -458,6 +591,7 @@ void FIXIE_APIENTRY glBindFramebufferOES(GLenum target, GLuint framebuffer)
 
 void FIXIE_APIENTRY glDeleteFramebuffersOES(GLsizei n, const GLuint* framebuffers)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -493,6 +627,7 @@ void FIXIE_APIENTRY glDeleteFramebuffersOES(GLsizei n, const GLuint* framebuffer
 
 void FIXIE_APIENTRY glGenFramebuffersOES(GLsizei n, GLuint* framebuffers)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -535,6 +670,7 @@ void FIXIE_APIENTRY glGenFramebuffersOES(GLsizei n, GLuint* framebuffers)
 
 GLenum FIXIE_APIENTRY glCheckFramebufferStatusOES(GLenum target)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -571,6 +707,7 @@ GLenum FIXIE_APIENTRY glCheckFramebufferStatusOES(GLenum target)
 
 void FIXIE_APIENTRY glFramebufferRenderbufferOES(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -634,74 +771,19 @@ void FIXIE_APIENTRY glFramebufferRenderbufferOES(GLenum target, GLenum attachmen
 
 void FIXIE_APIENTRY glFramebufferTexture2DOES(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
 {
-    try
-    {
-        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
-
-        if (!ctx->caps().supports_framebuffer_objects())
-        {
-            throw fixie::invalid_operation_error("framebuffers are not supported.");
-        }
-
-        std::shared_ptr<fixie::framebuffer> framebuffer;
-        switch (target)
-        {
-        case GL_FRAMEBUFFER_OES:
-            framebuffer = ctx->state().bound_framebuffer().lock();
-            break;
-
-        default:
-            throw fixie::invalid_enum_error(fixie::format("unknown framebuffer target, %s.", fixie::get_gl_enum_name(target).c_str()));
-        }
-
-        if (framebuffer == nullptr)
-        {
-            throw fixie::state_error("null framebuffer bound.");
-        }
-
-        std::weak_ptr<fixie::texture> tex;
-        switch (textarget)
-        {
-        case GL_TEXTURE_2D:
-            tex = ctx->textures().get_object(texture);
-            break;
-
-        default:
-            throw fixie::invalid_enum_error(fixie::format("unknown texture target, %s.", fixie::get_gl_enum_name(textarget).c_str()));
-        }
-
-        fixie::framebuffer_attachment attach(tex, level, 1);
-        switch (attachment)
-        {
-        case GL_COLOR_ATTACHMENT0_OES:
-            framebuffer->set_color_attachment(attach);
-            break;
-
-        case GL_DEPTH_ATTACHMENT_OES:
-            framebuffer->set_depth_attachment(attach);
-            break;
-
-        case GL_STENCIL_ATTACHMENT_OES:
-            framebuffer->set_stencil_attachment(attach);
-            break;
-
-        default:
-            throw fixie::invalid_enum_error(fixie::format("unknown framebuffer attachment, %s.", fixie::get_gl_enum_name(attachment).c_str()));
-        }
-    }
-    catch (...)
-    {
-        fixie::handle_entry_point_exception();
-    }
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::framebuffer_texture_2d(target, attachment, textarget, texture, level, 0);
 }
 
 void FIXIE_APIENTRY glGetFramebufferAttachmentParameterivOES(GLenum target, GLenum attachment, GLenum pname, GLint* params)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     fixie::get_framebuffer_attachment_parameter(target, attachment, pname, params);
 }
 
 void FIXIE_APIENTRY glGenerateMipmapOES(GLenum target)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -741,6 +823,7 @@ void FIXIE_APIENTRY glGenerateMipmapOES(GLenum target)
 
 void FIXIE_APIENTRY glBindVertexArrayOES(GLuint array)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -766,6 +849,7 @@ void FIXIE_APIENTRY glBindVertexArrayOES(GLuint array)
 
 void FIXIE_APIENTRY glDeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -790,6 +874,7 @@ void FIXIE_APIENTRY glDeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
 
 void FIXIE_APIENTRY glGenVertexArraysOES(GLsizei n, GLuint *arrays)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -832,6 +917,7 @@ void FIXIE_APIENTRY glGenVertexArraysOES(GLsizei n, GLuint *arrays)
 
 GLboolean FIXIE_APIENTRY glIsVertexArrayOES(GLuint array)
 {
+    FIXIE_PROFILE_ENTRY_POINT();
     try
     {
         std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
@@ -849,4 +935,262 @@ GLboolean FIXIE_APIENTRY glIsVertexArrayOES(GLuint array)
     }
 }
 
+void FIXIE_APIENTRY glCurrentPaletteMatrixOES(GLuint matrixpaletteindex)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (matrixpaletteindex >= static_cast<GLuint>(ctx->caps().max_palette_matrices()))
+        {
+            throw fixie::invalid_value_error(fixie::format("palette matrix index must be less than %i, %u provided.", ctx->caps().max_palette_matrices(), matrixpaletteindex));
+        }
+
+        ctx->state().current_palette_matrix() = matrixpaletteindex;
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glLoadPaletteFromModelViewMatrixOES(void)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (ctx->caps().max_palette_matrices() == 0)
+        {
+            throw fixie::invalid_operation_error("matrix palettes are not supported.");
+        }
+
+        fixie::state& state = ctx->state();
+        state.palette_matrix_stack(state.current_palette_matrix()).top() = state.model_view_matrix_stack().top_multiplied();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glMatrixIndexPointerOES(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (size <= 0 || size > ctx->caps().max_vertex_units())
+        {
+            throw fixie::invalid_value_error(fixie::format("matrix index size must be between 1 and %i, %i provided.", ctx->caps().max_vertex_units(), size));
+        }
+
+        if (type != GL_UNSIGNED_BYTE)
+        {
+            throw fixie::invalid_enum_error(fixie::format("invalid matrix index pointer type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (stride < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("matrix index stride cannot be negative, %i provided.", stride));
+        }
+
+        std::shared_ptr<fixie::vertex_array> vertex_array = ctx->state().bound_vertex_array().lock();
+        if (vertex_array == nullptr)
+        {
+            throw fixie::state_error("null vertex array bound.");
+        }
+
+        fixie::vertex_attribute& attribute = vertex_array->matrix_index_attribute();
+        attribute.size() = size;
+        attribute.type() = type;
+        attribute.stride() = stride;
+        attribute.pointer() = pointer;
+        attribute.buffer() = ctx->state().bound_array_buffer();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glWeightPointerOES(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        if (size <= 0 || size > ctx->caps().max_vertex_units())
+        {
+            throw fixie::invalid_value_error(fixie::format("weight size must be between 1 and %i, %i provided.", ctx->caps().max_vertex_units(), size));
+        }
+
+        switch (type)
+        {
+        case GL_FIXED:
+        case GL_FLOAT:
+            break;
+        default:
+            throw fixie::invalid_enum_error(fixie::format("invalid weight pointer type, %s.", fixie::get_gl_enum_name(type).c_str()));
+        }
+
+        if (stride < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("weight stride cannot be negative, %i provided.", stride));
+        }
+
+        std::shared_ptr<fixie::vertex_array> vertex_array = ctx->state().bound_vertex_array().lock();
+        if (vertex_array == nullptr)
+        {
+            throw fixie::state_error("null vertex array bound.");
+        }
+
+        fixie::vertex_attribute& attribute = vertex_array->weight_attribute();
+        attribute.size() = size;
+        attribute.type() = type;
+        attribute.stride() = stride;
+        attribute.pointer() = pointer;
+        attribute.buffer() = ctx->state().bound_array_buffer();
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glDrawTexsOES(GLshort x, GLshort y, GLshort z, GLshort width, GLshort height)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(x, y, z, width, height);
+}
+
+void FIXIE_APIENTRY glDrawTexiOES(GLint x, GLint y, GLint z, GLint width, GLint height)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(static_cast<GLfloat>(x), static_cast<GLfloat>(y), static_cast<GLfloat>(z), static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+}
+
+void FIXIE_APIENTRY glDrawTexxOES(GLfixed x, GLfixed y, GLfixed z, GLfixed width, GLfixed height)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(fixie::fixed_to_float(x), fixie::fixed_to_float(y), fixie::fixed_to_float(z), fixie::fixed_to_float(width), fixie::fixed_to_float(height));
+}
+
+void FIXIE_APIENTRY glDrawTexsvOES(const GLshort *coords)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(coords[0], coords[1], coords[2], coords[3], coords[4]);
+}
+
+void FIXIE_APIENTRY glDrawTexivOES(const GLint *coords)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(static_cast<GLfloat>(coords[0]), static_cast<GLfloat>(coords[1]), static_cast<GLfloat>(coords[2]), static_cast<GLfloat>(coords[3]), static_cast<GLfloat>(coords[4]));
+}
+
+void FIXIE_APIENTRY glDrawTexxvOES(const GLfixed *coords)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(fixie::fixed_to_float(coords[0]), fixie::fixed_to_float(coords[1]), fixie::fixed_to_float(coords[2]), fixie::fixed_to_float(coords[3]), fixie::fixed_to_float(coords[4]));
+}
+
+void FIXIE_APIENTRY glDrawTexfOES(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(x, y, z, width, height);
+}
+
+void FIXIE_APIENTRY glDrawTexfvOES(const GLfloat *coords)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::draw_texture(coords[0], coords[1], coords[2], coords[3], coords[4]);
+}
+
+void FIXIE_APIENTRY glDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    try
+    {
+        std::shared_ptr<fixie::context> ctx = fixie::get_current_context();
+
+        std::shared_ptr<fixie::framebuffer> framebuffer;
+        switch (target)
+        {
+        case GL_FRAMEBUFFER_OES:
+            framebuffer = ctx->state().bound_framebuffer().lock();
+            break;
+
+        default:
+            throw fixie::invalid_enum_error(fixie::format("unknown framebuffer target, %s.", fixie::get_gl_enum_name(target).c_str()));
+        }
+
+        if (numAttachments < 0)
+        {
+            throw fixie::invalid_value_error(fixie::format("number of attachments must be at least zero, %i provided.", numAttachments));
+        }
+
+        if (framebuffer == nullptr)
+        {
+            throw fixie::state_error("null framebuffer bound.");
+        }
+
+        GLboolean is_default_framebuffer = (framebuffer == ctx->framebuffers().get_object(0).lock()) ? GL_TRUE : GL_FALSE;
+
+        GLbitfield mask = 0;
+        for (GLsizei i = 0; i < numAttachments; i++)
+        {
+            GLenum attachment = attachments[i];
+            if (is_default_framebuffer)
+            {
+                switch (attachment)
+                {
+                case GL_COLOR_EXT:   mask |= GL_COLOR_BUFFER_BIT;   break;
+                case GL_DEPTH_EXT:   mask |= GL_DEPTH_BUFFER_BIT;   break;
+                case GL_STENCIL_EXT: mask |= GL_STENCIL_BUFFER_BIT; break;
+
+                default:
+                    throw fixie::invalid_enum_error(fixie::format("invalid default framebuffer attachment, %s.", fixie::get_gl_enum_name(attachment).c_str()));
+                }
+            }
+            else
+            {
+                switch (attachment)
+                {
+                case GL_COLOR_ATTACHMENT0_OES:  mask |= GL_COLOR_BUFFER_BIT;   break;
+                case GL_DEPTH_ATTACHMENT_OES:   mask |= GL_DEPTH_BUFFER_BIT;   break;
+                case GL_STENCIL_ATTACHMENT_OES: mask |= GL_STENCIL_BUFFER_BIT; break;
+
+                default:
+                    throw fixie::invalid_enum_error(fixie::format("invalid framebuffer attachment, %s.", fixie::get_gl_enum_name(attachment).c_str()));
+                }
+            }
+        }
+
+        if (mask != 0)
+        {
+            framebuffer->invalidate(mask);
+        }
+    }
+    catch (...)
+    {
+        fixie::handle_entry_point_exception();
+    }
+}
+
+void FIXIE_APIENTRY glRenderbufferStorageMultisampleEXT(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::renderbuffer_storage(target, samples, internalformat, width, height);
+}
+
+void FIXIE_APIENTRY glFramebufferTexture2DMultisampleEXT(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples)
+{
+    FIXIE_PROFILE_ENTRY_POINT();
+    fixie::framebuffer_texture_2d(target, attachment, textarget, texture, level, samples);
+}
+
 }
@@ -8,6 +8,7 @@ namespace fixie
         : _type(0)
         , _size(0)
         , _usage(GL_STATIC_DRAW)
+        , _label()
         , _impl(std::move(impl))
     {
     }
@@ -27,6 +28,16 @@ namespace fixie
         return _usage;
     }
 
+    std::string& buffer::label()
+    {
+        return _label;
+    }
+
+    const std::string& buffer::label() const
+    {
+        return _label;
+    }
+
     std::weak_ptr<buffer_impl> buffer::impl()
     {
         return _impl;
@@ -2,6 +2,7 @@
 #define _FIXIE_LIB_BUFFER_HPP_
 
 #include <memory>
+#include <string>
 
 #include "fixie/fixie_gl_types.h"
 #include "fixie_lib/noncopyable.hpp"
@@ -25,6 +26,9 @@ namespace fixie
         GLsizei size() const;
         GLenum usage() const;
 
+        std::string& label();
+        const std::string& label() const;
+
         std::weak_ptr<buffer_impl> impl();
         std::weak_ptr<const buffer_impl> impl() const;
 
@@ -36,6 +40,8 @@ namespace fixie
         GLenum _type;
         GLsizei _size;
         GLenum _usage;
+        std::string _label;
+
         std::shared_ptr<buffer_impl> _impl;
     };
 }
@@ -1,4 +1,5 @@
 #include "fixie_lib/caps.hpp"
+#include "fixie/fixie_gl_es.h"
 
 #include <algorithm>
 
@@ -36,6 +37,12 @@ namespace fixie
         , _supports_stencil4(0)
         , _supports_stencil8(0)
         , _supports_vertex_array_objects(0)
+        , _supports_timer_queries(0)
+        , _query_counter_bits(0)
+        , _max_palette_matrices(0)
+        , _max_vertex_units(0)
+        , _supports_instanced_drawing(0)
+        , _max_samples(0)
     {
     }
 
@@ -217,6 +224,11 @@ namespace fixie
         return _compressed_texture_formats.size();
     }
 
+    GLboolean caps::supports_compressed_format(GLenum format) const
+    {
+        return (std::find(begin(_compressed_texture_formats), end(_compressed_texture_formats), format) != end(_compressed_texture_formats)) ? GL_TRUE : GL_FALSE;
+    }
+
     GLsizei& caps::red_bits()
     {
         return _red_bits;
@@ -366,4 +378,64 @@ namespace fixie
     {
         return _supports_vertex_array_objects;
     }
+
+    GLboolean& caps::supports_timer_queries()
+    {
+        return _supports_timer_queries;
+    }
+
+    const GLboolean& caps::supports_timer_queries() const
+    {
+        return _supports_timer_queries;
+    }
+
+    GLsizei& caps::query_counter_bits()
+    {
+        return _query_counter_bits;
+    }
+
+    const GLsizei& caps::query_counter_bits() const
+    {
+        return _query_counter_bits;
+    }
+
+    GLsizei& caps::max_palette_matrices()
+    {
+        return _max_palette_matrices;
+    }
+
+    const GLsizei& caps::max_palette_matrices() const
+    {
+        return _max_palette_matrices;
+    }
+
+    GLsizei& caps::max_vertex_units()
+    {
+        return _max_vertex_units;
+    }
+
+    const GLsizei& caps::max_vertex_units() const
+    {
+        return _max_vertex_units;
+    }
+
+    GLboolean& caps::supports_instanced_drawing()
+    {
+        return _supports_instanced_drawing;
+    }
+
+    const GLboolean& caps::supports_instanced_drawing() const
+    {
+        return _supports_instanced_drawing;
+    }
+
+    GLsizei& caps::max_samples()
+    {
+        return _max_samples;
+    }
+
+    const GLsizei& caps::max_samples() const
+    {
+        return _max_samples;
+    }
 }
@@ -65,6 +65,7 @@ namespace fixie
         void insert_compressed_format(GLenum format);
         const GLenum& compressed_format(size_t n) const;
         size_t compressed_format_count() const;
+        GLboolean supports_compressed_format(GLenum format) const;
 
         GLsizei& red_bits();
         const GLsizei& red_bits() const;
@@ -111,6 +112,24 @@ namespace fixie
         GLboolean& supports_vertex_array_objects();
         const GLboolean& supports_vertex_array_objects() const;
 
+        GLboolean& supports_timer_queries();
+        const GLboolean& supports_timer_queries() const;
+
+        GLsizei& query_counter_bits();
+        const GLsizei& query_counter_bits() const;
+
+        GLsizei& max_palette_matrices();
+        const GLsizei& max_palette_matrices() const;
+
+        GLsizei& max_vertex_units();
+        const GLsizei& max_vertex_units() const;
+
+        GLboolean& supports_instanced_drawing();
+        const GLboolean& supports_instanced_drawing() const;
+
+        GLsizei& max_samples();
+        const GLsizei& max_samples() const;
+
     private:
         GLsizei _max_lights;
         GLsizei _max_clip_planes;
@@ -146,6 +165,12 @@ namespace fixie
         GLboolean _supports_stencil4;
         GLboolean _supports_stencil8;
         GLboolean _supports_vertex_array_objects;
+        GLboolean _supports_timer_queries;
+        GLsizei _query_counter_bits;
+        GLsizei _max_palette_matrices;
+        GLsizei _max_vertex_units;
+        GLboolean _supports_instanced_drawing;
+        GLsizei _max_samples;
     };
 }
 
@@ -0,0 +1,300 @@
+#include "fixie_lib/compressed_texture.hpp"
+#include "fixie_lib/simd.hpp"
+#include "fixie_lib/tracer.hpp"
+
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace fixie
+{
+    struct paletted_format_info
+    {
+        GLenum format;
+        size_t index_bits;
+        size_t entry_size;
+        GLenum pixel_format;
+        GLenum pixel_type;
+    };
+
+    static const paletted_format_info paletted_formats[] =
+    {
+        { GL_PALETTE4_RGB8_OES,     4, 3, GL_RGB,  GL_UNSIGNED_BYTE          },
+        { GL_PALETTE4_RGBA8_OES,    4, 4, GL_RGBA, GL_UNSIGNED_BYTE          },
+        { GL_PALETTE4_R5_G6_B5_OES, 4, 2, GL_RGB,  GL_UNSIGNED_SHORT_5_6_5   },
+        { GL_PALETTE4_RGBA4_OES,    4, 2, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4 },
+        { GL_PALETTE4_RGB5_A1_OES,  4, 2, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1 },
+        { GL_PALETTE8_RGB8_OES,     8, 3, GL_RGB,  GL_UNSIGNED_BYTE          },
+        { GL_PALETTE8_RGBA8_OES,    8, 4, GL_RGBA, GL_UNSIGNED_BYTE          },
+        { GL_PALETTE8_R5_G6_B5_OES, 8, 2, GL_RGB,  GL_UNSIGNED_SHORT_5_6_5   },
+        { GL_PALETTE8_RGBA4_OES,    8, 2, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4 },
+        { GL_PALETTE8_RGB5_A1_OES,  8, 2, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1 },
+    };
+
+    static const paletted_format_info* find_paletted_format(GLenum format)
+    {
+        const paletted_format_info* first = paletted_formats;
+        const paletted_format_info* last = paletted_formats + sizeof(paletted_formats) / sizeof(paletted_formats[0]);
+        const paletted_format_info* info = std::find_if(first, last, [&](const paletted_format_info& info){ return info.format == format; });
+        return (info != last) ? info : nullptr;
+    }
+
+    static size_t palette_size(const paletted_format_info& info)
+    {
+        return (static_cast<size_t>(1) << info.index_bits) * info.entry_size;
+    }
+
+    static size_t paletted_level_size(const paletted_format_info& info, GLsizei width, GLsizei height)
+    {
+        return (static_cast<size_t>(width) * static_cast<size_t>(height) * info.index_bits + 7) / 8;
+    }
+
+    static GLsizei mip_size(GLsizei size, GLint level)
+    {
+        return std::max(size >> level, 1);
+    }
+
+    static size_t etc1_block_count(GLsizei size)
+    {
+        return (static_cast<size_t>(size) + 3) / 4;
+    }
+
+    static const size_t etc1_block_size = 8;
+
+    GLboolean is_paletted_format(GLenum format)
+    {
+        return (find_paletted_format(format) != nullptr) ? GL_TRUE : GL_FALSE;
+    }
+
+    GLboolean is_etc1_format(GLenum format)
+    {
+        return (format == GL_ETC1_RGB8_OES) ? GL_TRUE : GL_FALSE;
+    }
+
+    GLsizei compressed_image_size(GLenum format, GLsizei width, GLsizei height, GLsizei levels)
+    {
+        size_t size = 0;
+        if (const paletted_format_info* info = find_paletted_format(format))
+        {
+            size += palette_size(*info);
+            for (GLint level = 0; level < levels; level++)
+            {
+                size += paletted_level_size(*info, mip_size(width, level), mip_size(height, level));
+            }
+        }
+        else if (is_etc1_format(format))
+        {
+            for (GLint level = 0; level < levels; level++)
+            {
+                size += etc1_block_count(mip_size(width, level)) * etc1_block_count(mip_size(height, level)) * etc1_block_size;
+            }
+        }
+        return static_cast<GLsizei>(size);
+    }
+
+    GLenum paletted_format_pixel_format(GLenum format)
+    {
+        const paletted_format_info* info = find_paletted_format(format);
+        return (info != nullptr) ? info->pixel_format : 0;
+    }
+
+    GLenum paletted_format_pixel_type(GLenum format)
+    {
+        const paletted_format_info* info = find_paletted_format(format);
+        return (info != nullptr) ? info->pixel_type : 0;
+    }
+
+    size_t paletted_format_pixel_size(GLenum format)
+    {
+        const paletted_format_info* info = find_paletted_format(format);
+        return (info != nullptr) ? info->entry_size : 0;
+    }
+
+    template <size_t entry_size, size_t index_bits>
+    static void expand_paletted_rows(const GLubyte* palette, const GLubyte* indices, size_t width, size_t first_row, size_t last_row, GLubyte* pixels)
+    {
+        for (size_t pixel = first_row * width; pixel < last_row * width; pixel++)
+        {
+            // Four bit indices are packed two to a byte, the first texel in the high nibble
+            size_t index = (index_bits == 8) ? indices[pixel] : ((pixel & 1) ? (indices[pixel >> 1] & 0xF) : (indices[pixel >> 1] >> 4));
+            std::memcpy(pixels + pixel * entry_size, palette + index * entry_size, entry_size);
+        }
+    }
+
+    template <size_t index_bits>
+    static void expand_paletted_rows(size_t entry_size, const GLubyte* palette, const GLubyte* indices, size_t width, size_t first_row, size_t last_row, GLubyte* pixels)
+    {
+        switch (entry_size)
+        {
+        case 2: expand_paletted_rows<2, index_bits>(palette, indices, width, first_row, last_row, pixels); break;
+        case 3: expand_paletted_rows<3, index_bits>(palette, indices, width, first_row, last_row, pixels); break;
+        case 4: expand_paletted_rows<4, index_bits>(palette, indices, width, first_row, last_row, pixels); break;
+        default: break;
+        }
+    }
+
+    void decode_paletted_level(GLenum format, const GLvoid* data, GLsizei width, GLsizei height, GLint level, GLvoid* pixels, worker_pool& pool)
+    {
+        FIXIE_TRACE_SCOPE("upload", "decode_paletted_level");
+
+        const paletted_format_info* info = find_paletted_format(format);
+        if (info == nullptr)
+        {
+            return;
+        }
+
+        const GLubyte* palette = static_cast<const GLubyte*>(data);
+        const GLubyte* indices = palette + palette_size(*info);
+        for (GLint i = 0; i < level; i++)
+        {
+            indices += paletted_level_size(*info, mip_size(width, i), mip_size(height, i));
+        }
+
+        const size_t level_width = mip_size(width, level);
+        const size_t level_height = mip_size(height, level);
+        GLubyte* output = static_cast<GLubyte*>(pixels);
+        pool.parallel_for(level_height, 64, [&](size_t first_row, size_t last_row)
+        {
+            if (info->index_bits == 8)
+            {
+                expand_paletted_rows<8>(info->entry_size, palette, indices, level_width, first_row, last_row, output);
+            }
+            else
+            {
+                expand_paletted_rows<4>(info->entry_size, palette, indices, level_width, first_row, last_row, output);
+            }
+        });
+    }
+
+    static const GLint etc1_modifier_table[8][4] =
+    {
+        {  2,   8,  -2,   -8 },
+        {  5,  17,  -5,  -17 },
+        {  9,  29,  -9,  -29 },
+        { 13,  42, -13,  -42 },
+        { 18,  60, -18,  -60 },
+        { 24,  80, -24,  -80 },
+        { 33, 106, -33, -106 },
+        { 47, 183, -47, -183 },
+    };
+
+    static GLint extend_4_to_8(GLint value)
+    {
+        return (value << 4) | value;
+    }
+
+    static GLint extend_5_to_8(GLint value)
+    {
+        return (value << 3) | (value >> 2);
+    }
+
+    // Saturates the 16 pixels of each of the three channels to bytes
+    static void clamp_etc1_channels(const int16_t* channels, uint8_t* clamped)
+    {
+        for (size_t channel = 0; channel < 3; channel++)
+        {
+            const int16_t* input = channels + channel * 16;
+            uint8_t* output = clamped + channel * 16;
+#if defined(FIXIE_SSE2)
+            __m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(input));
+            __m128i high = _mm_load_si128(reinterpret_cast<const __m128i*>(input + 8));
+            _mm_store_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(low, high));
+#elif defined(FIXIE_NEON)
+            vst1q_u8(output, vcombine_u8(vqmovun_s16(vld1q_s16(input)), vqmovun_s16(vld1q_s16(input + 8))));
+#else
+            for (size_t i = 0; i < 16; i++)
+            {
+                output[i] = static_cast<uint8_t>(std::min<int16_t>(std::max<int16_t>(input[i], 0), 255));
+            }
+#endif
+        }
+    }
+
+    static void decode_etc1_block(const GLubyte* block, GLubyte* output, size_t row_pitch, size_t width, size_t height)
+    {
+        const bool differential = (block[3] & 0x2) != 0;
+        const bool flipped = (block[3] & 0x1) != 0;
+
+        GLint base_colors[2][3];
+        for (size_t channel = 0; channel < 3; channel++)
+        {
+            if (differential)
+            {
+                GLint value = block[channel] >> 3;
+                GLint delta = static_cast<GLint>(block[channel] & 0x3) - static_cast<GLint>(block[channel] & 0x4);
+                base_colors[0][channel] = extend_5_to_8(value);
+                base_colors[1][channel] = extend_5_to_8((value + delta) & 0x1F);
+            }
+            else
+            {
+                base_colors[0][channel] = extend_4_to_8(block[channel] >> 4);
+                base_colors[1][channel] = extend_4_to_8(block[channel] & 0xF);
+            }
+        }
+
+        const GLint* modifiers[2] = { etc1_modifier_table[block[3] >> 5], etc1_modifier_table[(block[3] >> 2) & 0x7] };
+        const GLuint index_msbs = (static_cast<GLuint>(block[4]) << 8) | block[5];
+        const GLuint index_lsbs = (static_cast<GLuint>(block[6]) << 8) | block[7];
+
+        // Pixel indices run down the columns, the channels are laid out in rows for the clamp
+        FIXIE_ALIGN(16) int16_t channels[48];
+        for (size_t y = 0; y < 4; y++)
+        {
+            for (size_t x = 0; x < 4; x++)
+            {
+                const size_t bit = x * 4 + y;
+                const size_t index = (((index_msbs >> bit) & 1) << 1) | ((index_lsbs >> bit) & 1);
+                const size_t subblock = flipped ? (y >= 2) : (x >= 2);
+                const GLint modifier = modifiers[subblock][index];
+                for (size_t channel = 0; channel < 3; channel++)
+                {
+                    channels[channel * 16 + y * 4 + x] = static_cast<int16_t>(base_colors[subblock][channel] + modifier);
+                }
+            }
+        }
+
+        FIXIE_ALIGN(16) uint8_t clamped[48];
+        clamp_etc1_channels(channels, clamped);
+
+        for (size_t y = 0; y < height; y++)
+        {
+            GLubyte* row = output + y * row_pitch;
+            for (size_t x = 0; x < width; x++)
+            {
+                row[x * 3 + 0] = clamped[y * 4 + x];
+                row[x * 3 + 1] = clamped[16 + y * 4 + x];
+                row[x * 3 + 2] = clamped[32 + y * 4 + x];
+            }
+        }
+    }
+
+    void decode_etc1(const GLvoid* data, GLsizei width, GLsizei height, GLvoid* pixels, worker_pool& pool)
+    {
+        FIXIE_TRACE_SCOPE("upload", "decode_etc1");
+
+        const GLubyte* blocks = static_cast<const GLubyte*>(data);
+        GLubyte* output = static_cast<GLubyte*>(pixels);
+        const size_t blocks_wide = etc1_block_count(width);
+        const size_t blocks_high = etc1_block_count(height);
+        const size_t row_pitch = static_cast<size_t>(width) * 3;
+
+        // Each task decodes a tile spanning the full width and eight rows of blocks
+        pool.parallel_for(blocks_high, 8, [&](size_t first_block_row, size_t last_block_row)
+        {
+            for (size_t block_y = first_block_row; block_y < last_block_row; block_y++)
+            {
+                for (size_t block_x = 0; block_x < blocks_wide; block_x++)
+                {
+                    const GLubyte* block = blocks + (block_y * blocks_wide + block_x) * etc1_block_size;
+                    GLubyte* block_output = output + block_y * 4 * row_pitch + block_x * 4 * 3;
+                    const size_t block_width = std::min<size_t>(4, width - block_x * 4);
+                    const size_t block_height = std::min<size_t>(4, height - block_y * 4);
+                    decode_etc1_block(block, block_output, row_pitch, block_width, block_height);
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef _FIXIE_LIB_COMPRESSED_TEXTURE_HPP_
+#define _FIXIE_LIB_COMPRESSED_TEXTURE_HPP_
+
+#include "fixie/fixie_gl_types.h"
+#include "fixie_lib/worker_pool.hpp"
+
+#include <cstddef>
+
+namespace fixie
+{
+    GLboolean is_paletted_format(GLenum format);
+    GLboolean is_etc1_format(GLenum format);
+
+    // Size of a complete compressed image, paletted images hold the palette followed by every mip level
+    GLsizei compressed_image_size(GLenum format, GLsizei width, GLsizei height, GLsizei levels);
+
+    GLenum paletted_format_pixel_format(GLenum format);
+    GLenum paletted_format_pixel_type(GLenum format);
+    size_t paletted_format_pixel_size(GLenum format);
+
+    // Expands one mip level of a paletted image into tightly packed pixels of the palette entry format and type
+    void decode_paletted_level(GLenum format, const GLvoid* data, GLsizei width, GLsizei height, GLint level, GLvoid* pixels, worker_pool& pool);
+
+    // Decodes an ETC1 image into tightly packed GL_RGB GL_UNSIGNED_BYTE pixels
+    void decode_etc1(const GLvoid* data, GLsizei width, GLsizei height, GLvoid* pixels, worker_pool& pool);
+}
+
+#endif // _FIXIE_LIB_COMPRESSED_TEXTURE_HPP_
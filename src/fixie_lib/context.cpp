@@ -1,8 +1,13 @@
 #include "fixie_lib/context.hpp"
 #include "fixie_lib/exceptions.hpp"
 #include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
 #include "fixie_lib/debug.hpp"
+#include "fixie_lib/enum_names.hpp"
 #include "fixie_lib/util.hpp"
+#include "fixie_lib/tracer.hpp"
+#include "fixie_lib/math_util.hpp"
+#include "fixie_lib/worker_pool.hpp"
 
 #include <set>
 #include <algorithm>
@@ -17,11 +22,15 @@ namespace fixie
         , _renderbuffers(1)
         , _framebuffers(1)
         , _vertex_arrays(1)
+        , _queries(1)
         , _version_string(format("OpenGL ES-%s %u.%u", "CM", 1, 1))
         , _renderer_string(format("fixie (%s)", _impl->renderer_desc().c_str()))
         , _vendor_string("vonture")
         , _extensions(initialize_extensions(impl->caps()))
         , _extension_string(build_extension_string(_extensions))
+        , _texture_rects(impl->caps().max_texture_units())
+        , _pending_read_pixels()
+        , _next_read_pixels_request(0)
     {
         _framebuffers.insert_object(0, std::unique_ptr<fixie::framebuffer>(new fixie::framebuffer(std::move(impl->create_default_framebuffer()))), true);
         _state.bind_framebuffer(_framebuffers.get_object(0));
@@ -135,6 +144,23 @@ namespace fixie
         return _framebuffers;
     }
 
+    GLuint context::create_query()
+    {
+        std::unique_ptr<query_impl> impl = _impl->create_query();
+        std::unique_ptr<fixie::query> query = std::unique_ptr<fixie::query>(new fixie::query(std::move(impl)));
+        return _queries.allocate_object(std::move(query));
+    }
+
+    const handle_manager<GLuint, query>& context::queries() const
+    {
+        return _queries;
+    }
+
+    handle_manager<GLuint, query>& context::queries()
+    {
+        return _queries;
+    }
+
     GLuint context::create_vertex_array()
     {
         std::unique_ptr<fixie::vertex_array> vao = std::unique_ptr<fixie::vertex_array>(new fixie::vertex_array(get_default_vertex_array(_impl->caps())));
@@ -161,21 +187,189 @@ namespace fixie
         _impl->draw_elements(_state, mode, count, type, indices);
     }
 
+    void context::draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count)
+    {
+        if (!_impl->caps().supports_instanced_drawing())
+        {
+            throw invalid_operation_error("instanced drawing is not supported.");
+        }
+
+        _impl->draw_arrays_instanced(_state, mode, first, count, instance_count);
+    }
+
+    void context::draw_elements_instanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count)
+    {
+        if (!_impl->caps().supports_instanced_drawing())
+        {
+            throw invalid_operation_error("instanced drawing is not supported.");
+        }
+
+        _impl->draw_elements_instanced(_state, mode, count, type, indices, instance_count);
+    }
+
+    void context::draw_texture(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height)
+    {
+        if (width <= 0.0f || height <= 0.0f)
+        {
+            throw invalid_value_error(format("draw texture width and height must be greater than zero, %g and %g provided.", width, height));
+        }
+
+        _texture_rects.add_rect(x, y, clamp(z, 0.0f, 1.0f), width, height);
+        for (size_t i = 0; i < _texture_rects.texture_unit_count(); i++)
+        {
+            std::shared_ptr<const texture> texture = _state.bound_texture(i).lock();
+            if (!_state.texture_environment(i).texture_enabled() || !texture || texture->mip_levels() == 0 ||
+                texture->mip_level_width(0) == 0 || texture->mip_level_height(0) == 0)
+            {
+                continue;
+            }
+
+            GLfloat texture_width = static_cast<GLfloat>(texture->mip_level_width(0));
+            GLfloat texture_height = static_cast<GLfloat>(texture->mip_level_height(0));
+            const rectangle& crop = texture->crop_rect();
+            _texture_rects.set_texcoord_rect(i, crop.x() / texture_width, crop.y() / texture_height,
+                                             (crop.x() + crop.width()) / texture_width, (crop.y() + crop.height()) / texture_height);
+        }
+    }
+
+    void context::submit_texture_rects()
+    {
+        if (_texture_rects.empty())
+        {
+            return;
+        }
+
+        try
+        {
+            _impl->draw_texture_rects(_state, _texture_rects);
+        }
+        catch (...)
+        {
+            _texture_rects.clear();
+            throw;
+        }
+        _texture_rects.clear();
+    }
+
     void context::clear(GLbitfield mask)
     {
+        if (_state.hint_state().clear_invalidate_hint() == GL_FASTEST)
+        {
+            invalidate_before_clear(mask);
+        }
+
         _impl->clear(_state, mask);
     }
 
+    void context::invalidate_before_clear(GLbitfield mask)
+    {
+        // Depth and stencil buffers of the default framebuffer that are about to be fully overwritten never need their
+        // old contents loaded, only buffers whose every bit is written by the clear can be invalidated
+        std::shared_ptr<fixie::framebuffer> framebuffer = _state.bound_framebuffer().lock();
+        if (framebuffer == nullptr || framebuffer != _framebuffers.get_object(0).lock())
+        {
+            return;
+        }
+
+        GLbitfield invalidate_mask = 0;
+        if ((mask & GL_DEPTH_BUFFER_BIT) && _state.depth_buffer_state().depth_write_mask())
+        {
+            invalidate_mask |= GL_DEPTH_BUFFER_BIT;
+        }
+
+        const GLuint stencil_bits_mask = (1u << _impl->caps().stencil_bits()) - 1;
+        if ((mask & GL_STENCIL_BUFFER_BIT) && (_state.stencil_buffer_state().stencil_write_mask() & stencil_bits_mask) == stencil_bits_mask)
+        {
+            invalidate_mask |= GL_STENCIL_BUFFER_BIT;
+        }
+
+        if (invalidate_mask == 0)
+        {
+            return;
+        }
+
+        if (_state.scissor_state().scissor_test_enabled())
+        {
+            const rectangle& scissor = _state.scissor_state().scissor();
+            framebuffer->invalidate(invalidate_mask, scissor.x(), scissor.y(), scissor.width(), scissor.height());
+        }
+        else
+        {
+            framebuffer->invalidate(invalidate_mask);
+        }
+    }
+
     void context::flush()
     {
+        submit_texture_rects();
         _impl->flush();
     }
 
+    GLuint context::begin_read_pixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        std::shared_ptr<fixie::framebuffer> framebuffer = _state.bound_framebuffer().lock();
+        if (framebuffer == nullptr)
+        {
+            throw state_error("null framebuffer bound.");
+        }
+
+        pending_read_pixels pending;
+        pending.framebuffer = framebuffer;
+        pending.framebuffer_request = framebuffer->begin_read_pixels(_state.pixel_store_state(), x, y, width, height, format, type);
+
+        GLuint request = ++_next_read_pixels_request;
+        _pending_read_pixels[request] = pending;
+        return request;
+    }
+
+    GLboolean context::end_read_pixels(GLuint request, GLboolean wait, GLvoid* pixels)
+    {
+        auto pending = _pending_read_pixels.find(request);
+        if (pending == end(_pending_read_pixels))
+        {
+            throw invalid_value_error(format("%u is not a pending read pixels request.", request));
+        }
+
+        std::shared_ptr<fixie::framebuffer> framebuffer = pending->second.framebuffer.lock();
+        if (framebuffer == nullptr)
+        {
+            _pending_read_pixels.erase(pending);
+            throw invalid_operation_error(format("the framebuffer of read pixels request %u has been deleted.", request));
+        }
+
+        GLboolean complete;
+        try
+        {
+            complete = framebuffer->end_read_pixels(pending->second.framebuffer_request, wait, pixels);
+        }
+        catch (...)
+        {
+            _pending_read_pixels.erase(pending);
+            throw;
+        }
+
+        if (!complete)
+        {
+            return GL_FALSE;
+        }
+
+        _pending_read_pixels.erase(pending);
+        return GL_TRUE;
+    }
+
     void context::finish()
     {
+        submit_texture_rects();
         _impl->finish();
     }
 
+    void context::end_frame()
+    {
+        // Nothing recorded in this frame may be carried into the next one
+        submit_texture_rects();
+        _impl->flush();
+    }
+
     fixie::log& context::log()
     {
         return _log;
@@ -186,10 +380,142 @@ namespace fixie
         return _log;
     }
 
+    void context::push_debug_group(GLenum source, GLuint id, const std::string& message)
+    {
+        if (_log.group_depth() >= static_cast<size_t>(fixie::log::max_group_depth))
+        {
+            throw stack_overflow_error(format("debug group stack depth cannot exceed %i.", fixie::log::max_group_depth));
+        }
+
+        debug_group group(source, id, message);
+        log_message(group.source(), GL_DEBUG_TYPE_PUSH_GROUP_KHR, group.id(), GL_DEBUG_SEVERITY_NOTIFICATION_KHR, group.message());
+        _log.push_group(group);
+        _impl->push_debug_group(group.source(), group.id(), group.message());
+    }
+
+    void context::pop_debug_group()
+    {
+        if (_log.group_depth() <= 1)
+        {
+            throw stack_underflow_error("cannot pop the default debug group.");
+        }
+
+        debug_group group = _log.top_group();
+        _log.pop_group();
+        _impl->pop_debug_group();
+        log_message(group.source(), GL_DEBUG_TYPE_POP_GROUP_KHR, group.id(), GL_DEBUG_SEVERITY_NOTIFICATION_KHR, group.message());
+    }
+
+    void context::set_object_label(GLenum identifier, GLuint name, const std::string& label)
+    {
+        switch (identifier)
+        {
+        case GL_TEXTURE:
+            {
+                std::shared_ptr<texture> object = textures().get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid texture name.", name));
+                }
+                object->label() = label;
+                _impl->set_texture_label(object->impl(), label);
+            }
+            break;
+
+        case GL_BUFFER_KHR:
+            {
+                std::shared_ptr<buffer> object = buffers().get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid buffer name.", name));
+                }
+                object->label() = label;
+                _impl->set_buffer_label(object->impl(), label);
+            }
+            break;
+
+        case GL_RENDERBUFFER_OES:
+            {
+                std::shared_ptr<renderbuffer> object = _renderbuffers.get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid renderbuffer name.", name));
+                }
+                object->label() = label;
+                _impl->set_renderbuffer_label(object->impl(), label);
+            }
+            break;
+
+        case GL_FRAMEBUFFER_OES:
+            {
+                std::shared_ptr<framebuffer> object = _framebuffers.get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid framebuffer name.", name));
+                }
+                object->label() = label;
+                _impl->set_framebuffer_label(object->impl(), label);
+            }
+            break;
+
+        default:
+            throw invalid_enum_error(format("invalid object identifier, %s.", get_gl_enum_name(identifier).c_str()));
+        }
+    }
+
+    const std::string& context::object_label(GLenum identifier, GLuint name) const
+    {
+        switch (identifier)
+        {
+        case GL_TEXTURE:
+            {
+                std::shared_ptr<const texture> object = textures().get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid texture name.", name));
+                }
+                return object->label();
+            }
+
+        case GL_BUFFER_KHR:
+            {
+                std::shared_ptr<const buffer> object = buffers().get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid buffer name.", name));
+                }
+                return object->label();
+            }
+
+        case GL_RENDERBUFFER_OES:
+            {
+                std::shared_ptr<const renderbuffer> object = _renderbuffers.get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid renderbuffer name.", name));
+                }
+                return object->label();
+            }
+
+        case GL_FRAMEBUFFER_OES:
+            {
+                std::shared_ptr<const framebuffer> object = _framebuffers.get_object(name).lock();
+                if (!object)
+                {
+                    throw invalid_value_error(format("%u is not a valid framebuffer name.", name));
+                }
+                return object->label();
+            }
+
+        default:
+            throw invalid_enum_error(format("invalid object identifier, %s.", get_gl_enum_name(identifier).c_str()));
+        }
+    }
+
     std::unordered_set<std::string> context::initialize_extensions(const fixie::caps& caps)
     {
         std::unordered_set<std::string> extension_set;
-        auto insert_if = [&](GLboolean cond, const std::string& extension){ extension_set.insert(std::move(extension)); };
+        auto insert_if = [&](GLboolean cond, const std::string& extension){ if (cond) { extension_set.insert(extension); } };
 
         insert_if(GL_TRUE, "GL_OES_matrix_get");
         insert_if(caps.supports_framebuffer_objects(), "GL_OES_framebuffer_object");
@@ -200,6 +526,23 @@ namespace fixie
         insert_if(caps.supports_stencil4(), "GL_OES_stencil4");
         insert_if(caps.supports_stencil8(), "GL_OES_stencil8");
         insert_if(caps.supports_vertex_array_objects(), "GL_OES_vertex_array_object");
+        insert_if(GL_TRUE, "GL_OES_texture_env_crossbar");
+        insert_if(GL_TRUE, "GL_OES_point_size_array");
+        insert_if(GL_TRUE, "GL_OES_point_sprite");
+        insert_if(GL_TRUE, "GL_OES_draw_texture");
+        insert_if(caps.supports_compressed_format(GL_PALETTE4_RGB8_OES), "GL_OES_compressed_paletted_texture");
+        insert_if(caps.supports_compressed_format(GL_ETC1_RGB8_OES), "GL_OES_compressed_ETC1_RGB8_texture");
+        insert_if(caps.max_palette_matrices() > 0, "GL_OES_matrix_palette");
+        insert_if(caps.supports_instanced_drawing(), "GL_FIXIE_draw_instanced");
+        insert_if(GL_TRUE, "GL_FIXIE_read_pixels_async");
+        insert_if(GL_TRUE, "GL_FIXIE_end_frame");
+        insert_if(GL_TRUE, "GL_FIXIE_pack_reverse_row_order");
+        insert_if(GL_TRUE, "GL_FIXIE_lighting_hint");
+        insert_if(GL_TRUE, "GL_FIXIE_clear_invalidate_hint");
+        insert_if(GL_TRUE, "GL_EXT_discard_framebuffer");
+        insert_if(caps.max_samples() > 0, "GL_EXT_multisampled_render_to_texture");
+        insert_if(GL_TRUE, "GL_KHR_debug");
+        insert_if(caps.supports_timer_queries(), "GL_EXT_disjoint_timer_query");
 
         return extension_set;
     }
@@ -260,6 +603,7 @@ namespace fixie
         if (all_contexts.size() == 0)
         {
             current_context_impl = nullptr;
+            shutdown_worker_pool();
         }
     }
 
@@ -269,7 +613,33 @@ namespace fixie
         return iter != end(all_contexts) ? *iter : nullptr;
     }
 
+    static void submit_deferred_texture_rects(std::shared_ptr<context> ctx)
+    {
+        // Failures of an implicitly submitted batch are reported as belonging to the batch, not to the entry point
+        // that happened to end it
+        try
+        {
+            ctx->submit_texture_rects();
+        }
+        catch (const gl_error& e)
+        {
+            log_gl_error(gl_error(e.error_code(), e.error_code_description(), format("deferred draw texture batch: %s", e.error_msg().c_str())));
+        }
+        catch (const context_error& e)
+        {
+            log_context_error(context_error(format("deferred draw texture batch: %s", e.error_msg().c_str())));
+        }
+    }
+
     std::shared_ptr<context> get_current_context()
+    {
+        // Any entry point other than a draw texture call ends the current batch of texture rectangles
+        std::shared_ptr<context> current_locked_context = get_current_context_without_submit();
+        submit_deferred_texture_rects(current_locked_context);
+        return current_locked_context;
+    }
+
+    std::shared_ptr<context> get_current_context_without_submit()
     {
         if (all_contexts.size() == 0)
         {
@@ -288,6 +658,12 @@ namespace fixie
 
     void set_current_context(std::shared_ptr<context> ctx)
     {
+        std::shared_ptr<context> previous_context = current_context.lock();
+        if (previous_context)
+        {
+            submit_deferred_texture_rects(previous_context);
+        }
+
         auto iter = all_contexts.find(ctx);
         if (iter != end(all_contexts))
         {
@@ -304,6 +680,40 @@ namespace fixie
         current_context_impl = nullptr;
         current_context = std::weak_ptr<context>();
         all_contexts.clear();
+        shutdown_worker_pool();
+
+        if (!default_trace_path().empty())
+        {
+            dump_trace(default_trace_path());
+        }
+    }
+
+    GLboolean is_message_enabled(GLenum source, GLenum type, GLuint id, GLenum severity)
+    {
+        std::shared_ptr<context> current_locked_context = current_context.lock();
+        return current_locked_context ? current_locked_context->log().message_enabled(source, type, id, severity) : GL_TRUE;
+    }
+
+    static void dispatch_message(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& msg)
+    {
+        std::shared_ptr<context> current_locked_context = current_context.lock();
+        if (current_locked_context)
+        {
+            fixie::log& log = current_locked_context->log();
+            if (log.callback())
+            {
+                log.callback()(source, type, id, severity, static_cast<GLsizei>(msg.length()), msg.c_str(), log.user_param());
+            }
+            else
+            {
+                log.insert_message(debug_message(source, type, id, severity, msg));
+            }
+        }
+        else
+        {
+            debug_msg_callback msg_callback = get_default_debug_msg_callback();
+            msg_callback(source, type, id, severity, static_cast<GLsizei>(msg.length()), msg.c_str(), nullptr);
+        }
     }
 
     void log_gl_error(const gl_error& error)
@@ -314,35 +724,23 @@ namespace fixie
             current_locked_context->state().error() = error.error_code();
         }
 
-        log_message(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, error.error_code(), GL_DEBUG_SEVERITY_HIGH_KHR,
-                    format("%s: %s", error.error_code_description().c_str(), error.error_msg().c_str()));
+        if (is_message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, error.error_code(), GL_DEBUG_SEVERITY_HIGH_KHR))
+        {
+            dispatch_message(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, error.error_code(), GL_DEBUG_SEVERITY_HIGH_KHR,
+                             format("%s: %s", error.error_code_description().c_str(), error.error_msg().c_str()));
+        }
     }
 
     void log_context_error(const context_error& error)
     {
-        log_message(GL_DEBUG_SOURCE_THIRD_PARTY_KHR, GL_DEBUG_TYPE_ERROR_KHR, GL_DEBUG_SEVERITY_HIGH_KHR, 0, error.error_msg());
+        log_message(GL_DEBUG_SOURCE_THIRD_PARTY_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR, error.error_msg());
     }
 
     void log_message(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& msg)
     {
-        debug_msg_callback msg_callback = nullptr;
-        GLvoid* user_param = nullptr;
-
-        std::shared_ptr<context> current_locked_context = current_context.lock();
-        if (current_locked_context)
-        {
-            msg_callback = current_locked_context->log().callback();
-            user_param = current_locked_context->log().user_param();
-        }
-        else
-        {
-            msg_callback = get_default_debug_msg_callback();
-            user_param = nullptr;
-        }
-
-        if (msg_callback)
+        if (is_message_enabled(source, type, id, severity))
         {
-            msg_callback(source, type, id, severity, static_cast<GLsizei>(msg.length()), msg.c_str(), user_param);
+            dispatch_message(source, type, id, severity, msg);
         }
     }
 }
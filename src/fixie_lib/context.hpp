@@ -2,15 +2,18 @@
 #define _FIXIE_LIB_FIXIE_CONTEXT_HPP_
 
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "fixie_lib/exceptions.hpp"
 #include "fixie_lib/state.hpp"
 #include "fixie_lib/caps.hpp"
 #include "fixie_lib/log.hpp"
+#include "fixie_lib/statistics.hpp"
 #include "fixie_lib/noncopyable.hpp"
 #include "fixie_lib/handle_manager.hpp"
 #include "fixie_lib/resource_manager.hpp"
+#include "fixie_lib/texture_rect_batch.hpp"
 
 namespace fixie
 {
@@ -27,14 +30,30 @@ namespace fixie
         virtual std::unique_ptr<framebuffer_impl> create_default_framebuffer() = 0;
         virtual std::unique_ptr<framebuffer_impl> create_framebuffer() = 0;
         virtual std::unique_ptr<buffer_impl> create_buffer() = 0;
+        virtual std::unique_ptr<query_impl> create_query() = 0;
 
         virtual void draw_arrays(const state& state, GLenum mode, GLint first, GLsizei count) = 0;
         virtual void draw_elements(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) = 0;
+        virtual void draw_arrays_instanced(const state& state, GLenum mode, GLint first, GLsizei count, GLsizei instance_count) = 0;
+        virtual void draw_elements_instanced(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count) = 0;
+        virtual void draw_texture_rects(const state& state, const texture_rect_batch& rects) = 0;
 
         virtual void clear(const state& state, GLbitfield mask) = 0;
 
         virtual void flush() = 0;
         virtual void finish() = 0;
+
+        virtual void push_debug_group(GLenum source, GLuint id, const std::string& message) = 0;
+        virtual void pop_debug_group() = 0;
+
+        virtual void set_texture_label(std::weak_ptr<const texture_impl> texture, const std::string& label) = 0;
+        virtual void set_buffer_label(std::weak_ptr<const buffer_impl> buffer, const std::string& label) = 0;
+        virtual void set_renderbuffer_label(std::weak_ptr<const renderbuffer_impl> renderbuffer, const std::string& label) = 0;
+        virtual void set_framebuffer_label(std::weak_ptr<const framebuffer_impl> framebuffer, const std::string& label) = 0;
+
+        virtual GLuint64 timestamp() = 0;
+
+        virtual fixie::statistics& statistics() = 0;
     };
 
     class context : public noncopyable
@@ -68,21 +87,40 @@ namespace fixie
         const handle_manager<GLuint, framebuffer>& framebuffers() const;
         handle_manager<GLuint, framebuffer>& framebuffers();
 
+        GLuint create_query();
+        const handle_manager<GLuint, query>& queries() const;
+        handle_manager<GLuint, query>& queries();
+
         GLuint create_vertex_array();
         const handle_manager<GLuint, vertex_array>& vertex_arrays() const;
         handle_manager<GLuint, vertex_array>& vertex_arrays();
 
         void draw_arrays(GLenum mode, GLint first, GLsizei count);
         void draw_elements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+        void draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+        void draw_elements_instanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count);
+
+        void draw_texture(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height);
+        void submit_texture_rects();
 
         void clear(GLbitfield mask);
 
+        GLuint begin_read_pixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type);
+        GLboolean end_read_pixels(GLuint request, GLboolean wait, GLvoid* pixels);
+
         void flush();
         void finish();
+        void end_frame();
 
         fixie::log& log();
         const fixie::log& log() const;
 
+        void push_debug_group(GLenum source, GLuint id, const std::string& message);
+        void pop_debug_group();
+
+        void set_object_label(GLenum identifier, GLuint name, const std::string& label);
+        const std::string& object_label(GLenum identifier, GLuint name) const;
+
         const std::shared_ptr<const context_impl> impl() const;
         std::shared_ptr<context_impl> impl();
 
@@ -90,12 +128,15 @@ namespace fixie
         static std::unordered_set<std::string> initialize_extensions(const fixie::caps& caps);
         static std::string build_extension_string(const std::unordered_set<std::string>& extensions);
 
+        void invalidate_before_clear(GLbitfield mask);
+
         std::shared_ptr<context_impl> _impl;
         fixie::state _state;
         std::shared_ptr<resource_manager> _resource_manager;
         handle_manager<GLuint, renderbuffer> _renderbuffers;
         handle_manager<GLuint, framebuffer> _framebuffers;
         handle_manager<GLuint, vertex_array> _vertex_arrays;
+        handle_manager<GLuint, query> _queries;
 
         std::string _version_string;
         std::string _renderer_string;
@@ -103,6 +144,16 @@ namespace fixie
         std::unordered_set<std::string> _extensions;
         std::string _extension_string;
 
+        texture_rect_batch _texture_rects;
+
+        struct pending_read_pixels
+        {
+            std::weak_ptr<fixie::framebuffer> framebuffer;
+            GLuint framebuffer_request;
+        };
+        std::unordered_map<GLuint, pending_read_pixels> _pending_read_pixels;
+        GLuint _next_read_pixels_request;
+
         fixie::log _log;
     };
 
@@ -112,12 +163,14 @@ namespace fixie
     void destroy_context(std::shared_ptr<context> ctx);
 
     std::shared_ptr<context> get_current_context();
+    std::shared_ptr<context> get_current_context_without_submit();
     void set_current_context(std::shared_ptr<context> ctx);
 
     void terminate();
 
     void log_gl_error(const gl_error& error);
     void log_context_error(const context_error& error);
+    GLboolean is_message_enabled(GLenum source, GLenum type, GLuint id, GLenum severity);
     void log_message(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& msg);
 }
 
@@ -1,11 +1,13 @@
 #include "fixie_lib/desktop_gl_impl/buffer.hpp"
+#include "fixie_lib/tracer.hpp"
 
 namespace fixie
 {
     namespace desktop_gl_impl
     {
-        buffer::buffer(std::shared_ptr<const gl_functions> functions)
+        buffer::buffer(std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics)
             : _functions(functions)
+            , _statistics(statistics)
             , _id(0)
             , _type(0)
         {
@@ -29,14 +31,23 @@ namespace fixie
 
         void buffer::set_data(GLsizeiptr size, const GLvoid* data, GLenum usage)
         {
+            FIXIE_TRACE_SCOPE("upload", "buffer::set_data");
+
             gl_call(_functions, bind_buffer, _type, _id);
             gl_call(_functions, buffer_data, _type, size, data, usage);
+            if (data != nullptr)
+            {
+                _statistics->buffer_upload_bytes() += size;
+            }
         }
 
         void buffer::set_sub_data(GLintptr offset, GLsizeiptr size, const GLvoid* data)
         {
+            FIXIE_TRACE_SCOPE("upload", "buffer::set_sub_data");
+
             gl_call(_functions, bind_buffer, _type, _id);
             gl_call(_functions, buffer_sub_data, _type, offset, size, data);
+            _statistics->buffer_upload_bytes() += size;
         }
     }
 }
@@ -2,6 +2,7 @@
 #define _FIXIE_LIB_DESKTOP_GL_BUFFER_HPP_
 
 #include "fixie_lib/buffer.hpp"
+#include "fixie_lib/statistics.hpp"
 #include "fixie_lib/desktop_gl_impl/gl_functions.hpp"
 
 namespace fixie
@@ -11,7 +12,7 @@ namespace fixie
         class buffer : public fixie::buffer_impl
         {
         public:
-            explicit buffer(std::shared_ptr<const gl_functions> functions);
+            buffer(std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics);
             virtual ~buffer();
 
             GLuint id() const;
@@ -22,6 +23,7 @@ namespace fixie
 
         private:
             std::shared_ptr<const gl_functions> _functions;
+            std::shared_ptr<fixie::statistics> _statistics;
             GLuint _id;
             GLenum _type;
         };
@@ -3,10 +3,13 @@
 #include "fixie_lib/desktop_gl_impl/renderbuffer.hpp"
 #include "fixie_lib/desktop_gl_impl/framebuffer.hpp"
 #include "fixie_lib/desktop_gl_impl/buffer.hpp"
+#include "fixie_lib/desktop_gl_impl/query.hpp"
 #include "fixie_lib/desktop_gl_impl/exceptions.hpp"
 #include "fixie_lib/util.hpp"
+#include "fixie_lib/tracer.hpp"
 
 #include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
 
 #include <assert.h>
 
@@ -15,10 +18,25 @@ namespace fixie
     namespace desktop_gl_impl
     {
         #define GL_FRAMEBUFFER 0x8D40
+        #define GL_RENDERBUFFER 0x8D41
+        #define GL_CLIP_DISTANCE0 0x3000
+        #define GL_PROGRAM_POINT_SIZE 0x8642
+        #define GL_POINT_SPRITE 0x8861
+        #define GL_CONTEXT_PROFILE_MASK 0x9126
+        #define GL_CONTEXT_COMPATIBILITY_PROFILE_BIT 0x00000002
+        #define GL_STREAM_DRAW 0x88E0
+        #define GL_TIMESTAMP 0x8E28
+        #define GL_COMPRESSED_RGB8_ETC2 0x9274
 
         void FIXIE_APIENTRY debug_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
                                            const GLchar* message, GLvoid* user_aram)
         {
+            // Group messages are already reported by the front end when the group is pushed or popped
+            if (type == GL_DEBUG_TYPE_PUSH_GROUP_KHR || type == GL_DEBUG_TYPE_POP_GROUP_KHR)
+            {
+                return;
+            }
+
             log_message(source, type, id, severity, std::string(message));
         }
 
@@ -39,27 +57,43 @@ namespace fixie
             , _version(initialize_version(_functions))
             , _extensions(intialize_extensions(_functions, _version))
             , _caps(initialize_caps(_functions, _version, _extensions))
-            , _shader_cache(_functions)
+            , _supports_debug((_version >= gl_4_3 || _extensions.find("GL_KHR_debug") != end(_extensions)) ? GL_TRUE : GL_FALSE)
+            , _requires_point_sprite_enable(initialize_requires_point_sprite_enable(_functions, _version))
+            , _supports_instanced_arrays((_version >= gl_3_3 || _version >= gl_es_3_0) ? GL_TRUE : GL_FALSE)
+            , _native_etc1_format(initialize_native_etc1_format(_version, _extensions))
+            , _supports_async_read_pixels((_version >= gl_3_2 || _version >= gl_es_3_0) ? GL_TRUE : GL_FALSE)
+            , _supports_framebuffer_blit((_version >= gl_3_0 || _version >= gl_es_3_0 || _extensions.find("GL_ARB_framebuffer_object") != end(_extensions)) ? GL_TRUE : GL_FALSE)
+            , _supports_framebuffer_invalidate((_version >= gl_4_3 || _version >= gl_es_3_0 || _extensions.find("GL_ARB_invalidate_subdata") != end(_extensions)) ? GL_TRUE : GL_FALSE)
+            , _statistics(std::make_shared<fixie::statistics>())
+            , _shader_cache(_functions, _statistics)
             , _cur_viewport_state(default_viewport_state())
             , _cur_color_buffer_state(default_color_buffer_state())
             , _cur_depth_buffer_state(default_depth_buffer_state())
             , _cur_stencil_buffer_state(default_stencil_buffer_state())
-            , _cur_point_state(default_point_state())
+            , _cur_point_state(default_point_state(_caps))
             , _cur_line_state(default_line_state())
             , _cur_polygon_state(default_polygon_state())
             , _cur_multisample_state(default_multisample_state())
+            , _cur_clip_planes_enabled(_caps.max_clip_planes(), GL_FALSE)
             , _vao(0)
+            , _texture_rect_buffer(0)
         {
             const GLubyte* gl_renderer_string = gl_call(_functions, get_string, GL_RENDERER);
             _renderer_string = format("%s OpenGL %s", reinterpret_cast<const char*>(gl_renderer_string), _version.str().c_str());
 
-            if (_version >= gl_4_3 || _extensions.find("GL_KHR_debug") != end(_extensions))
+            if (_supports_debug)
             {
                 gl_call(_functions, enable, GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR);
                 gl_call(_functions, debug_message_control, GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_MEDIUM_KHR, 0, nullptr, GL_TRUE);
                 gl_call(_functions, debug_message_callback, debug_callback, this);
             }
 
+            if (_version.type() == open_gl)
+            {
+                // Point sizes always come from gl_PointSize in the generated shaders
+                gl_call(_functions, enable, GL_PROGRAM_POINT_SIZE);
+            }
+
             if (_version >= gl_3_0 || _version >= gl_es_3_0 || _extensions.find("GL_ARB_vertex_array_object") != end(_extensions))
             {
                 // need to generate a vao to use so 0 it not bound
@@ -70,6 +104,10 @@ namespace fixie
 
         context::~context()
         {
+            if (_texture_rect_buffer != 0)
+            {
+                gl_call_nothrow(_functions, delete_buffers, 1, &_texture_rect_buffer);
+            }
             if (_vao != 0)
             {
                 gl_call_nothrow(_functions, delete_vertex_arrays, 1, &_vao);
@@ -99,7 +137,7 @@ namespace fixie
 
         std::unique_ptr<texture_impl> context::create_texture()
         {
-            return std::unique_ptr<texture_impl>(new texture(_functions));
+            return std::unique_ptr<texture_impl>(new texture(_functions, _statistics, _native_etc1_format, _supports_framebuffer_blit));
         }
 
         std::unique_ptr<renderbuffer_impl> context::create_renderbuffer()
@@ -109,31 +147,129 @@ namespace fixie
 
         std::unique_ptr<framebuffer_impl> context::create_default_framebuffer()
         {
-            return std::unique_ptr<framebuffer_impl>(new default_framebuffer(_functions));
+            return std::unique_ptr<framebuffer_impl>(new default_framebuffer(_functions, _supports_async_read_pixels, _supports_framebuffer_invalidate));
         }
 
         std::unique_ptr<framebuffer_impl> context::create_framebuffer()
         {
-            return std::unique_ptr<framebuffer_impl>(new framebuffer(_functions));
+            return std::unique_ptr<framebuffer_impl>(new framebuffer(_functions, _supports_async_read_pixels, _supports_framebuffer_invalidate, _supports_framebuffer_blit));
         }
 
         std::unique_ptr<buffer_impl> context::create_buffer()
         {
-            return std::unique_ptr<buffer_impl>(new buffer(_functions));
+            return std::unique_ptr<buffer_impl>(new buffer(_functions, _statistics));
+        }
+
+        std::unique_ptr<query_impl> context::create_query()
+        {
+            return std::unique_ptr<query_impl>(new query(_functions));
         }
 
         void context::draw_arrays(const state& state, GLenum mode, GLint first, GLsizei count)
         {
-            sync_draw_state(state);
+            sync_draw_state(state, mode, GL_FALSE, GL_FALSE);
 
             gl_call(_functions, draw_arrays, mode, first, count);
+            _statistics->draw_calls()++;
         }
 
         void context::draw_elements(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
         {
-            sync_draw_state(state);
+            sync_draw_state(state, mode, GL_FALSE, GL_FALSE);
 
             gl_call(_functions, draw_elements, mode, count, type, indices);
+            _statistics->draw_calls()++;
+        }
+
+        void context::draw_arrays_instanced(const state& state, GLenum mode, GLint first, GLsizei count, GLsizei instance_count)
+        {
+            sync_draw_state(state, mode, GL_TRUE, GL_FALSE);
+
+            gl_call(_functions, draw_arrays_instanced, mode, first, count, instance_count);
+            _statistics->draw_calls()++;
+        }
+
+        void context::draw_elements_instanced(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count)
+        {
+            sync_draw_state(state, mode, GL_TRUE, GL_FALSE);
+
+            gl_call(_functions, draw_elements_instanced, mode, count, type, indices, instance_count);
+            _statistics->draw_calls()++;
+        }
+
+        void context::draw_texture_rects(const state& state, const texture_rect_batch& rects)
+        {
+            std::shared_ptr<shader> shader = sync_draw_state(state, GL_TRIANGLE_STRIP, GL_FALSE, GL_TRUE);
+
+            std::vector<GLint> locations;
+            locations.push_back(shader->texture_rect_attribute_location());
+            locations.push_back(shader->texture_rect_depth_attribute_location());
+            for_each_n<size_t>(0U, rects.texture_unit_count(), [&](size_t i){ locations.push_back(shader->texcoord_attribute_location(i)); });
+
+            std::vector<GLint> sizes(locations.size(), 4);
+            sizes[1] = 1;
+
+            std::vector<size_t> offsets;
+            offsets.push_back(rects.rect_offset());
+            offsets.push_back(rects.depth_offset());
+            for_each_n<size_t>(0U, rects.texture_unit_count(), [&](size_t i){ offsets.push_back(rects.texcoord_offset(i)); });
+
+            if (_supports_instanced_arrays)
+            {
+                if (_texture_rect_buffer == 0)
+                {
+                    gl_call(_functions, gen_buffers, 1, &_texture_rect_buffer);
+                }
+                gl_call(_functions, bind_buffer, GL_ARRAY_BUFFER, _texture_rect_buffer);
+                gl_call(_functions, buffer_data, GL_ARRAY_BUFFER, rects.stride() * rects.size(), rects.data(), GL_STREAM_DRAW);
+
+                for_each_n<size_t>(0U, locations.size(), [&](size_t i){ set_texture_rect_attribute(locations[i], sizes[i], rects.stride(), offsets[i]); });
+
+                gl_call(_functions, draw_arrays_instanced, GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(rects.size()));
+                _statistics->draw_calls()++;
+
+                for_each_n<size_t>(0U, locations.size(), [&](size_t i){ if (locations[i] != -1) { gl_call(_functions, vertex_attrib_divisor, locations[i], 0); } });
+            }
+            else
+            {
+                for (size_t rect = 0; rect < rects.size(); rect++)
+                {
+                    const GLfloat* rect_data = rects.data() + rect * (rects.stride() / sizeof(GLfloat));
+                    for_each_n<size_t>(0U, locations.size(), [&](size_t i){ set_texture_rect_generic_attribute(locations[i], sizes[i], rect_data + offsets[i] / sizeof(GLfloat)); });
+
+                    gl_call(_functions, draw_arrays, GL_TRIANGLE_STRIP, 0, 4);
+                    _statistics->draw_calls()++;
+                }
+            }
+
+            // The rectangle attributes replaced whatever the vertex array had specified at these locations
+            for_each_n<size_t>(0U, locations.size(), [&](size_t i){ _cur_vertex_attributes.erase(locations[i]); });
+        }
+
+        void context::set_texture_rect_attribute(GLint location, GLint size, GLsizei stride, size_t offset)
+        {
+            if (location != -1)
+            {
+                gl_call(_functions, enable_vertex_attrib_array, location);
+                gl_call(_functions, vertex_attrib_pointer, location, size, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(offset));
+                gl_call(_functions, vertex_attrib_divisor, location, 1);
+            }
+        }
+
+        void context::set_texture_rect_generic_attribute(GLint location, GLint size, const GLfloat* values)
+        {
+            if (location != -1)
+            {
+                gl_call(_functions, disable_vertex_attrib_array, location);
+                if (size == 1)
+                {
+                    gl_call(_functions, vertex_attrib_1f, location, values[0]);
+                }
+                else
+                {
+                    gl_call(_functions, vertex_attrib_4f, location, values[0], values[1], values[2], values[3]);
+                }
+            }
         }
 
         void context::clear(const state& state, GLbitfield mask)
@@ -157,15 +293,87 @@ namespace fixie
             gl_call(_functions, finish);
         }
 
+        void context::push_debug_group(GLenum source, GLuint id, const std::string& message)
+        {
+            if (_supports_debug)
+            {
+                gl_call(_functions, push_debug_group, source, id, static_cast<GLsizei>(message.length()), message.c_str());
+            }
+        }
+
+        void context::pop_debug_group()
+        {
+            if (_supports_debug)
+            {
+                gl_call(_functions, pop_debug_group);
+            }
+        }
+
+        void context::set_texture_label(std::weak_ptr<const texture_impl> texture, const std::string& label)
+        {
+            std::shared_ptr<const desktop_gl_impl::texture> desktop_texture = std::dynamic_pointer_cast<const desktop_gl_impl::texture>(texture.lock());
+            if (desktop_texture)
+            {
+                set_object_label(GL_TEXTURE, desktop_texture->id(), label);
+            }
+        }
+
+        void context::set_buffer_label(std::weak_ptr<const buffer_impl> buffer, const std::string& label)
+        {
+            std::shared_ptr<const desktop_gl_impl::buffer> desktop_buffer = std::dynamic_pointer_cast<const desktop_gl_impl::buffer>(buffer.lock());
+            if (desktop_buffer)
+            {
+                set_object_label(GL_BUFFER_KHR, desktop_buffer->id(), label);
+            }
+        }
+
+        void context::set_renderbuffer_label(std::weak_ptr<const renderbuffer_impl> renderbuffer, const std::string& label)
+        {
+            std::shared_ptr<const desktop_gl_impl::renderbuffer> desktop_renderbuffer = std::dynamic_pointer_cast<const desktop_gl_impl::renderbuffer>(renderbuffer.lock());
+            if (desktop_renderbuffer)
+            {
+                set_object_label(GL_RENDERBUFFER, desktop_renderbuffer->id(), label);
+            }
+        }
+
+        void context::set_framebuffer_label(std::weak_ptr<const framebuffer_impl> framebuffer, const std::string& label)
+        {
+            std::shared_ptr<const desktop_gl_impl::framebuffer> desktop_framebuffer = std::dynamic_pointer_cast<const desktop_gl_impl::framebuffer>(framebuffer.lock());
+            if (desktop_framebuffer)
+            {
+                set_object_label(GL_FRAMEBUFFER, desktop_framebuffer->id(), label);
+            }
+        }
+
+        GLuint64 context::timestamp()
+        {
+            GLint64 timestamp = 0;
+            gl_call(_functions, get_integer64_v, GL_TIMESTAMP, &timestamp);
+            return static_cast<GLuint64>(timestamp);
+        }
+
+        fixie::statistics& context::statistics()
+        {
+            return *_statistics;
+        }
+
+        void context::set_object_label(GLenum identifier, GLuint id, const std::string& label)
+        {
+            if (_supports_debug && id != 0)
+            {
+                gl_call(_functions, object_label, identifier, id, static_cast<GLsizei>(label.length()), label.c_str());
+            }
+        }
+
         void context::sync_viewport_state(const viewport_state& state)
         {
-            if (_cur_viewport_state.viewport() != state.viewport())
+            if (track_state_change(_cur_viewport_state.viewport() != state.viewport()))
             {
                 gl_call(_functions, viewport, state.viewport().x(), state.viewport().y(), state.viewport().width(), state.viewport().height());
                 _cur_viewport_state.viewport() = state.viewport();
             }
 
-            if (_cur_viewport_state.depth_range() != state.depth_range())
+            if (track_state_change(_cur_viewport_state.depth_range() != state.depth_range()))
             {
                 gl_call(_functions, depth_range_f, state.depth_range().near(), state.depth_range().far());
                 _cur_viewport_state.depth_range() = state.depth_range();
@@ -174,13 +382,13 @@ namespace fixie
 
         void context::sync_scissor_state(const scissor_state& state)
         {
-            if (_cur_scissor_state.scissor_test_enabled() != state.scissor_test_enabled())
+            if (track_state_change(_cur_scissor_state.scissor_test_enabled() != state.scissor_test_enabled()))
             {
                 enable_gl_state(_functions, GL_SCISSOR_TEST, state.scissor_test_enabled());
                 _cur_scissor_state.scissor_test_enabled() = state.scissor_test_enabled();
             }
 
-            if (_cur_scissor_state.scissor() != state.scissor())
+            if (track_state_change(_cur_scissor_state.scissor() != state.scissor()))
             {
                 gl_call(_functions, scissor, state.scissor().x(), state.scissor().y(), state.scissor().width(), state.scissor().height());
                 _cur_scissor_state.scissor() = state.scissor();
@@ -189,30 +397,16 @@ namespace fixie
 
         void context::sync_color_buffer_state(const color_buffer_state& state)
         {
-            if (_cur_color_buffer_state.alpha_test_enabled() != state.alpha_test_enabled())
-            {
-                enable_gl_state(_functions, GL_ALPHA_TEST, state.alpha_test_enabled());
-                _cur_color_buffer_state.alpha_test_enabled() = state.alpha_test_enabled();
-            }
-
-            if (_cur_color_buffer_state.alpha_test_func() != state.alpha_test_func() ||
-                _cur_color_buffer_state.alpha_test_ref() != state.alpha_test_ref())
-            {
-                gl_call(_functions, alpha_func, state.alpha_test_func(), state.alpha_test_ref());
-                _cur_color_buffer_state.alpha_test_func() = state.alpha_test_func();
-                _cur_color_buffer_state.alpha_test_ref() = state.alpha_test_ref();
-            }
-
-            if (_cur_color_buffer_state.blend_enabled() != state.blend_enabled())
+            if (track_state_change(_cur_color_buffer_state.blend_enabled() != state.blend_enabled()))
             {
                 enable_gl_state(_functions, GL_BLEND, state.blend_enabled());
                 _cur_color_buffer_state.blend_enabled() = state.blend_enabled();
             }
 
-            if (_cur_color_buffer_state.blend_src_rgb_func() != state.blend_src_rgb_func() ||
-                _cur_color_buffer_state.blend_dst_rgb_func() != state.blend_dst_rgb_func() ||
-                _cur_color_buffer_state.blend_src_alpha_func() != state.blend_src_alpha_func() ||
-                _cur_color_buffer_state.blend_dst_alpha_func() != state.blend_dst_alpha_func())
+            if (track_state_change(_cur_color_buffer_state.blend_src_rgb_func() != state.blend_src_rgb_func() ||
+                                   _cur_color_buffer_state.blend_dst_rgb_func() != state.blend_dst_rgb_func() ||
+                                   _cur_color_buffer_state.blend_src_alpha_func() != state.blend_src_alpha_func() ||
+                                   _cur_color_buffer_state.blend_dst_alpha_func() != state.blend_dst_alpha_func()))
             {
                 if (state.blend_src_rgb_func() == state.blend_src_alpha_func() &&
                     state.blend_dst_rgb_func() == state.blend_dst_alpha_func())
@@ -230,25 +424,25 @@ namespace fixie
                 _cur_color_buffer_state.blend_dst_alpha_func() = state.blend_dst_alpha_func();
             }
 
-            if (_cur_color_buffer_state.dither_enabled() != state.dither_enabled())
+            if (track_state_change(_cur_color_buffer_state.dither_enabled() != state.dither_enabled()))
             {
                 enable_gl_state(_functions, GL_DITHER, state.dither_enabled());
                 _cur_color_buffer_state.dither_enabled() = state.dither_enabled();
             }
 
-            if (_cur_color_buffer_state.color_logic_op_enabled() != state.color_logic_op_enabled())
+            if (track_state_change(_cur_color_buffer_state.color_logic_op_enabled() != state.color_logic_op_enabled()))
             {
                 enable_gl_state(_functions, GL_COLOR_LOGIC_OP, state.color_logic_op_enabled());
                 _cur_color_buffer_state.color_logic_op_enabled() = state.color_logic_op_enabled();
             }
 
-            if (_cur_color_buffer_state.color_logic_op_func() != state.color_logic_op_func())
+            if (track_state_change(_cur_color_buffer_state.color_logic_op_func() != state.color_logic_op_func()))
             {
                 gl_call(_functions, logic_op, state.color_logic_op_func());
                 _cur_color_buffer_state.color_logic_op_func() = state.color_logic_op_func();
             }
 
-            if (_cur_color_buffer_state.clear_color() != state.clear_color())
+            if (track_state_change(_cur_color_buffer_state.clear_color() != state.clear_color()))
             {
                 gl_call(_functions, clear_color, state.clear_color().r(), state.clear_color().g(), state.clear_color().b(), state.clear_color().a());
                 _cur_color_buffer_state.clear_color() = state.clear_color();
@@ -257,25 +451,25 @@ namespace fixie
 
         void context::sync_depth_buffer_state(const depth_buffer_state& state)
         {
-            if (_cur_depth_buffer_state.depth_test_enabled() != state.depth_test_enabled())
+            if (track_state_change(_cur_depth_buffer_state.depth_test_enabled() != state.depth_test_enabled()))
             {
                 enable_gl_state(_functions, GL_DEPTH_TEST, state.depth_test_enabled());
                 _cur_depth_buffer_state.depth_test_enabled() = state.depth_test_enabled();
             }
 
-            if (_cur_depth_buffer_state.depth_func() != state.depth_func())
+            if (track_state_change(_cur_depth_buffer_state.depth_func() != state.depth_func()))
             {
                 gl_call(_functions, depth_func, state.depth_func());
                 _cur_depth_buffer_state.depth_func() = state.depth_func();
             }
 
-            if (_cur_depth_buffer_state.depth_write_mask() != state.depth_write_mask())
+            if (track_state_change(_cur_depth_buffer_state.depth_write_mask() != state.depth_write_mask()))
             {
                 gl_call(_functions, depth_mask, state.depth_write_mask());
                 _cur_depth_buffer_state.depth_write_mask() = state.depth_write_mask();
             }
 
-            if (_cur_depth_buffer_state.clear_depth() != state.clear_depth())
+            if (track_state_change(_cur_depth_buffer_state.clear_depth() != state.clear_depth()))
             {
                 gl_call(_functions, clear_depthf, state.clear_depth());
                 _cur_depth_buffer_state.clear_depth() = state.clear_depth();
@@ -284,15 +478,15 @@ namespace fixie
 
         void context::sync_stencil_buffer_state(const stencil_buffer_state& state)
         {
-            if (_cur_stencil_buffer_state.stencil_test_enabled() != state.stencil_test_enabled())
+            if (track_state_change(_cur_stencil_buffer_state.stencil_test_enabled() != state.stencil_test_enabled()))
             {
                 enable_gl_state(_functions, GL_STENCIL_TEST, state.stencil_test_enabled());
                 _cur_stencil_buffer_state.stencil_test_enabled() = state.stencil_test_enabled();
             }
 
-            if (_cur_stencil_buffer_state.stencil_func() != state.stencil_func() ||
-                _cur_stencil_buffer_state.stencil_ref() != state.stencil_ref() ||
-                _cur_stencil_buffer_state.stencil_read_mask() != state.stencil_read_mask())
+            if (track_state_change(_cur_stencil_buffer_state.stencil_func() != state.stencil_func() ||
+                                   _cur_stencil_buffer_state.stencil_ref() != state.stencil_ref() ||
+                                   _cur_stencil_buffer_state.stencil_read_mask() != state.stencil_read_mask()))
             {
                 gl_call(_functions, stencil_func, state.stencil_func(), state.stencil_ref(), state.stencil_read_mask());
                 _cur_stencil_buffer_state.stencil_func() = state.stencil_func();
@@ -300,9 +494,9 @@ namespace fixie
                 _cur_stencil_buffer_state.stencil_read_mask() = state.stencil_read_mask();
             }
 
-            if (_cur_stencil_buffer_state.stencil_fail_operation() != state.stencil_fail_operation() ||
-                _cur_stencil_buffer_state.stencil_pass_depth_fail_operation() != state.stencil_pass_depth_fail_operation() ||
-                _cur_stencil_buffer_state.stencil_pass_depth_pass_operation() != state.stencil_pass_depth_pass_operation())
+            if (track_state_change(_cur_stencil_buffer_state.stencil_fail_operation() != state.stencil_fail_operation() ||
+                                   _cur_stencil_buffer_state.stencil_pass_depth_fail_operation() != state.stencil_pass_depth_fail_operation() ||
+                                   _cur_stencil_buffer_state.stencil_pass_depth_pass_operation() != state.stencil_pass_depth_pass_operation()))
             {
                 gl_call(_functions, stencil_op, state.stencil_fail_operation(), state.stencil_pass_depth_fail_operation(),
                                                 state.stencil_pass_depth_pass_operation());
@@ -311,13 +505,13 @@ namespace fixie
                 _cur_stencil_buffer_state.stencil_pass_depth_pass_operation() = state.stencil_pass_depth_pass_operation();
             }
 
-            if (_cur_stencil_buffer_state.stencil_write_mask() != state.stencil_write_mask())
+            if (track_state_change(_cur_stencil_buffer_state.stencil_write_mask() != state.stencil_write_mask()))
             {
                 gl_call(_functions, stencil_mask, state.stencil_write_mask());
                 _cur_stencil_buffer_state.stencil_write_mask() = state.stencil_write_mask();
             }
 
-            if (_cur_stencil_buffer_state.clear_stencil() != state.clear_stencil())
+            if (track_state_change(_cur_stencil_buffer_state.clear_stencil() != state.clear_stencil()))
             {
                 gl_call(_functions, clear_stencil, state.clear_stencil());
                 _cur_stencil_buffer_state.clear_stencil() = state.clear_stencil();
@@ -326,6 +520,11 @@ namespace fixie
 
         void context::sync_point_state(const point_state& state)
         {
+            if (_requires_point_sprite_enable && track_state_change(_cur_point_state.point_sprite_enabled() != state.point_sprite_enabled()))
+            {
+                enable_gl_state(_functions, GL_POINT_SPRITE, state.point_sprite_enabled());
+                _cur_point_state.point_sprite_enabled() = state.point_sprite_enabled();
+            }
         }
 
         void context::sync_line_state(const line_state& state)
@@ -338,33 +537,33 @@ namespace fixie
 
         void context::sync_multisample_state(const multisample_state& state)
         {
-            if (_cur_multisample_state.multisample_enabled() != state.multisample_enabled())
+            if (track_state_change(_cur_multisample_state.multisample_enabled() != state.multisample_enabled()))
             {
                 enable_gl_state(_functions, GL_MULTISAMPLE, state.multisample_enabled());
                 _cur_multisample_state.multisample_enabled() = state.multisample_enabled();
             }
 
-            if (_cur_multisample_state.sample_to_alpha_coverage_enabled() != state.sample_to_alpha_coverage_enabled())
+            if (track_state_change(_cur_multisample_state.sample_to_alpha_coverage_enabled() != state.sample_to_alpha_coverage_enabled()))
             {
                 enable_gl_state(_functions, GL_SAMPLE_ALPHA_TO_COVERAGE, state.sample_to_alpha_coverage_enabled());
                 _cur_multisample_state.sample_to_alpha_coverage_enabled() = state.sample_to_alpha_coverage_enabled();
             }
 
-            if (_cur_multisample_state.sample_alpha_to_one_enabled() != state.sample_alpha_to_one_enabled())
+            if (track_state_change(_cur_multisample_state.sample_alpha_to_one_enabled() != state.sample_alpha_to_one_enabled()))
             {
                 enable_gl_state(_functions, GL_SAMPLE_ALPHA_TO_ONE, state.sample_alpha_to_one_enabled());
                 _cur_multisample_state.sample_alpha_to_one_enabled() = state.sample_alpha_to_one_enabled();
             }
 
-            if (_cur_multisample_state.sample_coverage_enabled() != state.sample_coverage_enabled())
+            if (track_state_change(_cur_multisample_state.sample_coverage_enabled() != state.sample_coverage_enabled()))
             {
                 enable_gl_state(_functions, GL_SAMPLE_COVERAGE, state.sample_coverage_enabled());
                 _cur_multisample_state.sample_coverage_enabled() = state.sample_coverage_enabled();
             }
 
 
-            if (_cur_multisample_state.sample_coverage_value() != state.sample_coverage_value() ||
-                _cur_multisample_state.sample_coverage_invert() != state.sample_coverage_invert())
+            if (track_state_change(_cur_multisample_state.sample_coverage_value() != state.sample_coverage_value() ||
+                                   _cur_multisample_state.sample_coverage_invert() != state.sample_coverage_invert()))
             {
                 gl_call(_functions, sample_coverage, state.sample_coverage_value(), state.sample_coverage_invert());
                 _cur_multisample_state.sample_coverage_value() = state.sample_coverage_value();
@@ -372,12 +571,25 @@ namespace fixie
             }
         }
 
+        void context::sync_clip_planes(const state& state, GLboolean clip_planes_enabled)
+        {
+            for (size_t i = 0; i < _cur_clip_planes_enabled.size(); i++)
+            {
+                GLboolean enabled = clip_planes_enabled && state.clip_plane(i).clip_plane_enabled();
+                if (track_state_change(_cur_clip_planes_enabled[i] != enabled))
+                {
+                    enable_gl_state(_functions, static_cast<GLenum>(GL_CLIP_DISTANCE0 + i), enabled);
+                    _cur_clip_planes_enabled[i] = enabled;
+                }
+            }
+        }
+
         void context::sync_vertex_attribute(const vertex_attribute& attribute, GLint location, GLboolean normalized)
         {
             if (location != -1)
             {
                 auto cur_attribute = _cur_vertex_attributes.find(location);
-                if (cur_attribute == end(_cur_vertex_attributes) || cur_attribute->second != attribute)
+                if (track_state_change(cur_attribute == end(_cur_vertex_attributes) || cur_attribute->second != attribute))
                 {
                     if (attribute.attribute_enabled())
                     {
@@ -389,6 +601,10 @@ namespace fixie
                         gl_call(_functions, bind_buffer, GL_ARRAY_BUFFER, buffer_id);
                         gl_call(_functions, enable_vertex_attrib_array, location);
                         gl_call(_functions, vertex_attrib_pointer, location, attribute.size(), attribute.type(), normalized, attribute.stride(), attribute.pointer());
+                        if (_supports_instanced_arrays)
+                        {
+                            gl_call(_functions, vertex_attrib_divisor, location, attribute.divisor());
+                        }
                     }
                     else
                     {
@@ -404,6 +620,22 @@ namespace fixie
             }
         }
 
+        void context::sync_matrix_vertex_attribute(const vertex_attribute& attribute, GLint location)
+        {
+            if (location != -1)
+            {
+                // A mat4 attribute occupies four consecutive locations, one per column
+                for (GLint column = 0; column < 4; column++)
+                {
+                    vertex_attribute column_attribute = attribute;
+                    column_attribute.size() = 4;
+                    column_attribute.stride() = (attribute.stride() != 0) ? attribute.stride() : static_cast<GLsizei>(16 * sizeof(GLfloat));
+                    column_attribute.pointer() = static_cast<const GLubyte*>(attribute.pointer()) + column * 4 * sizeof(GLfloat);
+                    sync_vertex_attribute(column_attribute, location + column, GL_FALSE);
+                }
+            }
+        }
+
         void context::sync_vertex_attributes(std::weak_ptr<const fixie::vertex_array> vertex_array, std::weak_ptr<const shader> shader)
         {
             std::shared_ptr<const desktop_gl_impl::shader> locked_shader = shader.lock();
@@ -415,6 +647,11 @@ namespace fixie
             sync_vertex_attribute(locked_vertex_array->vertex_attribute(), locked_shader->vertex_attribute_location(), GL_FALSE);
             sync_vertex_attribute(locked_vertex_array->color_attribute(), locked_shader->color_attribute_location(), GL_TRUE);
             sync_vertex_attribute(locked_vertex_array->normal_attribute(), locked_shader->normal_attribute_location(), GL_TRUE);
+            sync_vertex_attribute(locked_vertex_array->point_size_attribute(), locked_shader->point_size_attribute_location(), GL_FALSE);
+            sync_vertex_attribute(locked_vertex_array->matrix_index_attribute(), locked_shader->matrix_index_attribute_location(), GL_FALSE);
+            sync_vertex_attribute(locked_vertex_array->weight_attribute(), locked_shader->weight_attribute_location(), GL_FALSE);
+            sync_matrix_vertex_attribute(locked_vertex_array->instance_model_view_attribute(), locked_shader->instance_model_view_attribute_location());
+            sync_vertex_attribute(locked_vertex_array->instance_color_attribute(), locked_shader->instance_color_attribute_location(), GL_TRUE);
             for_each_n(0, _caps.max_texture_units(), [&](size_t i) { sync_vertex_attribute(locked_vertex_array->texcoord_attribute(i), locked_shader->texcoord_attribute_location(i), GL_TRUE); });
         }
 
@@ -424,6 +661,10 @@ namespace fixie
             std::shared_ptr<const fixie::texture_impl> texture_impl = (locked_texture != nullptr) ? locked_texture->impl().lock() : nullptr;
             std::shared_ptr<const desktop_gl_impl::texture> desktop_texture = std::dynamic_pointer_cast<const desktop_gl_impl::texture>(texture_impl);
             GLuint texuture_id = desktop_texture ? desktop_texture->id() : 0;
+            if (desktop_texture)
+            {
+                desktop_texture->resolve_pending();
+            }
 
             gl_call(_functions, active_texture, static_cast<GLenum>(GL_TEXTURE0 + index));
             gl_call(_functions, bind_texture, GL_TEXTURE_2D, texuture_id);
@@ -453,24 +694,73 @@ namespace fixie
             std::shared_ptr<const framebuffer> desktop_framebuffer = std::dynamic_pointer_cast<const framebuffer>(bound_framebuffer_impl);
             GLuint framebuffer_id = desktop_framebuffer ? desktop_framebuffer->id() : 0;
 
+            // Moving off a framebuffer resolves its multisampled texture, otherwise that waits until the texture is used
+            std::shared_ptr<const framebuffer> previous_framebuffer = _cur_framebuffer.lock();
+            if (previous_framebuffer != nullptr && previous_framebuffer != desktop_framebuffer)
+            {
+                previous_framebuffer->resolve();
+            }
+            _cur_framebuffer = desktop_framebuffer;
+
             gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, framebuffer_id);
+
+            std::shared_ptr<const texture> multisample_texture = desktop_framebuffer ? desktop_framebuffer->multisample_texture() : nullptr;
+            if (multisample_texture)
+            {
+                desktop_framebuffer->set_needs_resolve();
+                multisample_texture->set_pending_resolve(desktop_framebuffer);
+            }
         }
 
-        void context::sync_draw_state(const state& state)
+        std::shared_ptr<shader> context::sync_draw_state(const state& state, GLenum primitive_mode, GLboolean draws_instances, GLboolean draws_texture_rects)
         {
-            std::shared_ptr<shader> shader = _shader_cache.get_shader(state, _caps).lock();
-            shader->sync_state(state);
-            sync_vertex_attributes(state.bound_vertex_array(), shader);
-            sync_textures(state);
-            sync_framebuffer(state);
-            sync_viewport_state(state.viewport_state());
-            sync_scissor_state(state.scissor_state());
-            sync_color_buffer_state(state.color_buffer_state());
-            sync_depth_buffer_state(state.depth_buffer_state());
-            sync_stencil_buffer_state(state.stencil_buffer_state());
-            sync_point_state(state.point_state());
-            sync_line_state(state.line_state());
-            sync_polygon_state(state.polygon_state());
+            FIXIE_TRACE_SCOPE("sync", "sync_draw_state");
+
+            std::shared_ptr<shader> shader;
+            {
+                FIXIE_TRACE_SCOPE("sync", "get_shader");
+                shader = _shader_cache.get_shader(state, _caps, primitive_mode, draws_instances, draws_texture_rects).lock();
+            }
+            {
+                FIXIE_TRACE_SCOPE("sync", "sync_shader_state");
+                shader->sync_state(state);
+            }
+            if (!draws_texture_rects)
+            {
+                FIXIE_TRACE_SCOPE("sync", "sync_vertex_attributes");
+                sync_vertex_attributes(state.bound_vertex_array(), shader);
+            }
+            {
+                FIXIE_TRACE_SCOPE("sync", "sync_textures");
+                sync_textures(state);
+            }
+            {
+                FIXIE_TRACE_SCOPE("sync", "sync_fixed_function_state");
+                sync_framebuffer(state);
+                sync_viewport_state(state.viewport_state());
+                sync_scissor_state(state.scissor_state());
+                sync_color_buffer_state(state.color_buffer_state());
+                sync_depth_buffer_state(state.depth_buffer_state());
+                sync_stencil_buffer_state(state.stencil_buffer_state());
+                sync_point_state(state.point_state());
+                sync_line_state(state.line_state());
+                sync_polygon_state(state.polygon_state());
+                sync_clip_planes(state, !draws_texture_rects);
+            }
+            return shader;
+        }
+
+        bool context::track_state_change(bool changed)
+        {
+            if (changed)
+            {
+                _statistics->state_changes()++;
+            }
+            else
+            {
+                _statistics->redundant_state_changes()++;
+            }
+            return changed;
         }
 
         gl_version context::initialize_version(std::shared_ptr<const gl_functions> functions)
@@ -479,6 +769,42 @@ namespace fixie
             return gl_version(std::string(reinterpret_cast<const char*>(gl_version_string)));
         }
 
+        GLboolean context::initialize_requires_point_sprite_enable(std::shared_ptr<const gl_functions> functions, const gl_version& version)
+        {
+            // gl_PointCoord is only generated when GL_POINT_SPRITE is enabled outside of core profiles
+            if (version.type() != open_gl)
+            {
+                return GL_FALSE;
+            }
+            else if (version < gl_3_2)
+            {
+                return GL_TRUE;
+            }
+            else
+            {
+                GLint profile_mask = 0;
+                gl_call(functions, get_integer_v, GL_CONTEXT_PROFILE_MASK, &profile_mask);
+                return (profile_mask & GL_CONTEXT_COMPATIBILITY_PROFILE_BIT) ? GL_TRUE : GL_FALSE;
+            }
+        }
+
+        GLenum context::initialize_native_etc1_format(const gl_version& version, const std::unordered_set<std::string>& extensions)
+        {
+            // ETC2 decoders accept ETC1 data unchanged
+            if (extensions.find("GL_OES_compressed_ETC1_RGB8_texture") != end(extensions))
+            {
+                return GL_ETC1_RGB8_OES;
+            }
+            else if (version >= gl_4_3 || version >= gl_es_3_0 || extensions.find("GL_ARB_ES3_compatibility") != end(extensions))
+            {
+                return GL_COMPRESSED_RGB8_ETC2;
+            }
+            else
+            {
+                return 0;
+            }
+        }
+
         std::unordered_set<std::string> context::intialize_extensions(std::shared_ptr<const gl_functions> functions, const gl_version& version)
         {
             std::unordered_set<std::string> extensions;
@@ -549,6 +875,13 @@ namespace fixie
                 caps.insert_compressed_format(compressed_formats[i]);
             }
 
+            // Formats without driver support are decoded on upload
+            caps.insert_compressed_format(GL_ETC1_RGB8_OES);
+            for (GLenum format = GL_PALETTE4_RGB8_OES; format <= GL_PALETTE8_RGB5_A1_OES; ++format)
+            {
+                caps.insert_compressed_format(format);
+            }
+
             caps.supports_vertex_array_objects() = version >= gl_3_0 || version >= gl_es_3_0 || extensions.find("GL_ARB_vertex_array_object") != end(extensions);
 
             if (version >= gl_3_0 || version >= gl_es_3_0 || extensions.find("GL_EXT_framebuffer_object") != end(extensions))
@@ -579,6 +912,17 @@ namespace fixie
                 caps.supports_stencil1() = (version >= gl_3_0 || extensions.find("GL_OES_stencil1") != end(extensions)) ? GL_TRUE : GL_FALSE;
                 caps.supports_stencil4() = (version >= gl_3_0 || extensions.find("GL_OES_stencil4") != end(extensions)) ? GL_TRUE : GL_FALSE;
                 caps.supports_stencil8() = (version >= gl_3_0 || extensions.find("GL_OES_stencil8") != end(extensions)) ? GL_TRUE : GL_FALSE;
+
+                // Multisampled texture attachments are resolved with blits
+                if (version >= gl_3_0 || version >= gl_es_3_0 || extensions.find("GL_ARB_framebuffer_object") != end(extensions))
+                {
+                    #define GL_MAX_SAMPLES 0x8D57
+                    gl_call(functions, get_integer_v, GL_MAX_SAMPLES, &caps.max_samples());
+                }
+                else
+                {
+                    caps.max_samples() = 0;
+                }
             }
             else
             {
@@ -597,8 +941,29 @@ namespace fixie
                 caps.supports_stencil1() = GL_FALSE;
                 caps.supports_stencil4() = GL_FALSE;
                 caps.supports_stencil8() = GL_FALSE;
+                caps.max_samples() = 0;
+            }
+
+            if (version >= gl_3_3 || extensions.find("GL_ARB_timer_query") != end(extensions))
+            {
+                #define GL_TIMESTAMP 0x8E28
+                #define GL_QUERY_COUNTER_BITS 0x8864
+
+                caps.supports_timer_queries() = GL_TRUE;
+                gl_call(functions, get_query_iv, GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &caps.query_counter_bits());
+            }
+            else
+            {
+                caps.supports_timer_queries() = GL_FALSE;
+                caps.query_counter_bits() = 0;
             }
 
+            // Palette matrices live in a uniform array, keep it well inside the minimum vertex uniform space
+            caps.max_palette_matrices() = 16;
+            caps.max_vertex_units() = 4;
+
+            caps.supports_instanced_drawing() = (version >= gl_3_3 || version >= gl_es_3_0) ? GL_TRUE : GL_FALSE;
+
             return caps;
         }
     }
@@ -12,6 +12,8 @@ namespace fixie
 {
     namespace desktop_gl_impl
     {
+        class framebuffer;
+
         class context : public fixie::context_impl
         {
         public:
@@ -28,20 +30,44 @@ namespace fixie
             virtual std::unique_ptr<framebuffer_impl> create_default_framebuffer() override;
             virtual std::unique_ptr<framebuffer_impl> create_framebuffer() override;
             virtual std::unique_ptr<buffer_impl> create_buffer() override;
+            virtual std::unique_ptr<query_impl> create_query() override;
 
             virtual void draw_arrays(const state& state, GLenum mode, GLint first, GLsizei count) override;
             virtual void draw_elements(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) override;
+            virtual void draw_arrays_instanced(const state& state, GLenum mode, GLint first, GLsizei count, GLsizei instance_count) override;
+            virtual void draw_elements_instanced(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count) override;
+            virtual void draw_texture_rects(const state& state, const texture_rect_batch& rects) override;
 
             virtual void clear(const state& state, GLbitfield mask) override;
 
             virtual void flush() override;
             virtual void finish() override;
 
+            virtual void push_debug_group(GLenum source, GLuint id, const std::string& message) override;
+            virtual void pop_debug_group() override;
+
+            virtual void set_texture_label(std::weak_ptr<const texture_impl> texture, const std::string& label) override;
+            virtual void set_buffer_label(std::weak_ptr<const buffer_impl> buffer, const std::string& label) override;
+            virtual void set_renderbuffer_label(std::weak_ptr<const renderbuffer_impl> renderbuffer, const std::string& label) override;
+            virtual void set_framebuffer_label(std::weak_ptr<const framebuffer_impl> framebuffer, const std::string& label) override;
+
+            virtual GLuint64 timestamp() override;
+
+            virtual fixie::statistics& statistics() override;
+
         private:
             std::shared_ptr<const gl_functions> _functions;
             gl_version _version;
             std::unordered_set<std::string> _extensions;
             fixie::caps _caps;
+            GLboolean _supports_debug;
+            GLboolean _requires_point_sprite_enable;
+            GLboolean _supports_instanced_arrays;
+            GLenum _native_etc1_format;
+            GLboolean _supports_async_read_pixels;
+            GLboolean _supports_framebuffer_blit;
+            GLboolean _supports_framebuffer_invalidate;
+            std::shared_ptr<fixie::statistics> _statistics;
             shader_cache _shader_cache;
 
             std::string _renderer_string;
@@ -73,19 +99,34 @@ namespace fixie
             multisample_state _cur_multisample_state;
             void sync_multisample_state(const multisample_state& state);
 
+            std::vector<GLboolean> _cur_clip_planes_enabled;
+            void sync_clip_planes(const state& state, GLboolean clip_planes_enabled);
+
             GLuint _vao;
             std::unordered_map<GLint, vertex_attribute> _cur_vertex_attributes;
             void sync_vertex_attribute(const vertex_attribute& attribute, GLint location, GLboolean normalized);
+            void sync_matrix_vertex_attribute(const vertex_attribute& attribute, GLint location);
             void sync_vertex_attributes(std::weak_ptr<const fixie::vertex_array> vertex_array, std::weak_ptr<const shader> shader);
 
             void sync_texture(std::weak_ptr<const fixie::texture> texture, size_t index);
             void sync_textures(const state& state);
 
+            std::weak_ptr<const framebuffer> _cur_framebuffer;
             void sync_framebuffer(const state& state);
 
-            void sync_draw_state(const state& state);
+            std::shared_ptr<shader> sync_draw_state(const state& state, GLenum primitive_mode, GLboolean draws_instances, GLboolean draws_texture_rects);
+
+            GLuint _texture_rect_buffer;
+            void set_texture_rect_attribute(GLint location, GLint size, GLsizei stride, size_t offset);
+            void set_texture_rect_generic_attribute(GLint location, GLint size, const GLfloat* values);
+
+            bool track_state_change(bool changed);
+
+            void set_object_label(GLenum identifier, GLuint id, const std::string& label);
 
             static gl_version initialize_version(std::shared_ptr<const gl_functions> functions);
+            static GLboolean initialize_requires_point_sprite_enable(std::shared_ptr<const gl_functions> functions, const gl_version& version);
+            static GLenum initialize_native_etc1_format(const gl_version& version, const std::unordered_set<std::string>& extensions);
             static std::unordered_set<std::string> intialize_extensions(std::shared_ptr<const gl_functions> functions, const gl_version& version);
             static fixie::caps initialize_caps(std::shared_ptr<const gl_functions> functions, const gl_version& version, const std::unordered_set<std::string>& extensions);
         };
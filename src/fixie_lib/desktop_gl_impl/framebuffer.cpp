@@ -1,7 +1,12 @@
 #include "fixie_lib/desktop_gl_impl/framebuffer.hpp"
 #include "fixie_lib/desktop_gl_impl/texture.hpp"
 #include "fixie_lib/desktop_gl_impl/renderbuffer.hpp"
+#include "fixie_lib/pixel_conversion.hpp"
 #include "fixie_lib/debug.hpp"
+#include "fixie_lib/tracer.hpp"
+#include "fixie_lib/util.hpp"
+
+#include <algorithm>
 
 namespace fixie
 {
@@ -13,28 +18,114 @@ namespace fixie
     #define GL_DEPTH_ATTACHMENT 0x8D00
     #define GL_STENCIL_ATTACHMENT 0x8D20
 
+    #define GL_COLOR 0x1800
+    #define GL_DEPTH 0x1801
+    #define GL_STENCIL 0x1802
+
     #define GL_FRAMEBUFFER_COMPLETE 0x8CD5
 
+    #define GL_SCISSOR_TEST 0x0C11
+
     #define GL_IMPLEMENTATION_COLOR_READ_TYPE 0x8B9A
     #define GL_IMPLEMENTATION_COLOR_READ_FORMAT 0x8B9B
 
+    #define GL_PIXEL_PACK_BUFFER 0x88EB
+    #define GL_STREAM_READ 0x88E1
+    #define GL_MAP_READ_BIT 0x0001
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #define GL_TIMEOUT_EXPIRED 0x911B
+    #define GL_WAIT_FAILED 0x911D
+    #define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+
     namespace desktop_gl_impl
     {
-        framebuffer::framebuffer(std::shared_ptr<const gl_functions> functions)
+        framebuffer::read_pixels_slot::read_pixels_slot()
+            : request(0)
+            , buffer(0)
+            , capacity(0)
+            , size(0)
+            , row_size(0)
+            , row_pitch(0)
+            , height(0)
+            , swap_red_blue(GL_FALSE)
+            , reverse_rows(GL_FALSE)
+            , fence(nullptr)
+            , client_pixels()
+        {
+        }
+
+        framebuffer::framebuffer(std::shared_ptr<const gl_functions> functions, GLboolean supports_async_read_pixels, GLboolean supports_invalidate,
+                                 GLboolean supports_multisample_resolve)
             : _functions(functions)
             , _id(0)
+            , _color_attachment()
+            , _read_format(0)
+            , _read_type(0)
+            , _read_format_revision(0)
+            , _staging_pixels()
+            , _supports_async_read_pixels(supports_async_read_pixels)
+            , _read_pixels_slots()
+            , _next_read_pixels_request(0)
+            , _supports_invalidate(supports_invalidate)
+            , _supports_multisample_resolve(supports_multisample_resolve)
+            , _multisample_renderbuffer(0)
+            , _resolve_framebuffer(0)
+            , _resolve_width(0)
+            , _resolve_height(0)
+            , _resolve_texture()
+            , _needs_resolve(GL_FALSE)
         {
             gl_call(_functions, gen_framebuffers, 1, &_id);
         }
 
-        framebuffer::framebuffer(GLuint id, std::shared_ptr<const gl_functions> functions)
+        framebuffer::framebuffer(GLuint id, std::shared_ptr<const gl_functions> functions, GLboolean supports_async_read_pixels, GLboolean supports_invalidate,
+                                 GLboolean supports_multisample_resolve)
             : _functions(functions)
             , _id(id)
+            , _color_attachment()
+            , _read_format(0)
+            , _read_type(0)
+            , _read_format_revision(0)
+            , _staging_pixels()
+            , _supports_async_read_pixels(supports_async_read_pixels)
+            , _read_pixels_slots()
+            , _next_read_pixels_request(0)
+            , _supports_invalidate(supports_invalidate)
+            , _supports_multisample_resolve(supports_multisample_resolve)
+            , _multisample_renderbuffer(0)
+            , _resolve_framebuffer(0)
+            , _resolve_width(0)
+            , _resolve_height(0)
+            , _resolve_texture()
+            , _needs_resolve(GL_FALSE)
         {
         }
 
         framebuffer::~framebuffer()
         {
+            resolve();
+            if (_multisample_renderbuffer)
+            {
+                gl_call_nothrow(_functions, delete_renderbuffers, 1, &_multisample_renderbuffer);
+            }
+            if (_resolve_framebuffer)
+            {
+                gl_call_nothrow(_functions, delete_framebuffers, 1, &_resolve_framebuffer);
+            }
+
+            for (const read_pixels_slot& slot : _read_pixels_slots)
+            {
+                if (slot.fence)
+                {
+                    gl_call_nothrow(_functions, delete_sync, slot.fence);
+                }
+                if (slot.buffer)
+                {
+                    gl_call_nothrow(_functions, delete_buffers, 1, &slot.buffer);
+                }
+            }
+
             if (_id)
             {
                 gl_call_nothrow(_functions, delete_framebuffers, 1, &_id);
@@ -57,14 +148,7 @@ namespace fixie
                     std::shared_ptr<const fixie::texture> texture = attachment.texture().lock();
                     std::shared_ptr<const desktop_gl_impl::texture> texture_impl = texture ? std::dynamic_pointer_cast<const desktop_gl_impl::texture>(texture->impl().lock()) : nullptr;
                     GLuint id = texture_impl ? texture_impl->id() : 0;
-                    if (attachment.texture_samples() > 1)
-                    {
-                        gl_call(functions, framebuffer_texture_2d_multisample, GL_FRAMEBUFFER, attachment_point, GL_TEXTURE_2D, id, attachment.texture_level(), attachment.texture_samples());
-                    }
-                    else
-                    {
-                        gl_call(functions, framebuffer_texture_2d, GL_FRAMEBUFFER, attachment_point, GL_TEXTURE_2D, id, attachment.texture_level());
-                    }
+                    gl_call(functions, framebuffer_texture_2d, GL_FRAMEBUFFER, attachment_point, GL_TEXTURE_2D, id, attachment.texture_level());
                 }
                 else if (attachment.is_renderbuffer())
                 {
@@ -83,42 +167,389 @@ namespace fixie
 
         void framebuffer::set_color_attachment(const framebuffer_attachment& attachment)
         {
-            set_framebuffer_attachment(_functions, _id, GL_COLOR_ATTACHMENT0, attachment);
+            release_multisample_color_attachment();
+            if (!set_multisample_color_attachment(attachment))
+            {
+                set_framebuffer_attachment(_functions, _id, GL_COLOR_ATTACHMENT0, attachment);
+            }
+            _color_attachment = attachment;
+            _read_format = 0;
+            _read_type = 0;
         }
 
         void framebuffer::set_depth_attachment(const framebuffer_attachment& attachment)
         {
             set_framebuffer_attachment(_functions, _id, GL_DEPTH_ATTACHMENT, attachment);
+            _read_format = 0;
+            _read_type = 0;
         }
 
         void framebuffer::set_stencil_attachment(const framebuffer_attachment& attachment)
         {
             set_framebuffer_attachment(_functions, _id, GL_STENCIL_ATTACHMENT, attachment);
+            _read_format = 0;
+            _read_type = 0;
         }
 
-        GLenum framebuffer::preferred_read_format() const
+        static GLenum multisample_renderbuffer_format(GLenum texture_format)
         {
-            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _id);
+            switch (texture_format)
+            {
+            case GL_RGB:
+            case GL_RGB8_OES:
+                return GL_RGB8_OES;
+
+            case GL_RGBA:
+            case GL_RGBA8_OES:
+                return GL_RGBA8_OES;
 
-            GLint read_format;
-            gl_call(_functions, get_integer_v, GL_IMPLEMENTATION_COLOR_READ_FORMAT, &read_format);
-            return static_cast<GLenum>(read_format);
+            default:
+                return GL_NONE_OES;
+            }
         }
 
-        GLenum framebuffer::preferred_read_type() const
+        GLboolean framebuffer::set_multisample_color_attachment(const framebuffer_attachment& attachment)
         {
+            if (!_supports_multisample_resolve || _id == 0 || !attachment.is_texture() || attachment.texture_samples() <= 1)
+            {
+                return GL_FALSE;
+            }
+
+            std::shared_ptr<const fixie::texture> texture = attachment.texture().lock();
+            std::shared_ptr<const desktop_gl_impl::texture> texture_impl = texture ? std::dynamic_pointer_cast<const desktop_gl_impl::texture>(texture->impl().lock()) : nullptr;
+            size_t level = static_cast<size_t>(attachment.texture_level());
+            if (texture_impl == nullptr || level >= texture->mip_levels())
+            {
+                return GL_FALSE;
+            }
+
+            GLenum renderbuffer_format = multisample_renderbuffer_format(texture->mip_level_internal_format(level));
+            if (renderbuffer_format == GL_NONE_OES)
+            {
+                return GL_FALSE;
+            }
+
+            // Rendering goes to a hidden multisampled renderbuffer, the texture is only attached to the framebuffer that
+            // the renderbuffer is resolved into
+            _resolve_width = texture->mip_level_width(level);
+            _resolve_height = texture->mip_level_height(level);
+
+            if (_multisample_renderbuffer == 0)
+            {
+                gl_call(_functions, gen_renderbuffers, 1, &_multisample_renderbuffer);
+            }
+            gl_call(_functions, bind_renderbuffer, GL_RENDERBUFFER, _multisample_renderbuffer);
+            gl_call(_functions, renderbuffer_storage_multisample, GL_RENDERBUFFER, attachment.texture_samples(), renderbuffer_format, _resolve_width, _resolve_height);
+
             gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _id);
+            gl_call(_functions, framebuffer_renderbuffer, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _multisample_renderbuffer);
+
+            if (_resolve_framebuffer == 0)
+            {
+                gl_call(_functions, gen_framebuffers, 1, &_resolve_framebuffer);
+            }
+            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _resolve_framebuffer);
+            gl_call(_functions, framebuffer_texture_2d, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_impl->id(), attachment.texture_level());
+
+            _resolve_texture = texture_impl;
+            return GL_TRUE;
+        }
+
+        void framebuffer::release_multisample_color_attachment()
+        {
+            if (!_resolve_texture.expired())
+            {
+                gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _resolve_framebuffer);
+                gl_call(_functions, framebuffer_texture_2d, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+            }
+            _resolve_texture.reset();
+            _needs_resolve = GL_FALSE;
+        }
+
+        std::shared_ptr<const texture> framebuffer::multisample_texture() const
+        {
+            return _resolve_texture.lock();
+        }
+
+        void framebuffer::set_needs_resolve() const
+        {
+            _needs_resolve = _resolve_texture.expired() ? GL_FALSE : GL_TRUE;
+        }
+
+        void framebuffer::resolve() const
+        {
+            if (!_needs_resolve)
+            {
+                return;
+            }
+
+            FIXIE_TRACE_SCOPE("sync", "framebuffer::resolve");
+
+            // Blits are scissored, the whole attachment has to be resolved regardless of the scissor state
+            GLboolean scissor_test_enabled = gl_call_nothrow(_functions, is_enabled, GL_SCISSOR_TEST);
+            if (scissor_test_enabled)
+            {
+                gl_call_nothrow(_functions, disable, GL_SCISSOR_TEST);
+            }
+
+            gl_call_nothrow(_functions, bind_framebuffer, GL_READ_FRAMEBUFFER, _id);
+            gl_call_nothrow(_functions, bind_framebuffer, GL_DRAW_FRAMEBUFFER, _resolve_framebuffer);
+            gl_call_nothrow(_functions, blit_framebuffer, 0, 0, _resolve_width, _resolve_height, 0, 0, _resolve_width, _resolve_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            gl_call_nothrow(_functions, bind_framebuffer, GL_FRAMEBUFFER, _id);
+
+            if (scissor_test_enabled)
+            {
+                gl_call_nothrow(_functions, enable, GL_SCISSOR_TEST);
+            }
+
+            _needs_resolve = GL_FALSE;
+        }
+
+        GLuint framebuffer::read_framebuffer_id() const
+        {
+            // Multisampled color cannot be read directly, it is read back from the texture it resolves into
+            if (_resolve_texture.expired())
+            {
+                return _id;
+            }
+
+            resolve();
+            return _resolve_framebuffer;
+        }
+
+        GLuint framebuffer::color_storage_revision() const
+        {
+            if (_color_attachment.is_texture())
+            {
+                std::shared_ptr<const fixie::texture> texture = _color_attachment.texture().lock();
+                std::shared_ptr<const desktop_gl_impl::texture> texture_impl = texture ? std::dynamic_pointer_cast<const desktop_gl_impl::texture>(texture->impl().lock()) : nullptr;
+                return texture_impl ? texture_impl->storage_revision() : 0;
+            }
+            else if (_color_attachment.is_renderbuffer())
+            {
+                std::shared_ptr<const fixie::renderbuffer> renderbuffer = _color_attachment.renderbuffer().lock();
+                std::shared_ptr<const desktop_gl_impl::renderbuffer> renderbuffer_impl = renderbuffer ? std::dynamic_pointer_cast<const desktop_gl_impl::renderbuffer>(renderbuffer->impl().lock()) : nullptr;
+                return renderbuffer_impl ? renderbuffer_impl->storage_revision() : 0;
+            }
+            else
+            {
+                return 0;
+            }
+        }
+
+        void framebuffer::cache_read_format() const
+        {
+            GLuint revision = color_storage_revision();
+            if (_read_format == 0 || _read_type == 0 || _read_format_revision != revision)
+            {
+                _read_format_revision = revision;
+
+                gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, read_framebuffer_id());
 
-            GLint read_type;
-            gl_call(_functions, get_integer_v, GL_IMPLEMENTATION_COLOR_READ_TYPE, &read_type);
-            return static_cast<GLenum>(read_type);
+                GLint read_format;
+                gl_call(_functions, get_integer_v, GL_IMPLEMENTATION_COLOR_READ_FORMAT, &read_format);
+                _read_format = static_cast<GLenum>(read_format);
+
+                GLint read_type;
+                gl_call(_functions, get_integer_v, GL_IMPLEMENTATION_COLOR_READ_TYPE, &read_type);
+                _read_type = static_cast<GLenum>(read_type);
+            }
+        }
+
+        GLboolean framebuffer::swaps_red_blue(GLenum format, GLenum type) const
+        {
+            // Reading RGBA from a BGRA surface makes the driver convert on its slow path, read the native layout and
+            // swizzle it while copying out instead
+            if (format != GL_RGBA || type != GL_UNSIGNED_BYTE)
+            {
+                return GL_FALSE;
+            }
+
+            cache_read_format();
+            return (_read_format == GL_BGRA_EXT && _read_type == GL_UNSIGNED_BYTE) ? GL_TRUE : GL_FALSE;
+        }
+
+        GLenum framebuffer::preferred_read_format() const
+        {
+            cache_read_format();
+            return _read_format;
+        }
+
+        GLenum framebuffer::preferred_read_type() const
+        {
+            cache_read_format();
+            return _read_type;
         }
 
         void framebuffer::read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* data)
         {
-            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _id);
+            GLboolean swap_red_blue = swaps_red_blue(format, type);
+            GLboolean reverse_rows = store_state.pack_reverse_row_order();
+
+            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, read_framebuffer_id());
             gl_call(_functions, pixel_store_i, GL_PACK_ALIGNMENT, store_state.pack_alignment());
-            gl_call(_functions, read_pixels, x, y, width, height, format, type, data);
+
+            if (swap_red_blue || reverse_rows)
+            {
+                _staging_pixels.resize(static_cast<size_t>(packed_image_size(store_state, width, height, format, type)));
+                gl_call(_functions, read_pixels, x, y, width, height, swap_red_blue ? GL_BGRA_EXT : format, type, _staging_pixels.data());
+                copy_packed_pixels(_staging_pixels.data(), data, static_cast<GLsizeiptr>(width) * pixel_size(format, type),
+                                   packed_row_pitch(store_state, width, format, type), height, swap_red_blue, reverse_rows);
+            }
+            else
+            {
+                gl_call(_functions, read_pixels, x, y, width, height, format, type, data);
+            }
+        }
+
+        GLuint framebuffer::begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type)
+        {
+            FIXIE_TRACE_SCOPE("readback", "framebuffer::begin_read_pixels");
+
+            auto free_slot = std::find_if(begin(_read_pixels_slots), end(_read_pixels_slots), [](const read_pixels_slot& slot){ return slot.request == 0; });
+            if (free_slot == end(_read_pixels_slots))
+            {
+                free_slot = _read_pixels_slots.insert(end(_read_pixels_slots), read_pixels_slot());
+            }
+
+            read_pixels_slot& slot = *free_slot;
+            slot.request = ++_next_read_pixels_request;
+            slot.size = packed_image_size(store_state, width, height, format, type);
+            slot.row_size = static_cast<GLsizeiptr>(width) * pixel_size(format, type);
+            slot.row_pitch = packed_row_pitch(store_state, width, format, type);
+            slot.height = height;
+            slot.swap_red_blue = swaps_red_blue(format, type);
+            slot.reverse_rows = store_state.pack_reverse_row_order();
+
+            GLenum read_format = slot.swap_red_blue ? GL_BGRA_EXT : format;
+
+            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, read_framebuffer_id());
+            gl_call(_functions, pixel_store_i, GL_PACK_ALIGNMENT, store_state.pack_alignment());
+
+            if (_supports_async_read_pixels)
+            {
+                // The read lands in a pixel pack buffer and the fence tells when it can be mapped without stalling
+                if (slot.buffer == 0)
+                {
+                    gl_call(_functions, gen_buffers, 1, &slot.buffer);
+                }
+
+                gl_call(_functions, bind_buffer, GL_PIXEL_PACK_BUFFER, slot.buffer);
+                if (slot.capacity < slot.size)
+                {
+                    gl_call(_functions, buffer_data, GL_PIXEL_PACK_BUFFER, slot.size, nullptr, GL_STREAM_READ);
+                    slot.capacity = slot.size;
+                }
+                gl_call(_functions, read_pixels, x, y, width, height, read_format, type, nullptr);
+                gl_call(_functions, bind_buffer, GL_PIXEL_PACK_BUFFER, 0);
+
+                slot.fence = gl_call_nothrow(_functions, fence_sync, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+
+            // Without a fence there is nothing to wait on, the pixels are read synchronously instead
+            if (slot.fence == nullptr)
+            {
+                slot.client_pixels.resize(static_cast<size_t>(slot.size));
+                gl_call(_functions, read_pixels, x, y, width, height, read_format, type, slot.client_pixels.data());
+            }
+
+            return slot.request;
+        }
+
+        GLboolean framebuffer::end_read_pixels(GLuint request, GLboolean wait, GLvoid* data)
+        {
+            FIXIE_TRACE_SCOPE("readback", "framebuffer::end_read_pixels");
+
+            auto slot = std::find_if(begin(_read_pixels_slots), end(_read_pixels_slots), [&](const read_pixels_slot& slot){ return slot.request == request; });
+            if (slot == end(_read_pixels_slots))
+            {
+                throw invalid_operation_error(format("%u is not a pending read pixels request.", request));
+            }
+
+            if (slot->fence)
+            {
+                GLenum wait_result = gl_call_nothrow(_functions, client_wait_sync, slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+                if (wait_result == GL_TIMEOUT_EXPIRED)
+                {
+                    return GL_FALSE;
+                }
+                else if (wait_result == GL_WAIT_FAILED)
+                {
+                    gl_call_nothrow(_functions, delete_sync, slot->fence);
+                    slot->fence = nullptr;
+                    slot->request = 0;
+                    throw state_error("waiting for a read pixels fence failed.");
+                }
+
+                gl_call(_functions, delete_sync, slot->fence);
+                slot->fence = nullptr;
+
+                gl_call(_functions, bind_buffer, GL_PIXEL_PACK_BUFFER, slot->buffer);
+                const GLvoid* mapped = gl_call_nothrow(_functions, map_buffer_range, GL_PIXEL_PACK_BUFFER, 0, slot->size, GL_MAP_READ_BIT);
+                if (mapped == nullptr)
+                {
+                    gl_call(_functions, bind_buffer, GL_PIXEL_PACK_BUFFER, 0);
+                    slot->request = 0;
+                    throw state_error("mapping the read pixels buffer failed.");
+                }
+
+                copy_packed_pixels(mapped, data, slot->row_size, slot->row_pitch, slot->height, slot->swap_red_blue, slot->reverse_rows);
+                gl_call(_functions, unmap_buffer, GL_PIXEL_PACK_BUFFER);
+                gl_call(_functions, bind_buffer, GL_PIXEL_PACK_BUFFER, 0);
+            }
+            else
+            {
+                copy_packed_pixels(slot->client_pixels.data(), data, slot->row_size, slot->row_pitch, slot->height, slot->swap_red_blue, slot->reverse_rows);
+            }
+
+            slot->request = 0;
+            return GL_TRUE;
+        }
+
+        GLsizei framebuffer::invalidate_attachments(GLbitfield mask, GLenum attachments[3]) const
+        {
+            // The default framebuffer names its buffers rather than its attachment points
+            GLsizei count = 0;
+            if (mask & GL_COLOR_BUFFER_BIT)
+            {
+                attachments[count++] = (_id != 0) ? GL_COLOR_ATTACHMENT0 : GL_COLOR;
+            }
+            if (mask & GL_DEPTH_BUFFER_BIT)
+            {
+                attachments[count++] = (_id != 0) ? GL_DEPTH_ATTACHMENT : GL_DEPTH;
+            }
+            if (mask & GL_STENCIL_BUFFER_BIT)
+            {
+                attachments[count++] = (_id != 0) ? GL_STENCIL_ATTACHMENT : GL_STENCIL;
+            }
+            return count;
+        }
+
+        void framebuffer::invalidate(GLbitfield mask)
+        {
+            GLenum attachments[3];
+            GLsizei count = invalidate_attachments(mask, attachments);
+            if (mask & GL_COLOR_BUFFER_BIT)
+            {
+                _needs_resolve = GL_FALSE;
+            }
+
+            if (_supports_invalidate && count > 0)
+            {
+                gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _id);
+                gl_call(_functions, invalidate_framebuffer, GL_FRAMEBUFFER, count, attachments);
+            }
+        }
+
+        void framebuffer::invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height)
+        {
+            GLenum attachments[3];
+            GLsizei count = invalidate_attachments(mask, attachments);
+            if (_supports_invalidate && count > 0)
+            {
+                gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, _id);
+                gl_call(_functions, invalidate_sub_framebuffer, GL_FRAMEBUFFER, count, attachments, x, y, width, height);
+            }
         }
 
         GLenum framebuffer::status() const 
@@ -128,8 +559,8 @@ namespace fixie
             return status;
         }
 
-        default_framebuffer::default_framebuffer(std::shared_ptr<const gl_functions> functions)
-            : framebuffer(0, functions)
+        default_framebuffer::default_framebuffer(std::shared_ptr<const gl_functions> functions, GLboolean supports_async_read_pixels, GLboolean supports_invalidate)
+            : framebuffer(0, functions, supports_async_read_pixels, supports_invalidate, GL_FALSE)
         {
         }
 
@@ -4,14 +4,19 @@
 #include "fixie_lib/framebuffer.hpp"
 #include "fixie_lib/desktop_gl_impl/gl_functions.hpp"
 
+#include <vector>
+
 namespace fixie
 {
     namespace desktop_gl_impl
     {
+        class texture;
+
         class framebuffer : public fixie::framebuffer_impl
         {
         public:
-            explicit framebuffer(std::shared_ptr<const gl_functions> functions);
+            framebuffer(std::shared_ptr<const gl_functions> functions, GLboolean supports_async_read_pixels, GLboolean supports_invalidate,
+                        GLboolean supports_multisample_resolve);
             virtual ~framebuffer();
 
             GLuint id() const;
@@ -23,21 +28,84 @@ namespace fixie
             virtual GLenum preferred_read_format() const override;
             virtual GLenum preferred_read_type() const override;
             virtual void read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* data) override;
+            virtual GLuint begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type) override;
+            virtual GLboolean end_read_pixels(GLuint request, GLboolean wait, GLvoid* data) override;
+
+            virtual void invalidate(GLbitfield mask) override;
+            virtual void invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height) override;
 
             virtual GLenum status() const override;
 
+            // Texture that a multisampled color attachment renders on behalf of, rendering marks it as needing a resolve
+            // and resolve blits the multisampled samples into it
+            std::shared_ptr<const texture> multisample_texture() const;
+            void set_needs_resolve() const;
+            void resolve() const;
+
+            // Framebuffer that color can be read from, resolving multisampled color first
+            GLuint read_framebuffer_id() const;
+
         protected:
-            framebuffer(GLuint id, std::shared_ptr<const gl_functions> functions);
+            framebuffer(GLuint id, std::shared_ptr<const gl_functions> functions, GLboolean supports_async_read_pixels, GLboolean supports_invalidate,
+                        GLboolean supports_multisample_resolve);
 
         private:
+            GLboolean set_multisample_color_attachment(const framebuffer_attachment& attachment);
+            void release_multisample_color_attachment();
+
+            GLuint color_storage_revision() const;
+            void cache_read_format() const;
+            GLboolean swaps_red_blue(GLenum format, GLenum type) const;
+            GLsizei invalidate_attachments(GLbitfield mask, GLenum attachments[3]) const;
+
             std::shared_ptr<const gl_functions> _functions;
             GLuint _id;
+
+            // Implementation read format and type, zero until queried and reset whenever an attachment changes or the
+            // attached color image is respecified
+            framebuffer_attachment _color_attachment;
+            mutable GLenum _read_format;
+            mutable GLenum _read_type;
+            mutable GLuint _read_format_revision;
+
+            std::vector<GLubyte> _staging_pixels;
+
+            // Pixel pack buffers and fences of in flight reads, slots are reused once their request has ended
+            struct read_pixels_slot
+            {
+                read_pixels_slot();
+
+                GLuint request;
+                GLuint buffer;
+                GLsizeiptr capacity;
+                GLsizeiptr size;
+                GLsizeiptr row_size;
+                GLsizeiptr row_pitch;
+                GLsizei height;
+                GLboolean swap_red_blue;
+                GLboolean reverse_rows;
+                GLsync fence;
+                std::vector<GLubyte> client_pixels;
+            };
+            GLboolean _supports_async_read_pixels;
+            std::vector<read_pixels_slot> _read_pixels_slots;
+            GLuint _next_read_pixels_request;
+
+            GLboolean _supports_invalidate;
+
+            GLboolean _supports_multisample_resolve;
+            GLuint _multisample_renderbuffer;
+            GLuint _resolve_framebuffer;
+            GLsizei _resolve_width;
+            GLsizei _resolve_height;
+            std::weak_ptr<const texture> _resolve_texture;
+            mutable GLboolean _needs_resolve;
         };
 
         class default_framebuffer : public framebuffer
         {
         public:
-            explicit default_framebuffer(std::shared_ptr<const gl_functions> functions);
+            default_framebuffer(std::shared_ptr<const gl_functions> functions, GLboolean supports_async_read_pixels, GLboolean supports_invalidate);
 
             virtual GLenum status() const override;
         };
@@ -3,6 +3,7 @@
 
 #include "fixie/fixie_gl_types.h"
 #include "fixie/fixie_ext.h"
+#include "fixie/fixie_gl_es_ext.h"
 #include "fixie_lib/function_loader.hpp"
 #include "fixie_lib/exceptions.hpp"
 
@@ -48,13 +49,13 @@ namespace fixie
         {
             DECLARE_GL_FUNCTION(enable, void, (GLenum cap), glEnable);
             DECLARE_GL_FUNCTION(disable, void, (GLenum cap), glDisable);
+            DECLARE_GL_FUNCTION(is_enabled, GLboolean, (GLenum cap), glIsEnabled);
 
             DECLARE_GL_FUNCTION(clear_color, void, (GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha), glClearColor);
             DECLARE_GL_FUNCTION(clear_depthf, void, (GLclampf depth), glClearDepthf);
             DECLARE_GL_FUNCTION(clear_stencil, void, (GLint s), glClearStencil);
             DECLARE_GL_FUNCTION(clear, void, (GLbitfield mask), glClear);
 
-            DECLARE_GL_FUNCTION(alpha_func, void, (GLenum func, GLclampf ref), glAlphaFunc);
             DECLARE_GL_FUNCTION(blend_func, void, (GLenum sfactor, GLenum dfactor), glBlendFunc);
             DECLARE_GL_FUNCTION(blend_func_seperate, void, (GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha), glBlendFuncSeparate);
             DECLARE_GL_FUNCTION(logic_op, void, (GLenum opcode), glLogicOp);
@@ -75,6 +76,12 @@ namespace fixie
             DECLARE_GL_FUNCTION(bind_buffer, void, (GLenum target, GLuint buffers), glBindBuffer);
             DECLARE_GL_FUNCTION(buffer_data, void, (GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage), glBufferData);
             DECLARE_GL_FUNCTION(buffer_sub_data, void, (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data), glBufferSubData);
+            DECLARE_GL_FUNCTION(map_buffer_range, GLvoid*, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), glMapBufferRange);
+            DECLARE_GL_FUNCTION(unmap_buffer, GLboolean, (GLenum target), glUnmapBuffer);
+
+            DECLARE_GL_FUNCTION(fence_sync, GLsync, (GLenum condition, GLbitfield flags), glFenceSync);
+            DECLARE_GL_FUNCTION(client_wait_sync, GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout), glClientWaitSync);
+            DECLARE_GL_FUNCTION(delete_sync, void, (GLsync sync), glDeleteSync);
 
             DECLARE_GL_FUNCTION(pixel_store_i, void, (GLenum pname, GLint param), glPixelStorei);
 
@@ -110,8 +117,10 @@ namespace fixie
             DECLARE_GL_FUNCTION(check_framebuffer_status, GLenum, (GLenum target), glCheckFramebufferStatus);
             DECLARE_GL_FUNCTION(framebuffer_renderbuffer, void, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), glFramebufferRenderbuffer);
             DECLARE_GL_FUNCTION(framebuffer_texture_2d, void, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), glFramebufferTexture2D);
-            DECLARE_GL_FUNCTION(framebuffer_texture_2d_multisample, void, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples), glFramebufferTexture2DMultisampleEXT);
             DECLARE_GL_FUNCTION(get_framebuffer_attachment_parameter_iv, void, (GLenum target, GLenum attachment, GLenum pname, GLint* params), glGetFramebufferAttachmentParameteriv);
+            DECLARE_GL_FUNCTION(blit_framebuffer, void, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), glBlitFramebuffer);
+            DECLARE_GL_FUNCTION(invalidate_framebuffer, void, (GLenum target, GLsizei numAttachments, const GLenum* attachments), glInvalidateFramebuffer);
+            DECLARE_GL_FUNCTION(invalidate_sub_framebuffer, void, (GLenum target, GLsizei numAttachments, const GLenum* attachments, GLint x, GLint y, GLsizei width, GLsizei height), glInvalidateSubFramebuffer);
 
             DECLARE_GL_FUNCTION(sample_coverage, void, (GLfloat value, GLboolean invert), glSampleCoverage);
 
@@ -142,6 +151,7 @@ namespace fixie
             DECLARE_GL_FUNCTION(vertex_attrib_pointer, void, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer), glVertexAttribPointer);
             DECLARE_GL_FUNCTION(enable_vertex_attrib_array, void, (GLuint index), glEnableVertexAttribArray);
             DECLARE_GL_FUNCTION(disable_vertex_attrib_array, void, (GLuint index), glDisableVertexAttribArray);
+            DECLARE_GL_FUNCTION(vertex_attrib_divisor, void, (GLuint index, GLuint divisor), glVertexAttribDivisor);
 
             DECLARE_GL_FUNCTION(bind_vertex_array, void, (GLuint array), glBindVertexArray);
             DECLARE_GL_FUNCTION(delete_vertex_arrays, void, (GLsizei n, GLuint* arrays), glDeleteVertexArrays);
@@ -192,6 +202,8 @@ namespace fixie
 
             DECLARE_GL_FUNCTION(draw_arrays, void, (GLenum mode, GLint first, GLsizei count), glDrawArrays);
             DECLARE_GL_FUNCTION(draw_elements, void, (GLenum mode, GLsizei count, GLenum type, const GLvoid* indices), glDrawElements);
+            DECLARE_GL_FUNCTION(draw_arrays_instanced, void, (GLenum mode, GLint first, GLsizei count, GLsizei primcount), glDrawArraysInstanced);
+            DECLARE_GL_FUNCTION(draw_elements_instanced, void, (GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei primcount), glDrawElementsInstanced);
 
             DECLARE_GL_FUNCTION(read_pixels, void, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels), glReadPixels);
 
@@ -200,6 +212,19 @@ namespace fixie
 
             DECLARE_GL_FUNCTION(debug_message_control, void, (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled), glDebugMessageControl);
             DECLARE_GL_FUNCTION(debug_message_callback, void, (GLDEBUGPROCKHR callback, const GLvoid* userParam), glDebugMessageCallback);
+            DECLARE_GL_FUNCTION(push_debug_group, void, (GLenum source, GLuint id, GLsizei length, const GLchar* message), glPushDebugGroup);
+            DECLARE_GL_FUNCTION(pop_debug_group, void, (void), glPopDebugGroup);
+            DECLARE_GL_FUNCTION(object_label, void, (GLenum identifier, GLuint name, GLsizei length, const GLchar* label), glObjectLabel);
+
+            DECLARE_GL_FUNCTION(gen_queries, void, (GLsizei n, GLuint* ids), glGenQueries);
+            DECLARE_GL_FUNCTION(delete_queries, void, (GLsizei n, const GLuint* ids), glDeleteQueries);
+            DECLARE_GL_FUNCTION(begin_query, void, (GLenum target, GLuint id), glBeginQuery);
+            DECLARE_GL_FUNCTION(end_query, void, (GLenum target), glEndQuery);
+            DECLARE_GL_FUNCTION(query_counter, void, (GLuint id, GLenum target), glQueryCounter);
+            DECLARE_GL_FUNCTION(get_query_iv, void, (GLenum target, GLenum pname, GLint* params), glGetQueryiv);
+            DECLARE_GL_FUNCTION(get_query_object_uiv, void, (GLuint id, GLenum pname, GLuint* params), glGetQueryObjectuiv);
+            DECLARE_GL_FUNCTION(get_query_object_ui64v, void, (GLuint id, GLenum pname, GLuint64* params), glGetQueryObjectui64v);
+            DECLARE_GL_FUNCTION(get_integer64_v, void, (GLenum pname, GLint64* params), glGetInteger64v);
         };
 
         #undef DECLARE_GL_FUNCTION
@@ -72,6 +72,8 @@ namespace fixie
     }
 
     const gl_version gl_3_0 = gl_version(3, 0, open_gl);
+    const gl_version gl_3_2 = gl_version(3, 2, open_gl);
+    const gl_version gl_3_3 = gl_version(3, 3, open_gl);
     const gl_version gl_4_3 = gl_version(4, 3, open_gl);
     const gl_version gl_es_3_0 = gl_version(3, 0, open_gl_es);
     const gl_version gl_es_2_0 = gl_version(2, 0, open_gl_es);
@@ -38,6 +38,8 @@ namespace fixie
     };
 
     extern const gl_version gl_3_0;
+    extern const gl_version gl_3_2;
+    extern const gl_version gl_3_3;
     extern const gl_version gl_4_3;
     extern const gl_version gl_es_2_0;
     extern const gl_version gl_es_3_0;
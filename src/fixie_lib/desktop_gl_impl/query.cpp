@@ -0,0 +1,82 @@
+#include "fixie_lib/desktop_gl_impl/query.hpp"
+
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_ext.h"
+
+namespace fixie
+{
+    namespace desktop_gl_impl
+    {
+        #define GL_TIME_ELAPSED 0x88BF
+        #define GL_TIMESTAMP 0x8E28
+        #define GL_QUERY_RESULT 0x8866
+        #define GL_QUERY_RESULT_AVAILABLE 0x8867
+
+        static GLenum native_query_target(GLenum target)
+        {
+            switch (target)
+            {
+            case GL_TIME_ELAPSED_EXT:   return GL_TIME_ELAPSED;
+            case GL_TIMESTAMP_EXT:      return GL_TIMESTAMP;
+            default:                    return target;
+            }
+        }
+
+        query::query(std::shared_ptr<const gl_functions> functions)
+            : _functions(functions)
+            , _id(0)
+            , _result_available(GL_FALSE)
+            , _result(0)
+        {
+            gl_call(_functions, gen_queries, 1, &_id);
+        }
+
+        query::~query()
+        {
+            gl_call_nothrow(_functions, delete_queries, 1, &_id);
+        }
+
+        GLuint query::id() const
+        {
+            return _id;
+        }
+
+        void query::begin(GLenum target)
+        {
+            gl_call(_functions, begin_query, native_query_target(target), _id);
+            _result_available = GL_FALSE;
+        }
+
+        void query::end(GLenum target)
+        {
+            gl_call(_functions, end_query, native_query_target(target));
+        }
+
+        void query::query_counter(GLenum target)
+        {
+            gl_call(_functions, query_counter, _id, native_query_target(target));
+            _result_available = GL_FALSE;
+        }
+
+        GLboolean query::result_available()
+        {
+            if (!_result_available)
+            {
+                GLuint available = GL_FALSE;
+                gl_call(_functions, get_query_object_uiv, _id, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (available)
+                {
+                    gl_call(_functions, get_query_object_ui64v, _id, GL_QUERY_RESULT, &_result);
+                    _result_available = GL_TRUE;
+                }
+            }
+
+            return _result_available;
+        }
+
+        GLuint64 query::result()
+        {
+            return result_available() ? _result : 0;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef _FIXIE_LIB_DESKTOP_GL_QUERY_HPP_
+#define _FIXIE_LIB_DESKTOP_GL_QUERY_HPP_
+
+#include "fixie_lib/query.hpp"
+#include "fixie_lib/desktop_gl_impl/gl_functions.hpp"
+
+namespace fixie
+{
+    namespace desktop_gl_impl
+    {
+        class query : public fixie::query_impl
+        {
+        public:
+            explicit query(std::shared_ptr<const gl_functions> functions);
+            virtual ~query();
+
+            GLuint id() const;
+
+            virtual void begin(GLenum target) override;
+            virtual void end(GLenum target) override;
+            virtual void query_counter(GLenum target) override;
+            virtual GLboolean result_available() override;
+            virtual GLuint64 result() override;
+
+        private:
+            std::shared_ptr<const gl_functions> _functions;
+            GLuint _id;
+            GLboolean _result_available;
+            GLuint64 _result;
+        };
+    }
+}
+
+#endif // _FIXIE_LIB_DESKTOP_GL_QUERY_HPP_
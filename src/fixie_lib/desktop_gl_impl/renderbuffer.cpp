@@ -15,6 +15,7 @@ namespace fixie
         renderbuffer::renderbuffer(std::shared_ptr<const gl_functions> functions)
             : _functions(functions)
             , _id(0)
+            , _storage_revision(0)
         {
             gl_call(_functions, gen_renderbuffers, 1, &_id);
         }
@@ -29,6 +30,11 @@ namespace fixie
             return _id;
         }
 
+        GLuint renderbuffer::storage_revision() const
+        {
+            return _storage_revision;
+        }
+
         GLsizei renderbuffer::red_size() const
         {
             gl_call(_functions, bind_renderbuffer, GL_RENDERBUFFER, _id);
@@ -85,12 +91,14 @@ namespace fixie
 
         void renderbuffer::set_storage(GLenum target, GLenum internal_format, GLsizei width, GLsizei height)
         {
+            _storage_revision++;
             gl_call(_functions, bind_renderbuffer, GL_RENDERBUFFER, _id);
             gl_call(_functions, renderbuffer_storage, target, internal_format, width, height);
         }
 
         void renderbuffer::set_storage_multisample(GLenum target, GLsizei samples, GLenum internal_format, GLsizei width, GLsizei height)
         {
+            _storage_revision++;
             gl_call(_functions, bind_renderbuffer, GL_RENDERBUFFER, _id);
             gl_call(_functions, renderbuffer_storage_multisample, target, samples, internal_format, width, height);
         }
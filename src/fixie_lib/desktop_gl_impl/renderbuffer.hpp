@@ -16,6 +16,9 @@ namespace fixie
 
             GLuint id() const;
 
+            // Incremented whenever the storage is respecified
+            GLuint storage_revision() const;
+
             virtual GLsizei red_size() const override;
             virtual GLsizei green_size() const override;
             virtual GLsizei blue_size() const override;
@@ -29,6 +32,7 @@ namespace fixie
         private:
             std::shared_ptr<const gl_functions> _functions;
             GLuint _id;
+            GLuint _storage_revision;
         };
     }
 }
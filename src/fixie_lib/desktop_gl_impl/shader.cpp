@@ -2,9 +2,11 @@
 #include "fixie_lib/desktop_gl_impl/exceptions.hpp"
 #include "fixie_lib/util.hpp"
 #include "fixie_lib/debug.hpp"
+#include "fixie_lib/tracer.hpp"
 #include "fixie/fixie_gl_es.h"
 #include <sstream>
 #include <array>
+#include <algorithm>
 
 namespace fixie
 {
@@ -14,10 +16,19 @@ namespace fixie
     #define GL_FRAGMENT_SHADER 0x8B30
     #define GL_LINK_STATUS 0x8B82
 
+    #define upload_uniform(name, ...) \
+        do \
+        { \
+            gl_call(_functions, name, __VA_ARGS__); \
+            _statistics->uniform_uploads()++; \
+        } while (0)
+
     namespace desktop_gl_impl
     {
         static GLuint compile_shader(std::shared_ptr<const gl_functions> functions, const std::string& source, GLenum type)
         {
+            FIXIE_TRACE_SCOPE("shader", "compile_shader");
+
             GLuint shader = gl_call(functions, create_shader, type);
 
             std::array<const GLchar*, 1> source_array = {{ source.c_str() }};
@@ -59,6 +70,8 @@ namespace fixie
                 throw;
             }
 
+            FIXIE_TRACE_SCOPE("shader", "link_program");
+
             GLuint program = gl_call(functions, create_program);
             gl_call(functions, attach_shader, program, vertex_shader);
             gl_call(functions, delete_shader, vertex_shader);
@@ -136,6 +149,12 @@ namespace fixie
             }
         }
 
+        static std::string color_interpolation_qualifier_name(const shader_info& info)
+        {
+            // Flat varyings take the provoking vertex's value, the default last vertex convention matches ES 1.1
+            return (info.shade_model() == GL_FLAT) ? "flat " : "";
+        }
+
         static std::string uniform_qualifier_name()
         {
             return "uniform";
@@ -151,11 +170,51 @@ namespace fixie
             return "model_view_transform";
         }
 
+        static std::string model_view_projection_transform_name()
+        {
+            return "model_view_projection_transform";
+        }
+
         static std::string projection_transform_name()
         {
             return "projection_transform";
         }
 
+        static std::string palette_transforms_name()
+        {
+            return "palette_transforms";
+        }
+
+        static std::string palette_normal_transforms_name()
+        {
+            return "palette_normal_transforms";
+        }
+
+        static std::string matrix_index_name(shader_type type)
+        {
+            return format("matrix_index_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string weight_name(shader_type type)
+        {
+            return format("weight_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string instance_model_view_name(shader_type type)
+        {
+            return format("instance_model_view_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string instance_color_name(shader_type type)
+        {
+            return format("instance_color_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string normal_transform_name()
+        {
+            return "normal_transform";
+        }
+
         static std::string normal_name(shader_type type)
         {
             return format("normal_%s", shader_type_name(type).c_str());
@@ -166,6 +225,16 @@ namespace fixie
             return format("color_%s", shader_type_name(type).c_str());
         }
 
+        static std::string constant_color_name()
+        {
+            return "constant_color";
+        }
+
+        static std::string back_color_name(shader_type type)
+        {
+            return format("back_color_%s", shader_type_name(type).c_str());
+        }
+
         static std::string tex_coord_name(shader_type type, size_t i)
         {
             return format("texcoord_%u_%s", i, shader_type_name(type).c_str());
@@ -181,6 +250,115 @@ namespace fixie
             return format("sampler_%u", i);
         }
 
+        static std::string texture_sample_name(size_t i)
+        {
+            return format("texture_sample_%u", i);
+        }
+
+        static std::string texture_env_color_name(size_t i)
+        {
+            return format("texture_env_%u_color", i);
+        }
+
+        static std::string texture_env_result_name(size_t i)
+        {
+            return format("texture_env_%u_result", i);
+        }
+
+        static std::string point_size_name(shader_type type)
+        {
+            return format("point_size_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string constant_point_size_name()
+        {
+            return "constant_point_size";
+        }
+
+        static std::string point_size_range_name()
+        {
+            return "point_size_range";
+        }
+
+        static std::string point_distance_attenuation_name()
+        {
+            return "point_distance_attenuation";
+        }
+
+        static std::string texture_rect_name(shader_type type)
+        {
+            return format("texture_rect_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string texture_rect_depth_name(shader_type type)
+        {
+            return format("texture_rect_depth_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string viewport_name()
+        {
+            return "viewport";
+        }
+
+        static std::string clip_plane_name(size_t i)
+        {
+            return format("clip_plane_%u", i);
+        }
+
+        static std::string fog_coordinate_name(shader_type type)
+        {
+            return format("fog_coordinate_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string fog_factor_name(shader_type type)
+        {
+            return format("fog_factor_%s", shader_type_name(type).c_str());
+        }
+
+        static std::string fog_color_name()
+        {
+            return "fog_color";
+        }
+
+        static std::string fog_density_name()
+        {
+            return "fog_density";
+        }
+
+        static std::string fog_end_name()
+        {
+            return "fog_end";
+        }
+
+        static std::string fog_scale_name()
+        {
+            return "fog_scale";
+        }
+
+        static std::string fog_function_name()
+        {
+            return "compute_fog";
+        }
+
+        static std::string alpha_test_reference_name()
+        {
+            return "alpha_test_reference";
+        }
+
+        static std::string alpha_test_comparison_operator(GLenum func)
+        {
+            switch (func)
+            {
+            case GL_LESS:       return "<";
+            case GL_EQUAL:      return "==";
+            case GL_LEQUAL:     return "<=";
+            case GL_GREATER:    return ">";
+            case GL_NOTEQUAL:   return "!=";
+            case GL_GEQUAL:     return ">=";
+            default: UNREACHABLE(); return "";
+            }
+        }
+
         static std::string material_ambient_color_name()
         {
             return "material_ambient_color";
@@ -241,9 +419,14 @@ namespace fixie
             return format("light_%u_spotlight_exponent", i);
         }
 
-        static std::string light_spotlight_cutoff_name(size_t i)
+        static std::string light_spotlight_cutoff_cosine_name(size_t i)
+        {
+            return format("light_%u_spotlight_cutoff_cosine", i);
+        }
+
+        static std::string light_half_vector_name(size_t i)
         {
-            return format("light_%u_spotlight_cutoff", i);
+            return format("light_%u_half_vector", i);
         }
 
         static std::string light_constant_attenuation_name(size_t i)
@@ -261,249 +444,1012 @@ namespace fixie
             return format("light_%u_quadratic_attenuation", i);
         }
 
+        static std::string lighting_function_name()
+        {
+            return "compute_lighting";
+        }
+
         static std::string tab(size_t count)
         {
             return std::string(count * 4, ' ');
         }
 
-        static std::string generate_vertex_shader(const shader_info& info)
+        static void write_lighting_uniforms(std::ostream& shader, const shader_info& info)
         {
-            std::ostringstream vertex_shader;
-
-            vertex_shader << "#version " << shader_version() << std::endl;
-            vertex_shader << std::endl;
+            shader << uniform_qualifier_name() << " vec4 " << material_ambient_color_name() << ";" << std::endl;
+            shader << uniform_qualifier_name() << " vec4 " << material_diffuse_color_name() << ";" << std::endl;
+            shader << uniform_qualifier_name() << " vec4 " << material_specular_color_name() << ";" << std::endl;
+            shader << uniform_qualifier_name() << " float " << material_specular_exponent_name() << ";" << std::endl;
+            shader << uniform_qualifier_name() << " vec4 " << material_emissive_color_name() << ";" << std::endl;
+            shader << std::endl;
 
-            vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << vertex_name(vertex_input) << ";" << std::endl;
-            vertex_shader << type_qualifier_name(vertex_output)  << " vec4 " << vertex_name(vertex_output) << ";" << std::endl;
-            vertex_shader << uniform_qualifier_name() << " mat4 " << model_view_transform_name() << ";" << std::endl;
-            vertex_shader << uniform_qualifier_name() << " mat4 " << projection_transform_name() << ";" << std::endl;
-            vertex_shader << type_qualifier_name(vertex_input) << " vec3 " << normal_name(vertex_input) << ";" << std::endl;
-            vertex_shader << type_qualifier_name(vertex_output)  << " vec3 " << normal_name(vertex_output) << ";" << std::endl;
-            vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << color_name(vertex_input) << ";" << std::endl;
-            vertex_shader << type_qualifier_name(vertex_output) << " vec4 " << color_name(vertex_output) << ";" << std::endl;
-            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            for (size_t i = 0; i < info.light_count(); i++)
             {
-                if (info.texture_environment(i).texture_enabled())
+                if (info.uses_light(i))
                 {
-                    vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << tex_coord_name(vertex_input, i) << ";" << std::endl;
-                    vertex_shader << type_qualifier_name(vertex_output) << " vec4 " << tex_coord_name(vertex_output, i) << ";" << std::endl;
-                    vertex_shader << uniform_qualifier_name() << " mat4 " << tex_coord_transform_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " vec4 " << light_ambient_color_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " vec4 " << light_diffuse_color_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " vec4 " << light_specular_color_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " vec4 " << light_position_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " vec3 " << light_direction_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " float " << light_spotlight_exponent_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " float " << light_spotlight_cutoff_cosine_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " vec3 " << light_half_vector_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " float " << light_constant_attenuation_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " float " << light_linear_attenuation_name(i) << ";" << std::endl;
+                    shader << uniform_qualifier_name() << " float " << light_quadratic_attenuation_name(i) << ";" << std::endl;
+                    shader << std::endl;
                 }
             }
 
-            vertex_shader << std::endl;
-            vertex_shader << "void main(void)" << std::endl;
-            vertex_shader << "{" << std::endl;
-            vertex_shader << tab(1) << vertex_name(vertex_output) << " = " << model_view_transform_name() << " * " << vertex_name(vertex_input) << ";" << std::endl;
-            vertex_shader << tab(1) << normal_name(vertex_output) << " = mat3(" << model_view_transform_name() << ") * " << normal_name(vertex_input) << ";" << std::endl;
-            vertex_shader << tab(1) << color_name(vertex_output) << " = " << color_name(vertex_input) << ";" << std::endl;
-            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            shader << uniform_qualifier_name() << " vec4 " << scene_ambient_color_name() << ";" << std::endl;
+            shader << std::endl;
+        }
+
+        static void write_lighting_function(std::ostream& shader, const shader_info& info)
+        {
+            const std::string position_parameter_name = "position";
+            const std::string normal_parameter_name = "normal";
+            shader << "vec4 " << lighting_function_name() << "(vec3 " << position_parameter_name << ", vec3 " << normal_parameter_name << ")" << std::endl;
+            shader << "{" << std::endl;
+
+            const std::string lighting_result_name = "lighting_result";
+            shader << tab(1) << "vec3 " << lighting_result_name << " = " << material_emissive_color_name() << ".rgb + " << material_ambient_color_name() << ".rgb * " << scene_ambient_color_name() << ".rgb;" << std::endl;
+            shader << std::endl;
+            for (size_t i = 0; i < info.light_count(); i++)
             {
-                if (info.texture_environment(i).texture_enabled())
+                if (info.uses_light(i))
                 {
-                    vertex_shader << tab(1) << tex_coord_name(vertex_output, i) << " = " << tex_coord_transform_name(i) << " * " << tex_coord_name(vertex_input, i) << ";" << std::endl;
-                }
-            }
-            vertex_shader << std::endl;
-            vertex_shader << tab(1) << "gl_Position = (" << projection_transform_name() << " * "<< model_view_transform_name() << ") * " << vertex_name(vertex_input) << ";" << std::endl;
-            vertex_shader << "}" << std::endl;
+                    const std::string vertex_to_light_name = format("vertex_to_light_%u", i);
+                    const std::string vertex_to_light_direction_name = format("vertex_to_light_%u_direction", i);
+                    const std::string half_vector_name = format("light_%u_vertex_half_vector", i);
+                    const std::string attenuation_name = format("light_%u_attenuation", i);
+                    if (info.uses_positional_light(i))
+                    {
+                        shader << tab(1) << "vec3 " << vertex_to_light_name << " = " << light_position_name(i) << ".xyz - " << position_parameter_name << ";" << std::endl;
+                        shader << tab(1) << "vec3 " << vertex_to_light_direction_name << " = normalize(" << vertex_to_light_name << ");" << std::endl;
+                        shader << tab(1) << "vec3 " << half_vector_name << " = normalize(" << vertex_to_light_direction_name << " + vec3(0.0, 0.0, 1.0));" << std::endl;
+                    }
+                    else
+                    {
+                        shader << tab(1) << "vec3 " << vertex_to_light_direction_name << " = " << light_position_name(i) << ".xyz;" << std::endl;
+                        shader << tab(1) << "vec3 " << half_vector_name << " = " << light_half_vector_name(i) << ";" << std::endl;
+                    }
 
-            return vertex_shader.str();
-        }
+                    if (info.uses_light_attenuation(i))
+                    {
+                        const std::string vertex_to_light_distance_name = format("vertex_to_light_%u_distance", i);
+                        shader << tab(1) << "float " << vertex_to_light_distance_name << " = length(" << vertex_to_light_name << ");" << std::endl;
+
+                        const float attenuation_epsilon = 0.00001f;
+                        shader << tab(1) << "float " << attenuation_name << " = 1.0 / max(" <<
+                                                                 light_constant_attenuation_name(i) << " + (" <<
+                                                                 light_linear_attenuation_name(i) << " * " << vertex_to_light_distance_name << ") + (" <<
+                                                                 light_quadratic_attenuation_name(i) << " * " << vertex_to_light_distance_name << " * " << vertex_to_light_distance_name << "), " <<
+                                                                 attenuation_epsilon << ");" << std::endl;
+                    }
+                    else
+                    {
+                        shader << tab(1) << "float " << attenuation_name << " = 1.0;" << std::endl;
+                    }
 
-        static std::string generate_fragment_shader(const shader_info& info)
-        {
-            std::ostringstream fragment_shader;
+                    const std::string spot_factor_name = format("light_%u_spot_factor", i);
+                    if (info.uses_spot_light(i))
+                    {
+                        const std::string light_to_vertex_direction_name = format("light_%u_to_vertex_direction", i);
+                        shader << tab(1) << "vec3 " << light_to_vertex_direction_name << " = -" << vertex_to_light_direction_name << ";" << std::endl;
 
-            fragment_shader << "#version " << shader_version() << std::endl;
-            fragment_shader << std::endl;
+                        const std::string light_to_vertex_angle_name = format("light_%u_to_vertex_angle", i);
+                        shader << tab(1) << "float " << light_to_vertex_angle_name << " = dot(" << light_to_vertex_direction_name << ", " << light_direction_name(i) << ");" << std::endl;
 
-            fragment_shader << type_qualifier_name(fragment_input) << " vec4 " << vertex_name(fragment_input) << ";" << std::endl;
-            fragment_shader << type_qualifier_name(fragment_input) << " vec3 " << normal_name(fragment_input) << ";" << std::endl;
-            fragment_shader << type_qualifier_name(fragment_input) << " vec4 " << color_name(fragment_input) << ";" << std::endl;
-            fragment_shader << std::endl;
+                        shader << tab(1) << "float " << spot_factor_name << " = (" << light_to_vertex_angle_name << " >= " << light_spotlight_cutoff_cosine_name(i) << ") ? (" <<
+                                                                                                "pow(max(" << light_to_vertex_angle_name << ", 0.0), " << light_spotlight_exponent_name(i) << ")) : " <<
+                                                                                                "0.0;" << std::endl;
+                    }
+                    else
+                    {
+                        shader << tab(1) << "float " << spot_factor_name << " = 1.0;" << std::endl;
+                    }
 
-            for (size_t i = 0; i < info.texture_unit_count(); ++i)
-            {
-                if (info.texture_environment(i).texture_enabled())
-                {
-                    fragment_shader << "in vec4 " << tex_coord_name(fragment_input, i) << ";" << std::endl;
-                    fragment_shader << uniform_qualifier_name() << " sampler2D " << sampler_name(i) << ";" << std::endl;
-                    fragment_shader << std::endl;
+                    const std::string light_ambient_component_name = format("light_%u_ambient_component", i);
+                    shader << tab(1) << "vec3 " << light_ambient_component_name << " = " << material_ambient_color_name() << ".rgb * " << light_ambient_color_name(i) << ".rgb;" << std::endl;
+
+                    const std::string normal_dot_vertex_to_light_name = format("normal_dot_vertex_to_light_%u", i);
+                    shader << tab(1) << "float " << normal_dot_vertex_to_light_name << " = clamp(dot(" << normal_parameter_name << ", " << vertex_to_light_direction_name << "), 0.0, 1.0);" << std::endl;
+
+                    const std::string light_diffuse_component_name = format("light_%u_diffuse_component", i);
+                    shader << tab(1) << "vec3 " << light_diffuse_component_name << " = " << normal_dot_vertex_to_light_name << " * " << material_diffuse_color_name() << ".rgb * " << light_diffuse_color_name(i) << ".rgb;" << std::endl;
+
+                    const std::string light_specular_component_name = format("light_%u_specular_component", i);
+                    const float specular_epsilon = 0.00001f;
+                    shader << tab(1) << "vec3 " << light_specular_component_name << " = float(" << normal_dot_vertex_to_light_name << " != 0.0) * pow(clamp(dot(" << normal_parameter_name << ", " << half_vector_name << "), " << specular_epsilon <<", 1.0), " << material_specular_exponent_name() << ") * " << material_specular_color_name() << ".rgb * " << light_specular_color_name(i) << ".rgb;" << std::endl;
+
+                    shader << tab(1) << lighting_result_name << " += " << attenuation_name << " * " << spot_factor_name << " * (" << light_ambient_component_name << " + " << light_diffuse_component_name << " + " << light_specular_component_name << ");" << std::endl;
+                    shader << std::endl;
                 }
             }
+            shader << tab(1) << "return vec4(" << lighting_result_name << ", " << material_diffuse_color_name() << ".a);" << std::endl;
+            shader << "}" << std::endl;
+            shader << std::endl;
+        }
+
+        static void write_fog_function(std::ostream& shader, const shader_info& info)
+        {
+            if (info.fog_mode() == GL_LINEAR)
+            {
+                shader << uniform_qualifier_name() << " float " << fog_end_name() << ";" << std::endl;
+                shader << uniform_qualifier_name() << " float " << fog_scale_name() << ";" << std::endl;
+            }
+            else
+            {
+                shader << uniform_qualifier_name() << " float " << fog_density_name() << ";" << std::endl;
+            }
+            shader << std::endl;
 
-            if (info.lighting_enabled())
+            const std::string fog_coordinate_parameter_name = "fog_coordinate";
+            shader << "float " << fog_function_name() << "(float " << fog_coordinate_parameter_name << ")" << std::endl;
+            shader << "{" << std::endl;
+            switch (info.fog_mode())
             {
-                fragment_shader << uniform_qualifier_name() << " vec4 " << material_ambient_color_name() << ";" << std::endl;
-                fragment_shader << uniform_qualifier_name() << " vec4 " << material_diffuse_color_name() << ";" << std::endl;
-                fragment_shader << uniform_qualifier_name() << " vec4 " << material_specular_color_name() << ";" << std::endl;
-                fragment_shader << uniform_qualifier_name() << " float " << material_specular_exponent_name() << ";" << std::endl;
-                fragment_shader << uniform_qualifier_name() << " vec4 " << material_emissive_color_name() << ";" << std::endl;
-                fragment_shader << std::endl;
+            case GL_LINEAR:
+                shader << tab(1) << "return clamp((" << fog_end_name() << " - " << fog_coordinate_parameter_name << ") * " << fog_scale_name() << ", 0.0, 1.0);" << std::endl;
+                break;
 
-                for (size_t i = 0; i < info.light_count(); i++)
+            case GL_EXP:
+                shader << tab(1) << "return clamp(exp(-" << fog_density_name() << " * " << fog_coordinate_parameter_name << "), 0.0, 1.0);" << std::endl;
+                break;
+
+            case GL_EXP2:
                 {
-                    if (info.uses_light(i))
-                    {
-                        fragment_shader << uniform_qualifier_name() << " vec4 " << light_ambient_color_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " vec4 " << light_diffuse_color_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " vec4 " << light_specular_color_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " vec4 " << light_position_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " vec3 " << light_direction_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " float " << light_spotlight_exponent_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " float " << light_spotlight_cutoff_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " float " << light_constant_attenuation_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " float " << light_linear_attenuation_name(i) << ";" << std::endl;
-                        fragment_shader << uniform_qualifier_name() << " float " << light_quadratic_attenuation_name(i) << ";" << std::endl;
-                        fragment_shader << std::endl;
-                    }
+                    const std::string fog_exponent_name = "fog_exponent";
+                    shader << tab(1) << "float " << fog_exponent_name << " = " << fog_density_name() << " * " << fog_coordinate_parameter_name << ";" << std::endl;
+                    shader << tab(1) << "return clamp(exp(-" << fog_exponent_name << " * " << fog_exponent_name << "), 0.0, 1.0);" << std::endl;
                 }
+                break;
 
-                fragment_shader << uniform_qualifier_name() << " vec4 " << scene_ambient_color_name() << ";" << std::endl;
-                fragment_shader << std::endl;
+            default:
+                UNREACHABLE();
+                break;
             }
+            shader << "}" << std::endl;
+            shader << std::endl;
+        }
 
-            fragment_shader<< type_qualifier_name(fragment_output) << " vec4 " << color_name(fragment_output) << ";" << std::endl;
-            fragment_shader << std::endl;
+        static GLboolean texture_format_has_color(GLenum format)
+        {
+            return format != GL_ALPHA;
+        }
 
-            fragment_shader << "void main(void)" << std::endl;
-            fragment_shader << "{" << std::endl;
+        static GLboolean texture_format_has_alpha(GLenum format)
+        {
+            return format == GL_ALPHA || format == GL_LUMINANCE_ALPHA || format == GL_RGBA;
+        }
+
+        static size_t combine_argument_count(GLenum function)
+        {
+            switch (function)
+            {
+            case GL_REPLACE:        return 1;
+            case GL_INTERPOLATE:    return 3;
+            default:                return 2;
+            }
+        }
+
+        static std::vector<GLenum> texture_env_sources(const shader_info& info, size_t unit)
+        {
+            const texture_environment& env = info.texture_environment(unit);
 
-            const std::string local_normal_name = "local_normal";
-            fragment_shader << tab(1) << "vec3 " << local_normal_name << " = ";
-            if (info.two_sided_lighting())
+            std::vector<GLenum> sources;
+            if (env.mode() == GL_COMBINE)
             {
-                fragment_shader << "normalize(gl_FrontFacing ? " << normal_name(fragment_input) << " : -" << normal_name(fragment_input) << ");" << std::endl;
+                const std::array<GLenum, 3> rgb_sources = {{ env.source0_rgb(), env.source1_rgb(), env.source2_rgb() }};
+                sources.insert(end(sources), begin(rgb_sources), begin(rgb_sources) + combine_argument_count(env.combine_rgb()));
+
+                if (env.combine_rgb() != GL_DOT3_RGBA)
+                {
+                    const std::array<GLenum, 3> alpha_sources = {{ env.source0_alpha(), env.source1_alpha(), env.source2_alpha() }};
+                    sources.insert(end(sources), begin(alpha_sources), begin(alpha_sources) + combine_argument_count(env.combine_alpha()));
+                }
             }
             else
             {
-                fragment_shader << "normalize(" << normal_name(fragment_input) << ");" << std::endl;
+                sources.push_back(GL_TEXTURE);
+
+                GLenum texture_format = info.texture_format(unit);
+                if (env.mode() != GL_REPLACE || !texture_format_has_color(texture_format) || !texture_format_has_alpha(texture_format))
+                {
+                    sources.push_back(GL_PREVIOUS);
+                }
             }
+            return sources;
+        }
 
-            const std::string local_output_color_name = "result_color";
-            fragment_shader << tab(1) << "vec4 " << local_output_color_name << " = " << color_name(fragment_input) << ";" << std::endl;
+        // Walks the enabled units backwards, a unit is live if a later live unit reads GL_PREVIOUS from it
+        static std::vector<GLboolean> live_texture_units(const shader_info& info)
+        {
+            std::vector<GLboolean> live_units(info.texture_unit_count(), GL_FALSE);
 
-            const std::string texture_result_name = "texture_result";
-            fragment_shader << tab(1) << "vec4 " << texture_result_name << " = vec4(1.0, 1.0, 1.0, 1.0);" << std::endl;
-            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            GLboolean previous_live = GL_TRUE;
+            for (size_t i = info.texture_unit_count(); i-- > 0;)
             {
                 if (info.texture_environment(i).texture_enabled())
                 {
-                    const std::string texture_sample_name = format("texture_sample_%u", i);
-                    fragment_shader << tab(1) << "vec4 " << texture_sample_name << " = texture(" << sampler_name(i) << ", " << tex_coord_name(fragment_input, i) << ".xy);" << std::endl;
-                    fragment_shader << tab(1) << texture_result_name << " *= " << texture_sample_name << ";" << std::endl;
+                    live_units[i] = previous_live;
+                    if (live_units[i])
+                    {
+                        std::vector<GLenum> sources = texture_env_sources(info, i);
+                        previous_live = (std::find(begin(sources), end(sources), GL_PREVIOUS) != end(sources)) ? GL_TRUE : GL_FALSE;
+                    }
                 }
             }
-            fragment_shader << tab(1) << local_output_color_name << " *= " << texture_result_name << ";" << std::endl;
-            fragment_shader << std::endl;
 
-            if (info.lighting_enabled())
+            return live_units;
+        }
+
+        static std::vector<GLboolean> sampled_texture_units(const shader_info& info)
+        {
+            std::vector<GLboolean> live_units = live_texture_units(info);
+            std::vector<GLboolean> sampled_units(info.texture_unit_count(), GL_FALSE);
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
             {
-                const std::string lighting_result_name = "lighting_result";
-                fragment_shader << tab(1) << "vec3 " << lighting_result_name << " = " << material_emissive_color_name() << ".rgb + " << material_ambient_color_name() << ".rgb * " << scene_ambient_color_name() << ".rgb;" << std::endl;
-                fragment_shader << std::endl;
-                for (size_t i = 0; i < info.light_count(); i++)
+                if (live_units[i])
                 {
-                    if (info.uses_light(i))
+                    std::vector<GLenum> sources = texture_env_sources(info, i);
+                    for (auto iter = begin(sources); iter != end(sources); ++iter)
                     {
-                        const std::string vertex_to_light_name = format("vertex_to_light_%u", i);
-                        fragment_shader << tab(1) << "vec3 " << vertex_to_light_name << " = " << light_position_name(i) << ".xyz - " << vertex_name(fragment_input) << ".xyz;" << std::endl;
-
-                        const std::string vertex_to_light_direction_name = format("vertex_to_light_%u_direction", i);
-                        fragment_shader << tab(1) << "vec3 " << vertex_to_light_direction_name << " = normalize(" << vertex_to_light_name << ");" << std::endl;
-
-                        const std::string attenuation_name = format("light_%u_attenuation", i);
-                        if (info.uses_light_attenuation(i))
+                        size_t sampled_unit = (*iter == GL_TEXTURE) ? i : static_cast<size_t>(*iter - GL_TEXTURE0);
+                        if ((*iter == GL_TEXTURE || (*iter >= GL_TEXTURE0 && sampled_unit < info.texture_unit_count())) &&
+                            info.texture_environment(sampled_unit).texture_enabled())
                         {
-                            const std::string vertex_to_light_distance_name = format("vertex_to_light_%u_distance", i);
-                            fragment_shader << tab(1) << "float " << vertex_to_light_distance_name << " = length(" << vertex_to_light_name << ");" << std::endl;
-
-                            const float attenuation_epsilon = 0.00001f;
-                            fragment_shader << tab(1) << "float " << attenuation_name << " = 1.0 / max(" <<
-                                                                     light_constant_attenuation_name(i) << " + (" <<
-                                                                     light_linear_attenuation_name(i) << " * " << vertex_to_light_distance_name << ") + (" <<
-                                                                     light_quadratic_attenuation_name(i) << " * " << vertex_to_light_distance_name << " * " << vertex_to_light_distance_name << "), " <<
-                                                                     attenuation_epsilon << ");" << std::endl;
+                            sampled_units[sampled_unit] = GL_TRUE;
                         }
-                        else
-                        {
-                            fragment_shader << tab(1) << "float " << attenuation_name << " = 1.0;" << std::endl;
-                        }
-
-                        const std::string spot_factor_name = format("light_%u_spot_factor", i);
-                        if (info.uses_spot_light(i))
-                        {
-                            const std::string light_to_vertex_direction_name = format("light_%u_to_vertex_direction", i);
-                            fragment_shader << tab(1) << "vec3 " << light_to_vertex_direction_name << " = -" << vertex_to_light_direction_name << ";" << std::endl;
-
-                            const std::string light_to_vertex_angle_name = format("light_%u_to_vertex_angle", i);
-                            fragment_shader << tab(1) << "float " << light_to_vertex_angle_name << " = dot(" << light_to_vertex_direction_name << ", " << light_direction_name(i) << ");" << std::endl;
-
-                            fragment_shader << tab(1) << "float " << spot_factor_name << " = ( " << light_to_vertex_angle_name << " >= cos(" << light_spotlight_exponent_name(i) << ")) ? (" <<
-                                                                                                    "pow(" << light_to_vertex_angle_name << ", " << light_spotlight_exponent_name(i) << ")) : " <<
-                                                                                                    "0.0;" << std::endl;
-                        }
-                        else
-                        {
-                            fragment_shader << tab(1) << "float " << spot_factor_name << " = 1.0;" << std::endl;
-                        }
-
-                        const std::string light_ambient_component_name = format("light_%u_ambient_component", i);
-                        fragment_shader << tab(1) << "vec3 " << light_ambient_component_name << " = " << material_ambient_color_name() << ".rgb * " << light_ambient_color_name(i) << ".rgb;" << std::endl;
-
-                        const std::string normal_dot_vertex_to_light_name = format("normal_dot_vertex_to_light_%u", i);
-                        fragment_shader << tab(1) << "float " << normal_dot_vertex_to_light_name << " = clamp(dot(" << local_normal_name << ", " << vertex_to_light_direction_name << "), 0.0, 1.0);" << std::endl;
-
-                        const std::string light_diffuse_component_name = format("light_%u_diffuse_component", i);
-                        fragment_shader << tab(1) << "vec3 " << light_diffuse_component_name << " = " << normal_dot_vertex_to_light_name << " * " << material_diffuse_color_name() << ".rgb * " << light_diffuse_color_name(i) << ".rgb;" << std::endl;
-
-                        const std::string light_specular_component_name = format("light_%u_specular_component", i);
-                        const float specular_epsilon = 0.00001f;
-                        fragment_shader << tab(1) << "vec3 " << light_specular_component_name << " = float(" << normal_dot_vertex_to_light_name << " != 0.0) * pow(clamp(dot(" << local_normal_name << ", " << vertex_to_light_direction_name << " + vec3(0.0, 0.0, 1.0)), " << specular_epsilon <<", 1.0), " << material_specular_exponent_name() << ") * " << material_specular_color_name() << ".rgb * " << light_specular_color_name(i) << ".rgb;" << std::endl;
-
-                        fragment_shader << tab(1) << lighting_result_name << " += " << attenuation_name << " * " << spot_factor_name << " * (" << light_ambient_component_name << " + " << light_diffuse_component_name << " + " << light_specular_component_name << ");" << std::endl;
-                        fragment_shader << std::endl;
                     }
                 }
-                fragment_shader << tab(1) << local_output_color_name << " *= vec4(" << lighting_result_name << ", " << material_diffuse_color_name() << ".a);" << std::endl;
-                fragment_shader << std::endl;
             }
-
-            fragment_shader << tab(1) << color_name(fragment_output) << " = " << local_output_color_name << ";" << std::endl;
-            fragment_shader << "}" << std::endl;
-
-            return fragment_shader.str();
+            return sampled_units;
         }
 
-        shader::shader(const shader_info& info, std::shared_ptr<const gl_functions> functions)
-            : _functions(functions)
+        static GLboolean texture_env_uses_constant_color(const shader_info& info, size_t unit)
         {
-            _program = create_program(_functions, generate_vertex_shader(info), generate_fragment_shader(info));
-
-            gl_call(_functions, bind_frag_data_location, _program, 0, color_name(fragment_output).c_str());
-
-            _vertex_location = gl_call(_functions, get_attrib_location, _program, vertex_name(vertex_input).c_str());
-            _model_view_transform_location = gl_call(_functions, get_uniform_location, _program, model_view_transform_name().c_str());
-            _projection_transform_location = gl_call(_functions, get_uniform_location, _program, projection_transform_name().c_str());
+            if (info.texture_environment(unit).mode() == GL_BLEND)
+            {
+                return GL_TRUE;
+            }
+            std::vector<GLenum> sources = texture_env_sources(info, unit);
+            return (std::find(begin(sources), end(sources), GL_CONSTANT) != end(sources)) ? GL_TRUE : GL_FALSE;
+        }
 
-            _normal_location = gl_call(_functions, get_attrib_location, _program, normal_name(vertex_input).c_str());
-            _color_location = gl_call(_functions, get_attrib_location, _program, color_name(vertex_input).c_str());
+        static std::string texture_env_source(const shader_info& info, const std::vector<GLboolean>& sampled_units, size_t unit, GLenum source,
+                                              const std::string& primary_color, const std::string& previous_color)
+        {
+            switch (source)
+            {
+            case GL_TEXTURE:        return texture_sample_name(unit);
+            case GL_CONSTANT:       return texture_env_color_name(unit);
+            case GL_PRIMARY_COLOR:  return primary_color;
+            case GL_PREVIOUS:       return previous_color;
+            default:
+                {
+                    // Crossbar sources referencing a disabled unit are undefined, treat them as white
+                    size_t source_unit = static_cast<size_t>(source - GL_TEXTURE0);
+                    return (source_unit < sampled_units.size() && sampled_units[source_unit]) ? texture_sample_name(source_unit) : "vec4(1.0)";
+                }
+            }
+        }
 
-            _texcoord_locations.resize(info.texture_unit_count());
-            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+        static std::string texture_env_rgb_operand(const std::string& source, GLenum operand)
+        {
+            switch (operand)
             {
-                texcoord_uniform& uniform = _texcoord_locations[i];
-                uniform.texcoord_location = gl_call(_functions, get_attrib_location, _program, tex_coord_name(vertex_input, i).c_str());
-                uniform.texcoord_transform_location = gl_call(_functions, get_uniform_location, _program, tex_coord_transform_name(i).c_str());
-                uniform.sampler_location = gl_call(_functions, get_uniform_location, _program, sampler_name(i).c_str());
+            case GL_SRC_COLOR:              return format("%s.rgb", source.c_str());
+            case GL_ONE_MINUS_SRC_COLOR:    return format("(1.0 - %s.rgb)", source.c_str());
+            case GL_SRC_ALPHA:              return format("vec3(%s.a)", source.c_str());
+            case GL_ONE_MINUS_SRC_ALPHA:    return format("vec3(1.0 - %s.a)", source.c_str());
+            default: UNREACHABLE(); return "";
             }
+        }
 
-            _material_ambient_color_location = gl_call(_functions, get_uniform_location, _program, material_ambient_color_name().c_str());
+        static std::string texture_env_alpha_operand(const std::string& source, GLenum operand)
+        {
+            switch (operand)
+            {
+            case GL_SRC_ALPHA:              return format("%s.a", source.c_str());
+            case GL_ONE_MINUS_SRC_ALPHA:    return format("(1.0 - %s.a)", source.c_str());
+            default: UNREACHABLE(); return "";
+            }
+        }
+
+        static std::string texture_env_combine_function(GLenum function, const std::array<std::string, 3>& arguments)
+        {
+            switch (function)
+            {
+            case GL_REPLACE:        return arguments[0];
+            case GL_MODULATE:       return format("%s * %s", arguments[0].c_str(), arguments[1].c_str());
+            case GL_ADD:            return format("%s + %s", arguments[0].c_str(), arguments[1].c_str());
+            case GL_ADD_SIGNED:     return format("%s + %s - 0.5", arguments[0].c_str(), arguments[1].c_str());
+            case GL_INTERPOLATE:    return format("mix(%s, %s, %s)", arguments[1].c_str(), arguments[0].c_str(), arguments[2].c_str());
+            case GL_SUBTRACT:       return format("%s - %s", arguments[0].c_str(), arguments[1].c_str());
+            case GL_DOT3_RGB:
+            case GL_DOT3_RGBA:      return format("vec3(4.0 * dot(%s - 0.5, %s - 0.5))", arguments[0].c_str(), arguments[1].c_str());
+            default: UNREACHABLE(); return "";
+            }
+        }
+
+        static std::string texture_env_scale(const std::string& value, GLenum function, GLfloat scale)
+        {
+            // REPLACE, MODULATE and INTERPOLATE of [0, 1] arguments cannot leave [0, 1] unless scaled
+            GLboolean needs_clamp = (scale != 1.0f || (function != GL_REPLACE && function != GL_MODULATE && function != GL_INTERPOLATE));
+            std::string scaled = (scale != 1.0f) ? format("(%s) * %.1f", value.c_str(), scale) : value;
+            return needs_clamp ? format("clamp(%s, 0.0, 1.0)", scaled.c_str()) : scaled;
+        }
+
+        static void write_texture_env(std::ostream& shader, const shader_info& info, const std::vector<GLboolean>& sampled_units, size_t unit,
+                                      const std::string& primary_color, const std::string& previous_color)
+        {
+            const texture_environment& env = info.texture_environment(unit);
+            const std::string result_name = texture_env_result_name(unit);
+            const std::string sample = texture_sample_name(unit);
+            const std::string env_color = texture_env_color_name(unit);
+            const GLenum texture_format = info.texture_format(unit);
+
+            switch (env.mode())
+            {
+            case GL_REPLACE:
+                if (!texture_format_has_color(texture_format))
+                {
+                    shader << tab(1) << "vec4 " << result_name << " = vec4(" << previous_color << ".rgb, " << sample << ".a);" << std::endl;
+                }
+                else if (!texture_format_has_alpha(texture_format))
+                {
+                    shader << tab(1) << "vec4 " << result_name << " = vec4(" << sample << ".rgb, " << previous_color << ".a);" << std::endl;
+                }
+                else
+                {
+                    shader << tab(1) << "vec4 " << result_name << " = " << sample << ";" << std::endl;
+                }
+                break;
+
+            case GL_MODULATE:
+                if (!texture_format_has_color(texture_format))
+                {
+                    shader << tab(1) << "vec4 " << result_name << " = vec4(" << previous_color << ".rgb, " << previous_color << ".a * " << sample << ".a);" << std::endl;
+                }
+                else
+                {
+                    shader << tab(1) << "vec4 " << result_name << " = " << previous_color << " * " << sample << ";" << std::endl;
+                }
+                break;
+
+            case GL_DECAL:
+                shader << tab(1) << "vec4 " << result_name << " = vec4(mix(" << previous_color << ".rgb, " << sample << ".rgb, " << sample << ".a), " << previous_color << ".a);" << std::endl;
+                break;
+
+            case GL_BLEND:
+                shader << tab(1) << "vec4 " << result_name << " = vec4(mix(" << previous_color << ".rgb, " << env_color << ".rgb, " << sample << ".rgb), " << previous_color << ".a * " << sample << ".a);" << std::endl;
+                break;
+
+            case GL_ADD:
+                shader << tab(1) << "vec4 " << result_name << " = vec4(min(" << previous_color << ".rgb + " << sample << ".rgb, 1.0), " << previous_color << ".a * " << sample << ".a);" << std::endl;
+                break;
+
+            case GL_COMBINE:
+                {
+                    auto source = [&](GLenum source) { return texture_env_source(info, sampled_units, unit, source, primary_color, previous_color); };
+
+                    const std::string rgb_name = format("texture_env_%u_rgb", unit);
+                    const std::array<std::string, 3> rgb_arguments =
+                    {{
+                        texture_env_rgb_operand(source(env.source0_rgb()), env.operand0_rgb()),
+                        texture_env_rgb_operand(source(env.source1_rgb()), env.operand1_rgb()),
+                        texture_env_rgb_operand(source(env.source2_rgb()), env.operand2_rgb()),
+                    }};
+                    shader << tab(1) << "vec3 " << rgb_name << " = " << texture_env_scale(texture_env_combine_function(env.combine_rgb(), rgb_arguments), env.combine_rgb(), env.rgb_scale()) << ";" << std::endl;
+
+                    std::string alpha_value;
+                    if (env.combine_rgb() == GL_DOT3_RGBA)
+                    {
+                        alpha_value = format("%s.r", rgb_name.c_str());
+                    }
+                    else
+                    {
+                        const std::array<std::string, 3> alpha_arguments =
+                        {{
+                            texture_env_alpha_operand(source(env.source0_alpha()), env.operand0_alpha()),
+                            texture_env_alpha_operand(source(env.source1_alpha()), env.operand1_alpha()),
+                            texture_env_alpha_operand(source(env.source2_alpha()), env.operand2_alpha()),
+                        }};
+                        alpha_value = texture_env_scale(texture_env_combine_function(env.combine_alpha(), alpha_arguments), env.combine_alpha(), env.alpha_scale());
+                    }
+                    shader << tab(1) << "vec4 " << result_name << " = vec4(" << rgb_name << ", " << alpha_value << ");" << std::endl;
+                }
+                break;
+
+            default:
+                UNREACHABLE();
+                break;
+            }
+        }
+
+        static GLboolean uses_per_vertex_lighting(const shader_info& info)
+        {
+            return info.lighting_enabled() && !info.per_fragment_lighting();
+        }
+
+        static GLboolean uses_clip_planes(const shader_info& info)
+        {
+            return !equal_n<size_t>(0U, info.clip_plane_count(), [&](size_t i){ return info.uses_clip_plane(i) == GL_FALSE; });
+        }
+
+        static GLboolean uses_projection_transform(const shader_info& info)
+        {
+            return info.uses_matrix_palette() || info.uses_instance_model_view();
+        }
+
+        static GLboolean uses_eye_position(const shader_info& info)
+        {
+            return info.lighting_enabled() || info.fog_enabled() || uses_clip_planes(info) || info.uses_point_size_attenuation() || uses_projection_transform(info);
+        }
+
+        static GLboolean uses_point_coord(const shader_info& info, size_t unit)
+        {
+            return info.point_sprite_enabled() && info.texture_environment(unit).coord_replace();
+        }
+
+        static GLboolean uses_color_varying(const shader_info& info)
+        {
+            return info.uses_color_array() || info.uses_instance_color() || uses_per_vertex_lighting(info);
+        }
+
+        static void write_palette_skinning(std::ostream& shader, const shader_info& info, const std::string& eye_position_name, const std::string& eye_normal_name)
+        {
+            // Palette matrices replace the model view matrix, blend the eye space results of each vertex unit
+            shader << tab(1) << "vec4 " << eye_position_name << " = vec4(0.0);" << std::endl;
+            if (info.uses_normals())
+            {
+                shader << tab(1) << "vec3 " << eye_normal_name << " = vec3(0.0);" << std::endl;
+            }
+            for (size_t i = 0; i < info.vertex_unit_count(); ++i)
+            {
+                const std::string weight = format("%s[%u]", weight_name(vertex_input).c_str(), i);
+                const std::string matrix_index = format("int(%s[%u])", matrix_index_name(vertex_input).c_str(), i);
+                shader << tab(1) << eye_position_name << " += " << weight << " * (" << palette_transforms_name() << "[" << matrix_index << "] * " << vertex_name(vertex_input) << ");" << std::endl;
+                if (info.uses_normals())
+                {
+                    shader << tab(1) << eye_normal_name << " += " << weight << " * (" << palette_normal_transforms_name() << "[" << matrix_index << "] * " << normal_name(vertex_input) << ");" << std::endl;
+                }
+            }
+        }
+
+        static std::string generate_texture_rect_vertex_shader(const shader_info& info)
+        {
+            std::ostringstream vertex_shader;
+
+            vertex_shader << "#version " << shader_version() << std::endl;
+            vertex_shader << std::endl;
+
+            vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << texture_rect_name(vertex_input) << ";" << std::endl;
+            vertex_shader << type_qualifier_name(vertex_input) << " float " << texture_rect_depth_name(vertex_input) << ";" << std::endl;
+            vertex_shader << uniform_qualifier_name() << " vec4 " << viewport_name() << ";" << std::endl;
+            const std::vector<GLboolean> sampled_units = sampled_texture_units(info);
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (sampled_units[i])
+                {
+                    vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << tex_coord_name(vertex_input, i) << ";" << std::endl;
+                    vertex_shader << type_qualifier_name(vertex_output) << " vec4 " << tex_coord_name(vertex_output, i) << ";" << std::endl;
+                }
+            }
+            vertex_shader << std::endl;
+
+            // Each instance is one rectangle, the four strip vertices select its corners
+            const std::string corner_name = "corner";
+            const std::string window_position_name = "window_position";
+            vertex_shader << "void main(void)" << std::endl;
+            vertex_shader << "{" << std::endl;
+            vertex_shader << tab(1) << "vec2 " << corner_name << " = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));" << std::endl;
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (sampled_units[i])
+                {
+                    vertex_shader << tab(1) << tex_coord_name(vertex_output, i) << " = vec4(mix(" << tex_coord_name(vertex_input, i) << ".xy, "
+                                  << tex_coord_name(vertex_input, i) << ".zw, " << corner_name << "), 0.0, 1.0);" << std::endl;
+                }
+            }
+            vertex_shader << tab(1) << "vec2 " << window_position_name << " = " << texture_rect_name(vertex_input) << ".xy + " << corner_name << " * "
+                          << texture_rect_name(vertex_input) << ".zw;" << std::endl;
+            vertex_shader << std::endl;
+            vertex_shader << tab(1) << "gl_Position = vec4((" << window_position_name << " - " << viewport_name() << ".xy) / " << viewport_name() << ".zw * 2.0 - 1.0, "
+                          << texture_rect_depth_name(vertex_input) << " * 2.0 - 1.0, 1.0);" << std::endl;
+            vertex_shader << "}" << std::endl;
+
+            return vertex_shader.str();
+        }
+
+        static std::string generate_vertex_shader(const shader_info& info)
+        {
+            if (info.draws_texture_rects())
+            {
+                return generate_texture_rect_vertex_shader(info);
+            }
+
+            std::ostringstream vertex_shader;
+
+            vertex_shader << "#version " << shader_version() << std::endl;
+            vertex_shader << std::endl;
+
+            vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << vertex_name(vertex_input) << ";" << std::endl;
+            if (info.uses_matrix_palette())
+            {
+                vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << matrix_index_name(vertex_input) << ";" << std::endl;
+                vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << weight_name(vertex_input) << ";" << std::endl;
+                vertex_shader << uniform_qualifier_name() << " mat4 " << palette_transforms_name() << "[" << info.palette_matrix_count() << "];" << std::endl;
+                vertex_shader << uniform_qualifier_name() << " mat4 " << projection_transform_name() << ";" << std::endl;
+            }
+            else if (info.uses_instance_model_view())
+            {
+                vertex_shader << type_qualifier_name(vertex_input) << " mat4 " << instance_model_view_name(vertex_input) << ";" << std::endl;
+                vertex_shader << uniform_qualifier_name() << " mat4 " << projection_transform_name() << ";" << std::endl;
+            }
+            else
+            {
+                vertex_shader << uniform_qualifier_name() << " mat4 " << model_view_projection_transform_name() << ";" << std::endl;
+                if (uses_eye_position(info))
+                {
+                    vertex_shader << uniform_qualifier_name() << " mat4 " << model_view_transform_name() << ";" << std::endl;
+                }
+            }
+            for (size_t i = 0; i < info.clip_plane_count(); ++i)
+            {
+                if (info.uses_clip_plane(i))
+                {
+                    vertex_shader << uniform_qualifier_name() << " vec4 " << clip_plane_name(i) << ";" << std::endl;
+                }
+            }
+            if (info.per_fragment_lighting())
+            {
+                vertex_shader << type_qualifier_name(vertex_output)  << " vec4 " << vertex_name(vertex_output) << ";" << std::endl;
+            }
+            if (info.uses_normals())
+            {
+                vertex_shader << type_qualifier_name(vertex_input) << " vec3 " << normal_name(vertex_input) << ";" << std::endl;
+                if (info.uses_matrix_palette())
+                {
+                    vertex_shader << uniform_qualifier_name() << " mat3 " << palette_normal_transforms_name() << "[" << info.palette_matrix_count() << "];" << std::endl;
+                }
+                else if (!info.uses_instance_model_view())
+                {
+                    vertex_shader << uniform_qualifier_name() << " mat3 " << normal_transform_name() << ";" << std::endl;
+                }
+            }
+            if (info.per_fragment_lighting())
+            {
+                vertex_shader << type_qualifier_name(vertex_output)  << " vec3 " << normal_name(vertex_output) << ";" << std::endl;
+            }
+            if (info.uses_color_array())
+            {
+                vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << color_name(vertex_input) << ";" << std::endl;
+            }
+            else if (info.uses_instance_color())
+            {
+                vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << instance_color_name(vertex_input) << ";" << std::endl;
+            }
+            else if (uses_color_varying(info))
+            {
+                vertex_shader << uniform_qualifier_name() << " vec4 " << constant_color_name() << ";" << std::endl;
+            }
+            if (uses_color_varying(info))
+            {
+                vertex_shader << color_interpolation_qualifier_name(info) << type_qualifier_name(vertex_output) << " vec4 " << color_name(vertex_output) << ";" << std::endl;
+            }
+            if (uses_per_vertex_lighting(info) && info.two_sided_lighting())
+            {
+                vertex_shader << color_interpolation_qualifier_name(info) << type_qualifier_name(vertex_output) << " vec4 " << back_color_name(vertex_output) << ";" << std::endl;
+            }
+            const std::vector<GLboolean> sampled_units = sampled_texture_units(info);
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (sampled_units[i] && !uses_point_coord(info, i))
+                {
+                    vertex_shader << type_qualifier_name(vertex_input) << " vec4 " << tex_coord_name(vertex_input, i) << ";" << std::endl;
+                    vertex_shader << type_qualifier_name(vertex_output) << " vec4 " << tex_coord_name(vertex_output, i) << ";" << std::endl;
+                    if (!info.texture_matrix_identity(i))
+                    {
+                        vertex_shader << uniform_qualifier_name() << " mat4 " << tex_coord_transform_name(i) << ";" << std::endl;
+                    }
+                }
+            }
+
+            if (info.draws_points())
+            {
+                if (info.uses_point_size_array())
+                {
+                    vertex_shader << type_qualifier_name(vertex_input) << " float " << point_size_name(vertex_input) << ";" << std::endl;
+                }
+                else
+                {
+                    vertex_shader << uniform_qualifier_name() << " float " << constant_point_size_name() << ";" << std::endl;
+                }
+                vertex_shader << uniform_qualifier_name() << " vec2 " << point_size_range_name() << ";" << std::endl;
+                if (info.uses_point_size_attenuation())
+                {
+                    vertex_shader << uniform_qualifier_name() << " vec3 " << point_distance_attenuation_name() << ";" << std::endl;
+                }
+            }
+
+            if (info.per_fragment_fog())
+            {
+                vertex_shader << type_qualifier_name(vertex_output) << " float " << fog_coordinate_name(vertex_output) << ";" << std::endl;
+            }
+            else if (info.fog_enabled())
+            {
+                vertex_shader << type_qualifier_name(vertex_output) << " float " << fog_factor_name(vertex_output) << ";" << std::endl;
+            }
+
+            vertex_shader << std::endl;
+
+            if (uses_per_vertex_lighting(info))
+            {
+                write_lighting_uniforms(vertex_shader, info);
+                write_lighting_function(vertex_shader, info);
+            }
+
+            if (info.fog_enabled() && !info.per_fragment_fog())
+            {
+                write_fog_function(vertex_shader, info);
+            }
+
+            vertex_shader << "void main(void)" << std::endl;
+            vertex_shader << "{" << std::endl;
+
+            const std::string eye_position_name = "eye_position";
+            const std::string eye_normal_name = "eye_normal";
+            if (info.uses_matrix_palette())
+            {
+                write_palette_skinning(vertex_shader, info, eye_position_name, eye_normal_name);
+            }
+            else if (info.uses_instance_model_view())
+            {
+                // Instance matrices are arbitrary, the normal matrix has to be derived per vertex
+                vertex_shader << tab(1) << "vec4 " << eye_position_name << " = " << instance_model_view_name(vertex_input) << " * " << vertex_name(vertex_input) << ";" << std::endl;
+                if (info.uses_normals())
+                {
+                    vertex_shader << tab(1) << "vec3 " << eye_normal_name << " = transpose(inverse(mat3(" << instance_model_view_name(vertex_input) << "))) * "
+                                  << normal_name(vertex_input) << ";" << std::endl;
+                }
+            }
+            else
+            {
+                if (uses_eye_position(info))
+                {
+                    vertex_shader << tab(1) << "vec4 " << eye_position_name << " = " << model_view_transform_name() << " * " << vertex_name(vertex_input) << ";" << std::endl;
+                }
+                if (info.uses_normals())
+                {
+                    vertex_shader << tab(1) << "vec3 " << eye_normal_name << " = " << normal_transform_name() << " * " << normal_name(vertex_input) << ";" << std::endl;
+                }
+            }
+            if (info.uses_normals() && info.normalize_normals())
+            {
+                vertex_shader << tab(1) << eye_normal_name << " = normalize(" << eye_normal_name << ");" << std::endl;
+            }
+            if (info.per_fragment_lighting())
+            {
+                vertex_shader << tab(1) << vertex_name(vertex_output) << " = " << eye_position_name << ";" << std::endl;
+                vertex_shader << tab(1) << normal_name(vertex_output) << " = " << eye_normal_name << ";" << std::endl;
+            }
+
+            const std::string input_color_name = info.uses_color_array() ? color_name(vertex_input) :
+                                                 info.uses_instance_color() ? instance_color_name(vertex_input) : constant_color_name();
+            if (uses_per_vertex_lighting(info))
+            {
+                vertex_shader << tab(1) << color_name(vertex_output) << " = " << input_color_name << " * " << lighting_function_name() << "(" << eye_position_name << ".xyz, " << eye_normal_name << ");" << std::endl;
+                if (info.two_sided_lighting())
+                {
+                    vertex_shader << tab(1) << back_color_name(vertex_output) << " = " << input_color_name << " * " << lighting_function_name() << "(" << eye_position_name << ".xyz, -" << eye_normal_name << ");" << std::endl;
+                }
+            }
+            else if (uses_color_varying(info))
+            {
+                vertex_shader << tab(1) << color_name(vertex_output) << " = " << input_color_name << ";" << std::endl;
+            }
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (sampled_units[i] && !uses_point_coord(info, i))
+                {
+                    if (info.texture_matrix_identity(i))
+                    {
+                        vertex_shader << tab(1) << tex_coord_name(vertex_output, i) << " = " << tex_coord_name(vertex_input, i) << ";" << std::endl;
+                    }
+                    else
+                    {
+                        vertex_shader << tab(1) << tex_coord_name(vertex_output, i) << " = " << tex_coord_transform_name(i) << " * " << tex_coord_name(vertex_input, i) << ";" << std::endl;
+                    }
+                }
+            }
+            if (info.fog_enabled())
+            {
+                const std::string eye_distance = format("abs(%s.z)", eye_position_name.c_str());
+                if (info.per_fragment_fog())
+                {
+                    vertex_shader << tab(1) << fog_coordinate_name(vertex_output) << " = " << eye_distance << ";" << std::endl;
+                }
+                else
+                {
+                    vertex_shader << tab(1) << fog_factor_name(vertex_output) << " = " << fog_function_name() << "(" << eye_distance << ");" << std::endl;
+                }
+            }
+            for (size_t i = 0; i < info.clip_plane_count(); ++i)
+            {
+                if (info.uses_clip_plane(i))
+                {
+                    vertex_shader << tab(1) << "gl_ClipDistance[" << i << "] = dot(" << clip_plane_name(i) << ", " << eye_position_name << ");" << std::endl;
+                }
+            }
+            if (info.draws_points())
+            {
+                const std::string point_size_input_name = info.uses_point_size_array() ? point_size_name(vertex_input) : constant_point_size_name();
+                if (info.uses_point_size_attenuation())
+                {
+                    const std::string eye_distance_name = "eye_distance";
+                    vertex_shader << tab(1) << "float " << eye_distance_name << " = length(" << eye_position_name << ".xyz);" << std::endl;
+                    vertex_shader << tab(1) << "float point_size = " << point_size_input_name << " * inversesqrt(dot(" << point_distance_attenuation_name()
+                                  << ", vec3(1.0, " << eye_distance_name << ", " << eye_distance_name << " * " << eye_distance_name << ")));" << std::endl;
+                }
+                else
+                {
+                    vertex_shader << tab(1) << "float point_size = " << point_size_input_name << ";" << std::endl;
+                }
+                vertex_shader << tab(1) << "gl_PointSize = clamp(point_size, " << point_size_range_name() << ".x, " << point_size_range_name() << ".y);" << std::endl;
+            }
+            vertex_shader << std::endl;
+            if (uses_projection_transform(info))
+            {
+                vertex_shader << tab(1) << "gl_Position = " << projection_transform_name() << " * " << eye_position_name << ";" << std::endl;
+            }
+            else
+            {
+                vertex_shader << tab(1) << "gl_Position = " << model_view_projection_transform_name() << " * " << vertex_name(vertex_input) << ";" << std::endl;
+            }
+            vertex_shader << "}" << std::endl;
+
+            return vertex_shader.str();
+        }
+
+        static std::string generate_fragment_shader(const shader_info& info)
+        {
+            std::ostringstream fragment_shader;
+
+            fragment_shader << "#version " << shader_version() << std::endl;
+            fragment_shader << std::endl;
+
+            if (info.per_fragment_lighting())
+            {
+                fragment_shader << type_qualifier_name(fragment_input) << " vec4 " << vertex_name(fragment_input) << ";" << std::endl;
+                fragment_shader << type_qualifier_name(fragment_input) << " vec3 " << normal_name(fragment_input) << ";" << std::endl;
+            }
+            if (uses_color_varying(info))
+            {
+                fragment_shader << color_interpolation_qualifier_name(info) << type_qualifier_name(fragment_input) << " vec4 " << color_name(fragment_input) << ";" << std::endl;
+            }
+            else
+            {
+                fragment_shader << uniform_qualifier_name() << " vec4 " << constant_color_name() << ";" << std::endl;
+            }
+            if (uses_per_vertex_lighting(info) && info.two_sided_lighting())
+            {
+                fragment_shader << color_interpolation_qualifier_name(info) << type_qualifier_name(fragment_input) << " vec4 " << back_color_name(fragment_input) << ";" << std::endl;
+            }
+            fragment_shader << std::endl;
+
+            const std::vector<GLboolean> live_units = live_texture_units(info);
+            const std::vector<GLboolean> sampled_units = sampled_texture_units(info);
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (sampled_units[i])
+                {
+                    if (!uses_point_coord(info, i))
+                    {
+                        fragment_shader << type_qualifier_name(fragment_input) << " vec4 " << tex_coord_name(fragment_input, i) << ";" << std::endl;
+                    }
+                    fragment_shader << uniform_qualifier_name() << " sampler2D " << sampler_name(i) << ";" << std::endl;
+                }
+                if (live_units[i] && texture_env_uses_constant_color(info, i))
+                {
+                    fragment_shader << uniform_qualifier_name() << " vec4 " << texture_env_color_name(i) << ";" << std::endl;
+                }
+                if (sampled_units[i] || live_units[i])
+                {
+                    fragment_shader << std::endl;
+                }
+            }
+
+            if (info.per_fragment_lighting())
+            {
+                write_lighting_uniforms(fragment_shader, info);
+                write_lighting_function(fragment_shader, info);
+            }
+
+            if (info.fog_enabled())
+            {
+                if (info.per_fragment_fog())
+                {
+                    fragment_shader << type_qualifier_name(fragment_input) << " float " << fog_coordinate_name(fragment_input) << ";" << std::endl;
+                }
+                else
+                {
+                    fragment_shader << type_qualifier_name(fragment_input) << " float " << fog_factor_name(fragment_input) << ";" << std::endl;
+                }
+                fragment_shader << uniform_qualifier_name() << " vec4 " << fog_color_name() << ";" << std::endl;
+                fragment_shader << std::endl;
+            }
+
+            if (info.per_fragment_fog())
+            {
+                write_fog_function(fragment_shader, info);
+            }
+
+            if (info.alpha_test_func() != GL_ALWAYS && info.alpha_test_func() != GL_NEVER)
+            {
+                fragment_shader << uniform_qualifier_name() << " float " << alpha_test_reference_name() << ";" << std::endl;
+                fragment_shader << std::endl;
+            }
+
+            fragment_shader<< type_qualifier_name(fragment_output) << " vec4 " << color_name(fragment_output) << ";" << std::endl;
+            fragment_shader << std::endl;
+
+            fragment_shader << "void main(void)" << std::endl;
+            fragment_shader << "{" << std::endl;
+
+            const std::string local_output_color_name = "result_color";
+            const std::string primary_color_name = "primary_color";
+            const std::string input_color_name = uses_color_varying(info) ? color_name(fragment_input) : constant_color_name();
+            if (uses_per_vertex_lighting(info) && info.two_sided_lighting())
+            {
+                fragment_shader << tab(1) << "vec4 " << primary_color_name << " = gl_FrontFacing ? " << input_color_name << " : " << back_color_name(fragment_input) << ";" << std::endl;
+            }
+            else
+            {
+                fragment_shader << tab(1) << "vec4 " << primary_color_name << " = " << input_color_name << ";" << std::endl;
+            }
+
+            if (info.per_fragment_lighting())
+            {
+                const std::string local_normal_name = "local_normal";
+                fragment_shader << tab(1) << "vec3 " << local_normal_name << " = ";
+                if (info.two_sided_lighting())
+                {
+                    fragment_shader << "normalize(gl_FrontFacing ? " << normal_name(fragment_input) << " : -" << normal_name(fragment_input) << ");" << std::endl;
+                }
+                else
+                {
+                    fragment_shader << "normalize(" << normal_name(fragment_input) << ");" << std::endl;
+                }
+                fragment_shader << tab(1) << primary_color_name << " *= " << lighting_function_name() << "(" << vertex_name(fragment_input) << ".xyz, " << local_normal_name << ");" << std::endl;
+            }
+            fragment_shader << std::endl;
+
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (sampled_units[i])
+                {
+                    const std::string tex_coord = uses_point_coord(info, i) ? "gl_PointCoord" : format("%s.xy", tex_coord_name(fragment_input, i).c_str());
+                    fragment_shader << tab(1) << "vec4 " << texture_sample_name(i) << " = texture(" << sampler_name(i) << ", " << tex_coord << ");" << std::endl;
+                }
+            }
+
+            std::string previous_color_name = primary_color_name;
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                if (live_units[i])
+                {
+                    write_texture_env(fragment_shader, info, sampled_units, i, primary_color_name, previous_color_name);
+                    previous_color_name = texture_env_result_name(i);
+                }
+            }
+            fragment_shader << tab(1) << "vec4 " << local_output_color_name << " = " << previous_color_name << ";" << std::endl;
+            fragment_shader << std::endl;
+
+            if (info.fog_enabled())
+            {
+                const std::string fog_factor_result_name = "fog_factor";
+                if (info.per_fragment_fog())
+                {
+                    fragment_shader << tab(1) << "float " << fog_factor_result_name << " = " << fog_function_name() << "(" << fog_coordinate_name(fragment_input) << ");" << std::endl;
+                }
+                else
+                {
+                    fragment_shader << tab(1) << "float " << fog_factor_result_name << " = " << fog_factor_name(fragment_input) << ";" << std::endl;
+                }
+                fragment_shader << tab(1) << local_output_color_name << ".rgb = mix(" << fog_color_name() << ".rgb, " << local_output_color_name << ".rgb, " << fog_factor_result_name << ");" << std::endl;
+                fragment_shader << std::endl;
+            }
+
+            // Only emit a discard when alpha testing can reject fragments so early depth testing stays enabled
+            if (info.alpha_test_func() == GL_NEVER)
+            {
+                fragment_shader << tab(1) << "discard;" << std::endl;
+                fragment_shader << std::endl;
+            }
+            else if (info.alpha_test_func() != GL_ALWAYS)
+            {
+                fragment_shader << tab(1) << "if (!(" << local_output_color_name << ".a " << alpha_test_comparison_operator(info.alpha_test_func()) << " " << alpha_test_reference_name() << "))" << std::endl;
+                fragment_shader << tab(1) << "{" << std::endl;
+                fragment_shader << tab(2) << "discard;" << std::endl;
+                fragment_shader << tab(1) << "}" << std::endl;
+                fragment_shader << std::endl;
+            }
+
+            fragment_shader << tab(1) << color_name(fragment_output) << " = " << local_output_color_name << ";" << std::endl;
+            fragment_shader << "}" << std::endl;
+
+            return fragment_shader.str();
+        }
+
+        shader::shader(const shader_info& info, std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics)
+            : _functions(functions)
+            , _statistics(statistics)
+            , _lighting_enabled(info.lighting_enabled() != GL_FALSE)
+            , _model_view_version(0)
+            , _projection_version(0)
+            , _model_view_projection()
+        {
+            std::string vertex_source;
+            std::string fragment_source;
+            {
+                FIXIE_TRACE_SCOPE("shader", "generate_shader");
+                vertex_source = generate_vertex_shader(info);
+                fragment_source = generate_fragment_shader(info);
+            }
+            _program = create_program(_functions, vertex_source, fragment_source);
+
+            gl_call(_functions, bind_frag_data_location, _program, 0, color_name(fragment_output).c_str());
+
+            _vertex_location = gl_call(_functions, get_attrib_location, _program, vertex_name(vertex_input).c_str());
+            _model_view_transform_location = gl_call(_functions, get_uniform_location, _program, model_view_transform_name().c_str());
+            _model_view_projection_transform_location = gl_call(_functions, get_uniform_location, _program, model_view_projection_transform_name().c_str());
+            _projection_transform_location = gl_call(_functions, get_uniform_location, _program, projection_transform_name().c_str());
+            _normal_transform_location = gl_call(_functions, get_uniform_location, _program, normal_transform_name().c_str());
+
+            _normal_location = gl_call(_functions, get_attrib_location, _program, normal_name(vertex_input).c_str());
+            _color_location = gl_call(_functions, get_attrib_location, _program, color_name(vertex_input).c_str());
+            _constant_color_location = gl_call(_functions, get_uniform_location, _program, constant_color_name().c_str());
+
+            _point_size_location = gl_call(_functions, get_attrib_location, _program, point_size_name(vertex_input).c_str());
+            _matrix_index_location = gl_call(_functions, get_attrib_location, _program, matrix_index_name(vertex_input).c_str());
+            _weight_location = gl_call(_functions, get_attrib_location, _program, weight_name(vertex_input).c_str());
+            _palette_transforms_location = gl_call(_functions, get_uniform_location, _program, format("%s[0]", palette_transforms_name().c_str()).c_str());
+            _palette_normal_transforms_location = gl_call(_functions, get_uniform_location, _program, format("%s[0]", palette_normal_transforms_name().c_str()).c_str());
+            _palette_versions.resize(info.palette_matrix_count(), 0);
+
+            _instance_model_view_location = gl_call(_functions, get_attrib_location, _program, instance_model_view_name(vertex_input).c_str());
+            _instance_color_location = gl_call(_functions, get_attrib_location, _program, instance_color_name(vertex_input).c_str());
+
+            _texture_rect_location = gl_call(_functions, get_attrib_location, _program, texture_rect_name(vertex_input).c_str());
+            _texture_rect_depth_location = gl_call(_functions, get_attrib_location, _program, texture_rect_depth_name(vertex_input).c_str());
+            _viewport_location = gl_call(_functions, get_uniform_location, _program, viewport_name().c_str());
+            _constant_point_size_location = gl_call(_functions, get_uniform_location, _program, constant_point_size_name().c_str());
+            _point_size_range_location = gl_call(_functions, get_uniform_location, _program, point_size_range_name().c_str());
+            _point_distance_attenuation_location = gl_call(_functions, get_uniform_location, _program, point_distance_attenuation_name().c_str());
+
+            _texcoord_locations.resize(info.texture_unit_count());
+            for (size_t i = 0; i < info.texture_unit_count(); ++i)
+            {
+                texcoord_uniform& uniform = _texcoord_locations[i];
+                uniform.texcoord_location = gl_call(_functions, get_attrib_location, _program, tex_coord_name(vertex_input, i).c_str());
+                uniform.texcoord_transform_location = gl_call(_functions, get_uniform_location, _program, tex_coord_transform_name(i).c_str());
+                uniform.sampler_location = gl_call(_functions, get_uniform_location, _program, sampler_name(i).c_str());
+                uniform.env_color_location = gl_call(_functions, get_uniform_location, _program, texture_env_color_name(i).c_str());
+                uniform.texcoord_transform_version = 0;
+                uniform.sampler_uploaded = false;
+                uniform.env_color_uploaded = false;
+            }
+
+            _material_ambient_color_location = gl_call(_functions, get_uniform_location, _program, material_ambient_color_name().c_str());
             _material_diffuse_color_location = gl_call(_functions, get_uniform_location, _program, material_diffuse_color_name().c_str());
             _material_specular_color_location = gl_call(_functions, get_uniform_location, _program, material_specular_color_name().c_str());
             _material_specular_exponent_location = gl_call(_functions, get_uniform_location, _program, material_specular_exponent_name().c_str());
             _material_emissive_color_location = gl_call(_functions, get_uniform_location, _program, material_emissive_color_name().c_str());
+            _material_uploaded = false;
 
             _light_locations.resize(info.light_count());
             for (size_t i = 0; i < info.light_count(); i++)
@@ -515,13 +1461,31 @@ namespace fixie
                 uniform.position_location = gl_call(_functions, get_uniform_location, _program, light_position_name(i).c_str());
                 uniform.spot_direction_location = gl_call(_functions, get_uniform_location, _program, light_direction_name(i).c_str());
                 uniform.spot_exponent_location = gl_call(_functions, get_uniform_location, _program, light_spotlight_exponent_name(i).c_str());
-                uniform.spot_cutoff_location = gl_call(_functions, get_uniform_location, _program, light_spotlight_cutoff_name(i).c_str());
+                uniform.spot_cutoff_cosine_location = gl_call(_functions, get_uniform_location, _program, light_spotlight_cutoff_cosine_name(i).c_str());
+                uniform.half_vector_location = gl_call(_functions, get_uniform_location, _program, light_half_vector_name(i).c_str());
                 uniform.constant_attenuation_location = gl_call(_functions, get_uniform_location, _program, light_constant_attenuation_name(i).c_str());
                 uniform.linear_attenuation_location = gl_call(_functions, get_uniform_location, _program, light_linear_attenuation_name(i).c_str());
                 uniform.quadratic_attenuation_location = gl_call(_functions, get_uniform_location, _program, light_quadratic_attenuation_name(i).c_str());
+                uniform.uploaded = false;
             }
 
             _scene_ambient_color_location = gl_call(_functions, get_uniform_location, _program, scene_ambient_color_name().c_str());
+            _scene_ambient_color_uploaded = false;
+            _fog_color_location = gl_call(_functions, get_uniform_location, _program, fog_color_name().c_str());
+            _fog_density_location = gl_call(_functions, get_uniform_location, _program, fog_density_name().c_str());
+            _fog_end_location = gl_call(_functions, get_uniform_location, _program, fog_end_name().c_str());
+            _fog_scale_location = gl_call(_functions, get_uniform_location, _program, fog_scale_name().c_str());
+            _fog_uploaded = false;
+
+            _alpha_test_reference_location = gl_call(_functions, get_uniform_location, _program, alpha_test_reference_name().c_str());
+
+            for (size_t i = 0; i < info.clip_plane_count(); i++)
+            {
+                if (info.uses_clip_plane(i))
+                {
+                    _clip_plane_locations[i] = gl_call(_functions, get_uniform_location, _program, clip_plane_name(i).c_str());
+                }
+            }
         }
 
         shader::~shader()
@@ -532,41 +1496,207 @@ namespace fixie
         void shader::sync_state(const state& state)
         {
             gl_call(_functions, use_program, _program);
-            gl_call(_functions, uniform_matrix_4fv, _model_view_transform_location, 1, GL_FALSE, state.model_view_matrix_stack().top_multiplied().data());
-            gl_call(_functions, uniform_matrix_4fv, _projection_transform_location, 1, GL_FALSE, state.projection_matrix_stack().top_multiplied().data());
 
-            for (size_t i = 0; i < _texcoord_locations.size(); i++)
+            const matrix_stack& model_view_stack = state.model_view_matrix_stack();
+            const matrix_stack& projection_stack = state.projection_matrix_stack();
+            bool model_view_changed = model_view_stack.version() != _model_view_version;
+            bool projection_changed = projection_stack.version() != _projection_version;
+            if (model_view_changed && _model_view_transform_location != -1)
+            {
+                upload_uniform(uniform_matrix_4fv, _model_view_transform_location, 1, GL_FALSE, model_view_stack.top_multiplied().data());
+            }
+            if (model_view_changed && _normal_transform_location != -1)
             {
-                const texcoord_uniform& uniform = _texcoord_locations[i];
-                gl_call(_functions, uniform_matrix_4fv, uniform.texcoord_transform_location, 1, GL_FALSE, state.texture_matrix_stack(i).top_multiplied().data());
-                gl_call(_functions, uniform_1i, uniform.sampler_location, static_cast<GLint>(i));
+                const matrix4& inverse_transpose = model_view_stack.top_inverse_transpose();
+                std::array<GLfloat, 9> normal_transform =
+                {{
+                    inverse_transpose(0, 0), inverse_transpose(1, 0), inverse_transpose(2, 0),
+                    inverse_transpose(0, 1), inverse_transpose(1, 1), inverse_transpose(2, 1),
+                    inverse_transpose(0, 2), inverse_transpose(1, 2), inverse_transpose(2, 2),
+                }};
+                upload_uniform(uniform_matrix_3fv, _normal_transform_location, 1, GL_FALSE, normal_transform.data());
             }
+            if ((model_view_changed || projection_changed) && _model_view_projection_transform_location != -1)
+            {
+                _model_view_projection = projection_stack.top_multiplied() * model_view_stack.top_multiplied();
+                upload_uniform(uniform_matrix_4fv, _model_view_projection_transform_location, 1, GL_FALSE, _model_view_projection.data());
+            }
+            if (projection_changed && _projection_transform_location != -1)
+            {
+                upload_uniform(uniform_matrix_4fv, _projection_transform_location, 1, GL_FALSE, projection_stack.top_multiplied().data());
+            }
+            _model_view_version = model_view_stack.version();
+            _projection_version = projection_stack.version();
 
-            const material& material = state.lighting_state().front_material();
-            gl_call(_functions, uniform_4fv, _material_ambient_color_location, 1, material.ambient().data());
-            gl_call(_functions, uniform_4fv, _material_diffuse_color_location, 1, material.diffuse().data());
-            gl_call(_functions, uniform_4fv, _material_specular_color_location, 1, material.specular().data());
-            gl_call(_functions, uniform_1f, _material_specular_exponent_location, material.specular_exponent());
-            gl_call(_functions, uniform_4fv, _material_emissive_color_location, 1, material.emissive().data());
+            bool palette_changed = false;
+            for (size_t i = 0; i < _palette_versions.size(); i++)
+            {
+                palette_changed = palette_changed || state.palette_matrix_stack(i).version() != _palette_versions[i];
+                _palette_versions[i] = state.palette_matrix_stack(i).version();
+            }
+            if (palette_changed && _palette_transforms_location != -1)
+            {
+                std::vector<GLfloat> palette_transforms(_palette_versions.size() * 16);
+                for (size_t i = 0; i < _palette_versions.size(); i++)
+                {
+                    std::copy_n(state.palette_matrix_stack(i).top_multiplied().data(), 16, palette_transforms.data() + i * 16);
+                }
+                upload_uniform(uniform_matrix_4fv, _palette_transforms_location, static_cast<GLsizei>(_palette_versions.size()), GL_FALSE, palette_transforms.data());
+            }
+            if (palette_changed && _palette_normal_transforms_location != -1)
+            {
+                std::vector<GLfloat> palette_normal_transforms(_palette_versions.size() * 9);
+                for (size_t i = 0; i < _palette_versions.size(); i++)
+                {
+                    const matrix4& inverse_transpose = state.palette_matrix_stack(i).top_inverse_transpose();
+                    GLfloat* normal_transform = palette_normal_transforms.data() + i * 9;
+                    for (size_t column = 0; column < 3; column++)
+                    {
+                        for (size_t row = 0; row < 3; row++)
+                        {
+                            normal_transform[column * 3 + row] = inverse_transpose(row, column);
+                        }
+                    }
+                }
+                upload_uniform(uniform_matrix_3fv, _palette_normal_transforms_location, static_cast<GLsizei>(_palette_versions.size()), GL_FALSE, palette_normal_transforms.data());
+            }
 
-            for (size_t i = 0; i < _light_locations.size(); i++)
+            if (_viewport_location != -1)
             {
-                const light_uniform& uniform = _light_locations[i];
-                const light& light = state.lighting_state().light(i);
-                gl_call(_functions, uniform_4fv, uniform.ambient_color_location, 1, light.ambient().data());
-                gl_call(_functions, uniform_4fv, uniform.diffuse_color_location, 1, light.diffuse().data());
-                gl_call(_functions, uniform_4fv, uniform.specular_color_location, 1, light.specular().data());
-                gl_call(_functions, uniform_4fv, uniform.position_location, 1, light.position().data());
-                gl_call(_functions, uniform_3fv, uniform.spot_direction_location, 1, light.spot_direction().data());
-                gl_call(_functions, uniform_1f, uniform.spot_exponent_location, light.spot_exponent());
-                gl_call(_functions, uniform_1f, uniform.spot_cutoff_location, light.spot_cutoff());
-                gl_call(_functions, uniform_1f, uniform.constant_attenuation_location, light.constant_attenuation());
-                gl_call(_functions, uniform_1f, uniform.linear_attenuation_location, light.linear_attenuation());
-                gl_call(_functions, uniform_1f, uniform.quadratic_attenuation_location, light.quadratic_attenuation());
+                const rectangle& viewport = state.viewport_state().viewport();
+                upload_uniform(uniform_4f, _viewport_location, static_cast<GLfloat>(viewport.x()), static_cast<GLfloat>(viewport.y()),
+                        static_cast<GLfloat>(viewport.width()), static_cast<GLfloat>(viewport.height()));
             }
 
-            const light_model& light_model = state.lighting_state().light_model();
-            gl_call(_functions, uniform_4fv, _scene_ambient_color_location, 1, light_model.ambient_color().data());
+            for (auto iter = begin(_clip_plane_locations); iter != end(_clip_plane_locations); ++iter)
+            {
+                upload_uniform(uniform_4fv, iter->second, 1, state.clip_plane(iter->first).equation().data());
+            }
+
+            const fog_state& fog_state = state.fog_state();
+            if (fog_state.fog_enabled() && (!_fog_uploaded || _uploaded_fog_state != fog_state))
+            {
+                const range& fog_range = fog_state.fog_range();
+                GLfloat fog_distance = fog_range.far() - fog_range.near();
+                GLfloat fog_scale = (fog_distance != 0.0f) ? 1.0f / fog_distance : 0.0f;
+
+                upload_uniform(uniform_4fv, _fog_color_location, 1, fog_state.fog_color().data());
+                upload_uniform(uniform_1f, _fog_density_location, fog_state.fog_density());
+                upload_uniform(uniform_1f, _fog_end_location, fog_range.far());
+                upload_uniform(uniform_1f, _fog_scale_location, fog_scale);
+
+                _uploaded_fog_state = fog_state;
+                _fog_uploaded = true;
+            }
+
+            if (_alpha_test_reference_location != -1)
+            {
+                upload_uniform(uniform_1f, _alpha_test_reference_location, state.color_buffer_state().alpha_test_ref());
+            }
+
+            if (_constant_color_location != -1)
+            {
+                std::shared_ptr<const fixie::vertex_array> vertex_array = state.bound_vertex_array().lock();
+                if (vertex_array != nullptr)
+                {
+                    upload_uniform(uniform_4fv, _constant_color_location, 1, vertex_array->color_attribute().generic_values().data());
+                }
+            }
+
+            const point_state& point_state = state.point_state();
+            if (_constant_point_size_location != -1)
+            {
+                upload_uniform(uniform_1f, _constant_point_size_location, point_state.point_size());
+            }
+            if (_point_size_range_location != -1)
+            {
+                upload_uniform(uniform_2f, _point_size_range_location, point_state.point_size_range().near(), point_state.point_size_range().far());
+            }
+            if (_point_distance_attenuation_location != -1)
+            {
+                upload_uniform(uniform_3fv, _point_distance_attenuation_location, 1, point_state.point_distance_attenuation().data());
+            }
+
+            for (size_t i = 0; i < _texcoord_locations.size(); i++)
+            {
+                texcoord_uniform& uniform = _texcoord_locations[i];
+                const matrix_stack& texture_stack = state.texture_matrix_stack(i);
+                if (uniform.texcoord_transform_location != -1 && texture_stack.version() != uniform.texcoord_transform_version)
+                {
+                    upload_uniform(uniform_matrix_4fv, uniform.texcoord_transform_location, 1, GL_FALSE, texture_stack.top_multiplied().data());
+                    uniform.texcoord_transform_version = texture_stack.version();
+                }
+                if (uniform.sampler_location != -1 && !uniform.sampler_uploaded)
+                {
+                    upload_uniform(uniform_1i, uniform.sampler_location, static_cast<GLint>(i));
+                    uniform.sampler_uploaded = true;
+                }
+                const color& env_color = state.texture_environment(i).color();
+                if (uniform.env_color_location != -1 && (!uniform.env_color_uploaded || uniform.uploaded_env_color != env_color))
+                {
+                    upload_uniform(uniform_4fv, uniform.env_color_location, 1, env_color.data());
+                    uniform.uploaded_env_color = env_color;
+                    uniform.env_color_uploaded = true;
+                }
+            }
+
+            if (_lighting_enabled)
+            {
+                const material& material = state.lighting_state().front_material();
+                if (!_material_uploaded || _uploaded_material != material)
+                {
+                    upload_uniform(uniform_4fv, _material_ambient_color_location, 1, material.ambient().data());
+                    upload_uniform(uniform_4fv, _material_diffuse_color_location, 1, material.diffuse().data());
+                    upload_uniform(uniform_4fv, _material_specular_color_location, 1, material.specular().data());
+                    upload_uniform(uniform_1f, _material_specular_exponent_location, material.specular_exponent());
+                    upload_uniform(uniform_4fv, _material_emissive_color_location, 1, material.emissive().data());
+
+                    _uploaded_material = material;
+                    _material_uploaded = true;
+                }
+
+                for (size_t i = 0; i < _light_locations.size(); i++)
+                {
+                    light_uniform& uniform = _light_locations[i];
+                    const light& light = state.lighting_state().light(i);
+                    if (!light.enabled() || (uniform.uploaded && uniform.uploaded_light == light))
+                    {
+                        continue;
+                    }
+
+                    const vector4& position = light.position();
+                    vector4 light_position = position;
+                    if (position.w() == 0.0f)
+                    {
+                        vector3 light_direction = vector3::normalize(vector3(position.x(), position.y(), position.z()));
+                        light_position = vector4(light_direction.x(), light_direction.y(), light_direction.z(), 0.0f);
+                    }
+
+                    upload_uniform(uniform_4fv, uniform.ambient_color_location, 1, light.ambient().data());
+                    upload_uniform(uniform_4fv, uniform.diffuse_color_location, 1, light.diffuse().data());
+                    upload_uniform(uniform_4fv, uniform.specular_color_location, 1, light.specular().data());
+                    upload_uniform(uniform_4fv, uniform.position_location, 1, light_position.data());
+                    upload_uniform(uniform_3fv, uniform.spot_direction_location, 1, vector3::normalize(light.spot_direction()).data());
+                    upload_uniform(uniform_1f, uniform.spot_exponent_location, light.spot_exponent());
+                    upload_uniform(uniform_1f, uniform.spot_cutoff_cosine_location, light.spot_cutoff_cosine());
+                    upload_uniform(uniform_3fv, uniform.half_vector_location, 1, light.half_vector().data());
+                    upload_uniform(uniform_1f, uniform.constant_attenuation_location, light.constant_attenuation());
+                    upload_uniform(uniform_1f, uniform.linear_attenuation_location, light.linear_attenuation());
+                    upload_uniform(uniform_1f, uniform.quadratic_attenuation_location, light.quadratic_attenuation());
+
+                    uniform.uploaded_light = light;
+                    uniform.uploaded = true;
+                }
+
+                const color& scene_ambient_color = state.lighting_state().light_model().ambient_color();
+                if (!_scene_ambient_color_uploaded || _uploaded_scene_ambient_color != scene_ambient_color)
+                {
+                    upload_uniform(uniform_4fv, _scene_ambient_color_location, 1, scene_ambient_color.data());
+
+                    _uploaded_scene_ambient_color = scene_ambient_color;
+                    _scene_ambient_color_uploaded = true;
+                }
+            }
         }
 
         GLint shader::vertex_attribute_location() const
@@ -588,5 +1718,40 @@ namespace fixie
         {
             return _texcoord_locations[n].texcoord_location;
         }
+
+        GLint shader::point_size_attribute_location() const
+        {
+            return _point_size_location;
+        }
+
+        GLint shader::matrix_index_attribute_location() const
+        {
+            return _matrix_index_location;
+        }
+
+        GLint shader::weight_attribute_location() const
+        {
+            return _weight_location;
+        }
+
+        GLint shader::instance_model_view_attribute_location() const
+        {
+            return _instance_model_view_location;
+        }
+
+        GLint shader::instance_color_attribute_location() const
+        {
+            return _instance_color_location;
+        }
+
+        GLint shader::texture_rect_attribute_location() const
+        {
+            return _texture_rect_location;
+        }
+
+        GLint shader::texture_rect_depth_attribute_location() const
+        {
+            return _texture_rect_depth_location;
+        }
     }
 }
@@ -3,8 +3,11 @@
 
 #include <memory>
 #include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include "fixie_lib/noncopyable.hpp"
+#include "fixie_lib/statistics.hpp"
+#include "fixie_lib/matrix.hpp"
 #include "fixie_lib/desktop_gl_impl/shader_info.hpp"
 #include "fixie_lib/desktop_gl_impl/gl_functions.hpp"
 
@@ -15,7 +18,7 @@ namespace fixie
         class shader : public noncopyable
         {
         public:
-            shader(const shader_info& info, std::shared_ptr<const gl_functions> functions);
+            shader(const shader_info& info, std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics);
             ~shader();
 
             void sync_state(const state& state);
@@ -24,24 +27,64 @@ namespace fixie
             GLint normal_attribute_location() const;
             GLint color_attribute_location() const;
             GLint texcoord_attribute_location(size_t n) const;
+            GLint point_size_attribute_location() const;
+            GLint matrix_index_attribute_location() const;
+            GLint weight_attribute_location() const;
+            GLint instance_model_view_attribute_location() const;
+            GLint instance_color_attribute_location() const;
+            GLint texture_rect_attribute_location() const;
+            GLint texture_rect_depth_attribute_location() const;
 
         private:
             std::shared_ptr<const gl_functions> _functions;
+            std::shared_ptr<fixie::statistics> _statistics;
 
             GLuint _program;
+            bool _lighting_enabled;
 
             GLint _vertex_location;
             GLint _model_view_transform_location;
+            GLint _model_view_projection_transform_location;
+            GLint _normal_transform_location;
             GLint _projection_transform_location;
 
+            uint64_t _model_view_version;
+            uint64_t _projection_version;
+            matrix4 _model_view_projection;
+
             GLint _normal_location;
             GLint _color_location;
+            GLint _constant_color_location;
+
+            GLint _point_size_location;
+            GLint _constant_point_size_location;
+            GLint _point_size_range_location;
+            GLint _point_distance_attenuation_location;
+
+            GLint _matrix_index_location;
+            GLint _weight_location;
+            GLint _palette_transforms_location;
+            GLint _palette_normal_transforms_location;
+            std::vector<uint64_t> _palette_versions;
+
+            GLint _instance_model_view_location;
+            GLint _instance_color_location;
+
+            GLint _texture_rect_location;
+            GLint _texture_rect_depth_location;
+            GLint _viewport_location;
 
             struct texcoord_uniform
             {
                 GLint texcoord_location;
                 GLint texcoord_transform_location;
                 GLint sampler_location;
+                GLint env_color_location;
+                uint64_t texcoord_transform_version;
+
+                bool sampler_uploaded;
+                color uploaded_env_color;
+                bool env_color_uploaded;
             };
             std::vector<texcoord_uniform> _texcoord_locations;
 
@@ -50,6 +93,8 @@ namespace fixie
             GLint _material_specular_color_location;
             GLint _material_specular_exponent_location;
             GLint _material_emissive_color_location;
+            material _uploaded_material;
+            bool _material_uploaded;
 
             struct light_uniform
             {
@@ -59,14 +104,29 @@ namespace fixie
                 GLint position_location;
                 GLint spot_direction_location;
                 GLint spot_exponent_location;
-                GLint spot_cutoff_location;
+                GLint spot_cutoff_cosine_location;
+                GLint half_vector_location;
                 GLint constant_attenuation_location;
                 GLint linear_attenuation_location;
                 GLint quadratic_attenuation_location;
+
+                light uploaded_light;
+                bool uploaded;
             };
             std::vector<light_uniform> _light_locations;
 
             GLint _scene_ambient_color_location;
+            color _uploaded_scene_ambient_color;
+            bool _scene_ambient_color_uploaded;
+
+            GLint _fog_color_location;
+            GLint _fog_density_location;
+            GLint _fog_end_location;
+            GLint _fog_scale_location;
+            fog_state _uploaded_fog_state;
+            bool _fog_uploaded;
+
+            GLint _alpha_test_reference_location;
 
             std::unordered_map<size_t, GLint> _clip_plane_locations;
         };
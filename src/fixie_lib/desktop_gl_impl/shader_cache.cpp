@@ -1,21 +1,30 @@
 #include "fixie_lib/desktop_gl_impl/shader_cache.hpp"
 #include "fixie_lib/desktop_gl_impl/exceptions.hpp"
 
+#include <chrono>
+
 namespace fixie
 {
     namespace desktop_gl_impl
     {
-        shader_cache::shader_cache(std::shared_ptr<const gl_functions> functions)
+        static GLuint64 elapsed_nanoseconds(std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<GLuint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        shader_cache::shader_cache(std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics)
             : _functions(functions)
+            , _statistics(statistics)
         {
         }
 
-        std::weak_ptr<shader> shader_cache::get_shader(const state& state, const caps& caps)
+        std::weak_ptr<shader> shader_cache::get_shader(const state& state, const caps& caps, GLenum primitive_mode, GLboolean draws_instances, GLboolean draws_texture_rects)
         {
-            shader_info key(state, caps);
+            shader_info key(state, caps, primitive_mode, draws_instances, draws_texture_rects);
             auto iter = _shaders.find(key);
             if (iter != end(_shaders))
             {
+                _statistics->shader_cache_hits()++;
                 if (iter->second == nullptr)
                 {
                     throw null_shader();
@@ -27,14 +36,18 @@ namespace fixie
             }
             else
             {
+                _statistics->shader_cache_misses()++;
+                const auto compile_start = std::chrono::steady_clock::now();
                 try
                 {
-                    std::shared_ptr<shader> generated_shader = std::make_shared<shader>(key, _functions);
+                    std::shared_ptr<shader> generated_shader = std::make_shared<shader>(key, _functions, _statistics);
+                    _statistics->shader_compile_time() += elapsed_nanoseconds(compile_start);
                     _shaders.insert(std::make_pair(key, generated_shader));
                     return generated_shader;
                 }
                 catch (const shader_error&)
                 {
+                    _statistics->shader_compile_time() += elapsed_nanoseconds(compile_start);
                     _shaders.insert(std::make_pair(key, nullptr));
                     throw;
                 }
@@ -4,6 +4,7 @@
 #include <memory>
 #include "fixie_lib/state.hpp"
 #include "fixie_lib/caps.hpp"
+#include "fixie_lib/statistics.hpp"
 #include "fixie_lib/desktop_gl_impl/gl_functions.hpp"
 #include "fixie_lib/desktop_gl_impl/shader.hpp"
 #include "fixie_lib/desktop_gl_impl/shader_info.hpp"
@@ -15,12 +16,13 @@ namespace fixie
         class shader_cache
         {
         public:
-            shader_cache(std::shared_ptr<const gl_functions> functions);
+            shader_cache(std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics);
 
-            std::weak_ptr<shader> get_shader(const state& state, const caps& caps);
+            std::weak_ptr<shader> get_shader(const state& state, const caps& caps, GLenum primitive_mode, GLboolean draws_instances, GLboolean draws_texture_rects);
 
         private:
             std::shared_ptr<const gl_functions> _functions;
+            std::shared_ptr<fixie::statistics> _statistics;
             std::unordered_map< shader_info, std::shared_ptr<shader> > _shaders;
         };
     }
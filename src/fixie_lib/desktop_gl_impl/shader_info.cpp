@@ -3,6 +3,8 @@
 #include <algorithm>
 
 #include "fixie_lib/util.hpp"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
 
 namespace fixie
 {
@@ -12,21 +14,131 @@ namespace fixie
         {
         }
 
-        shader_info::shader_info(const state& state, const caps& caps)
+        static GLboolean uses_color_array(const state& state)
+        {
+            std::shared_ptr<const fixie::vertex_array> vertex_array = state.bound_vertex_array().lock();
+            return (vertex_array != nullptr) ? vertex_array->color_attribute().attribute_enabled() : GL_FALSE;
+        }
+
+        static GLboolean uses_point_size_array(const state& state)
+        {
+            std::shared_ptr<const fixie::vertex_array> vertex_array = state.bound_vertex_array().lock();
+            return (vertex_array != nullptr) ? vertex_array->point_size_attribute().attribute_enabled() : GL_FALSE;
+        }
+
+        static size_t vertex_unit_count(const state& state)
+        {
+            std::shared_ptr<const fixie::vertex_array> vertex_array = state.bound_vertex_array().lock();
+            return (vertex_array != nullptr && vertex_array->weight_attribute().attribute_enabled()) ? vertex_array->weight_attribute().size() : 1;
+        }
+
+        static GLboolean uses_instance_model_view_array(const state& state)
+        {
+            std::shared_ptr<const fixie::vertex_array> vertex_array = state.bound_vertex_array().lock();
+            return (vertex_array != nullptr) ? vertex_array->instance_model_view_attribute().attribute_enabled() : GL_FALSE;
+        }
+
+        static GLboolean uses_instance_color_array(const state& state)
+        {
+            std::shared_ptr<const fixie::vertex_array> vertex_array = state.bound_vertex_array().lock();
+            return (vertex_array != nullptr) ? vertex_array->instance_color_attribute().attribute_enabled() : GL_FALSE;
+        }
+
+        static GLenum texture_base_format(std::weak_ptr<const texture> texture)
+        {
+            std::shared_ptr<const fixie::texture> locked_texture = texture.lock();
+            GLenum internal_format = (locked_texture && locked_texture->mip_levels() > 0) ? locked_texture->mip_level_internal_format(0) : GL_RGBA;
+            switch (internal_format)
+            {
+            case GL_ALPHA:
+            case GL_ALPHA8_EXT:
+                return GL_ALPHA;
+
+            case GL_LUMINANCE:
+            case GL_LUMINANCE8_EXT:
+                return GL_LUMINANCE;
+
+            case GL_LUMINANCE_ALPHA:
+            case GL_LUMINANCE8_ALPHA8_EXT:
+                return GL_LUMINANCE_ALPHA;
+
+            case GL_RGB:
+            case GL_RGB8_OES:
+            case GL_ETC1_RGB8_OES:
+            case GL_PALETTE4_RGB8_OES:
+            case GL_PALETTE4_R5_G6_B5_OES:
+            case GL_PALETTE8_RGB8_OES:
+            case GL_PALETTE8_R5_G6_B5_OES:
+                return GL_RGB;
+
+            default:
+                return GL_RGBA;
+            }
+        }
+
+        static GLboolean uses_light_attenuation(const light& light)
+        {
+            return light.position().w() != 0.0f &&
+                   (light.constant_attenuation() != 1.0f || light.linear_attenuation() != 0.0f || light.quadratic_attenuation() != 0.0f);
+        }
+
+        shader_info::shader_info(const state& state, const caps& caps, GLenum primitive_mode, GLboolean draws_instances, GLboolean draws_texture_rects)
             : _texture_environments(caps.max_texture_units())
+            , _texture_matrices_identity(caps.max_texture_units(), GL_FALSE)
+            , _texture_formats(caps.max_texture_units(), 0)
             , _uses_clip_planes(caps.max_clip_planes())
-            , _lighting_enabled(state.lighting_state().lighting_enabled())
-            , _two_sided_lighting(state.lighting_state().light_model().two_sided_lighting())
-            , _uses_lights(caps.max_lights())
-            , _uses_light_attenuation(caps.max_lights())
-            , _uses_spot_lights(caps.max_lights())
+            , _uses_color_array(!draws_texture_rects && desktop_gl_impl::uses_color_array(state))
+            , _lighting_enabled(!draws_texture_rects && state.lighting_state().lighting_enabled())
+            , _per_fragment_lighting(_lighting_enabled && state.hint_state().lighting_hint() == GL_NICEST && state.shade_model() != GL_FLAT)
+            , _two_sided_lighting(_lighting_enabled && state.lighting_state().light_model().two_sided_lighting())
+            , _normalize_normals(_lighting_enabled && (state.lighting_state().normalize_enabled() || state.lighting_state().rescale_normal_enabled()))
+            , _uses_lights(caps.max_lights(), GL_FALSE)
+            , _uses_positional_lights(caps.max_lights(), GL_FALSE)
+            , _uses_light_attenuation(caps.max_lights(), GL_FALSE)
+            , _uses_spot_lights(caps.max_lights(), GL_FALSE)
             , _shade_model(state.shade_model())
+            , _fog_enabled(!draws_texture_rects && state.fog_state().fog_enabled())
+            , _fog_mode(_fog_enabled ? state.fog_state().fog_mode() : 0)
+            , _per_fragment_fog(_fog_enabled && state.hint_state().fog_hint() == GL_NICEST)
+            , _alpha_test_func(state.color_buffer_state().alpha_test_enabled() ? state.color_buffer_state().alpha_test_func() : GL_ALWAYS)
+            , _draws_points(primitive_mode == GL_POINTS)
+            , _uses_point_size_array(_draws_points && desktop_gl_impl::uses_point_size_array(state))
+            , _uses_point_size_attenuation(_draws_points && state.point_state().point_distance_attenuation() != vector3(1.0f, 0.0f, 0.0f))
+            , _point_sprite_enabled(_draws_points && state.point_state().point_sprite_enabled())
+            , _draws_texture_rects(draws_texture_rects)
+            , _uses_matrix_palette(!draws_texture_rects && caps.max_palette_matrices() > 0 && state.matrix_palette_enabled())
+            , _palette_matrix_count(_uses_matrix_palette ? caps.max_palette_matrices() : 0)
+            , _vertex_unit_count(_uses_matrix_palette ? desktop_gl_impl::vertex_unit_count(state) : 0)
+            , _uses_instance_model_view(draws_instances && !_uses_matrix_palette && uses_instance_model_view_array(state))
+            , _uses_instance_color(draws_instances && !_uses_color_array && uses_instance_color_array(state))
         {
-            for_each_n<size_t>(0U, _texture_environments.size(), [&](size_t i){ _texture_environments[i] = state.texture_environment(i); });
-            for_each_n<size_t>(0U, _uses_clip_planes.size(), [&](size_t i){ _uses_clip_planes[i] = state.clip_plane(i).clip_plane_enabled(); });
-            for_each_n<size_t>(0U, _uses_lights.size(), [&](size_t i){ _uses_lights[i] = state.lighting_state().light(i).enabled(); });
-            for_each_n<size_t>(0U, _uses_light_attenuation.size(), [&](size_t i){ _uses_light_attenuation[i] = state.lighting_state().light(i).position().w() != 0.0f; });
-            for_each_n<size_t>(0U, _uses_spot_lights.size(), [&](size_t i){ _uses_spot_lights[i] = state.lighting_state().light(i).spot_cutoff() != 180.0f; });
+            for_each_n<size_t>(0U, _texture_environments.size(), [&](size_t i)
+            {
+                if (state.texture_environment(i).texture_enabled())
+                {
+                    // The constant color is a uniform, keep it out of the key
+                    _texture_environments[i] = state.texture_environment(i);
+                    _texture_environments[i].color() = color();
+                    _texture_environments[i].coord_replace() = _point_sprite_enabled && state.texture_environment(i).coord_replace();
+                    _texture_matrices_identity[i] = _draws_texture_rects || state.texture_matrix_stack(i).top_is_identity();
+                    _texture_formats[i] = texture_base_format(state.bound_texture(i));
+                }
+            });
+            for_each_n<size_t>(0U, _uses_clip_planes.size(), [&](size_t i){ _uses_clip_planes[i] = !_draws_texture_rects && state.clip_plane(i).clip_plane_enabled(); });
+            if (_lighting_enabled)
+            {
+                for_each_n<size_t>(0U, _uses_lights.size(), [&](size_t i)
+                {
+                    const light& light = state.lighting_state().light(i);
+                    if (light.enabled())
+                    {
+                        _uses_lights[i] = GL_TRUE;
+                        _uses_positional_lights[i] = light.position().w() != 0.0f;
+                        _uses_light_attenuation[i] = desktop_gl_impl::uses_light_attenuation(light);
+                        _uses_spot_lights[i] = light.spot_cutoff() != 180.0f;
+                    }
+                });
+            }
         }
 
         const fixie::texture_environment& shader_info::texture_environment(size_t n) const
@@ -34,6 +146,16 @@ namespace fixie
             return _texture_environments[n];
         }
 
+        GLboolean shader_info::texture_matrix_identity(size_t n) const
+        {
+            return _texture_matrices_identity[n];
+        }
+
+        GLenum shader_info::texture_format(size_t n) const
+        {
+            return _texture_formats[n];
+        }
+
         size_t shader_info::texture_unit_count() const
         {
             return _texture_environments.size();
@@ -49,21 +171,46 @@ namespace fixie
             return _uses_clip_planes.size();
         }
 
+        GLboolean shader_info::uses_color_array() const
+        {
+            return _uses_color_array;
+        }
+
+        GLboolean shader_info::uses_normals() const
+        {
+            return _lighting_enabled;
+        }
+
         GLboolean shader_info::lighting_enabled() const
         {
             return _lighting_enabled;
         }
 
+        GLboolean shader_info::per_fragment_lighting() const
+        {
+            return _per_fragment_lighting;
+        }
+
         GLboolean shader_info::two_sided_lighting() const
         {
             return _two_sided_lighting;
         }
 
+        GLboolean shader_info::normalize_normals() const
+        {
+            return _normalize_normals;
+        }
+
         GLboolean shader_info::uses_light(size_t n) const
         {
             return _uses_lights[n];
         }
 
+        GLboolean shader_info::uses_positional_light(size_t n) const
+        {
+            return _uses_positional_lights[n];
+        }
+
         GLboolean shader_info::uses_light_attenuation(size_t n) const
         {
             return _uses_light_attenuation[n];
@@ -84,19 +231,109 @@ namespace fixie
             return _shade_model;
         }
 
+        GLboolean shader_info::fog_enabled() const
+        {
+            return _fog_enabled;
+        }
+
+        GLenum shader_info::fog_mode() const
+        {
+            return _fog_mode;
+        }
+
+        GLboolean shader_info::per_fragment_fog() const
+        {
+            return _per_fragment_fog;
+        }
+
+        GLenum shader_info::alpha_test_func() const
+        {
+            return _alpha_test_func;
+        }
+
+        GLboolean shader_info::draws_points() const
+        {
+            return _draws_points;
+        }
+
+        GLboolean shader_info::uses_point_size_array() const
+        {
+            return _uses_point_size_array;
+        }
+
+        GLboolean shader_info::uses_point_size_attenuation() const
+        {
+            return _uses_point_size_attenuation;
+        }
+
+        GLboolean shader_info::point_sprite_enabled() const
+        {
+            return _point_sprite_enabled;
+        }
+
+        GLboolean shader_info::draws_texture_rects() const
+        {
+            return _draws_texture_rects;
+        }
+
+        GLboolean shader_info::uses_matrix_palette() const
+        {
+            return _uses_matrix_palette;
+        }
+
+        size_t shader_info::palette_matrix_count() const
+        {
+            return _palette_matrix_count;
+        }
+
+        size_t shader_info::vertex_unit_count() const
+        {
+            return _vertex_unit_count;
+        }
+
+        GLboolean shader_info::uses_instance_model_view() const
+        {
+            return _uses_instance_model_view;
+        }
+
+        GLboolean shader_info::uses_instance_color() const
+        {
+            return _uses_instance_color;
+        }
+
         bool operator==(const shader_info& a, const shader_info& b)
         {
             return a.texture_unit_count() == b.texture_unit_count() &&
-                   equal_n<size_t>(0U, a.texture_unit_count(), [&](size_t i){ return a.texture_environment(i) == b.texture_environment(i); }) &&
+                   equal_n<size_t>(0U, a.texture_unit_count(), [&](size_t i){ return a.texture_environment(i) == b.texture_environment(i) &&
+                                                                            a.texture_matrix_identity(i) == b.texture_matrix_identity(i) &&
+                                                                            a.texture_format(i) == b.texture_format(i); }) &&
                    a.clip_plane_count() == b.clip_plane_count() &&
                    equal_n<size_t>(0U, a.clip_plane_count(), [&](size_t i){ return a.uses_clip_plane(i) == b.uses_clip_plane(i); }) &&
+                   a.uses_color_array() == b.uses_color_array() &&
                    a.lighting_enabled() == b.lighting_enabled() &&
+                   a.per_fragment_lighting() == b.per_fragment_lighting() &&
                    a.two_sided_lighting() == b.two_sided_lighting() &&
+                   a.normalize_normals() == b.normalize_normals() &&
                    a.light_count() == b.light_count() &&
                    equal_n<size_t>(0U, a.light_count(), [&](size_t i){ return a.uses_light(i) == b.uses_light(i) &&
+                                                                      a.uses_positional_light(i) == b.uses_positional_light(i) &&
                                                                       a.uses_light_attenuation(i) == b.uses_light_attenuation(i) &&
                                                                       a.uses_spot_light(i) == b.uses_spot_light(i); }) &&
-                   a.shade_model() == b.shade_model();
+                   a.shade_model() == b.shade_model() &&
+                   a.fog_enabled() == b.fog_enabled() &&
+                   a.fog_mode() == b.fog_mode() &&
+                   a.per_fragment_fog() == b.per_fragment_fog() &&
+                   a.alpha_test_func() == b.alpha_test_func() &&
+                   a.draws_points() == b.draws_points() &&
+                   a.uses_point_size_array() == b.uses_point_size_array() &&
+                   a.uses_point_size_attenuation() == b.uses_point_size_attenuation() &&
+                   a.point_sprite_enabled() == b.point_sprite_enabled() &&
+                   a.draws_texture_rects() == b.draws_texture_rects() &&
+                   a.uses_matrix_palette() == b.uses_matrix_palette() &&
+                   a.palette_matrix_count() == b.palette_matrix_count() &&
+                   a.vertex_unit_count() == b.vertex_unit_count() &&
+                   a.uses_instance_model_view() == b.uses_instance_model_view() &&
+                   a.uses_instance_color() == b.uses_instance_color();
         }
 
         bool operator!=(const shader_info& a, const shader_info& b)
@@ -113,13 +350,34 @@ namespace std
         size_t seed = 0;
 
         fixie::hash_combine(seed, key.texture_unit_count());
+        fixie::for_each_n<size_t>(0U, key.texture_unit_count(), [&](size_t i){ fixie::hash_combine(seed, key.texture_environment(i));
+                                                                        fixie::hash_combine(seed, key.texture_matrix_identity(i));
+                                                                        fixie::hash_combine(seed, key.texture_format(i)); });
         fixie::for_each_n<size_t>(0U, key.clip_plane_count(), [&](size_t i){ fixie::hash_combine(seed, key.uses_clip_plane(i)); });
+        fixie::hash_combine(seed, key.uses_color_array());
         fixie::hash_combine(seed, key.lighting_enabled());
+        fixie::hash_combine(seed, key.per_fragment_lighting());
         fixie::hash_combine(seed, key.two_sided_lighting());
+        fixie::hash_combine(seed, key.normalize_normals());
         fixie::for_each_n<size_t>(0U, key.light_count(), [&](size_t i){ fixie::hash_combine(seed, key.uses_light(i));
+                                                                fixie::hash_combine(seed, key.uses_positional_light(i));
                                                                 fixie::hash_combine(seed, key.uses_light_attenuation(i));
                                                                 fixie::hash_combine(seed, key.uses_spot_light(i)); });
         fixie::hash_combine(seed, key.shade_model());
+        fixie::hash_combine(seed, key.fog_enabled());
+        fixie::hash_combine(seed, key.fog_mode());
+        fixie::hash_combine(seed, key.per_fragment_fog());
+        fixie::hash_combine(seed, key.alpha_test_func());
+        fixie::hash_combine(seed, key.draws_points());
+        fixie::hash_combine(seed, key.uses_point_size_array());
+        fixie::hash_combine(seed, key.uses_point_size_attenuation());
+        fixie::hash_combine(seed, key.point_sprite_enabled());
+        fixie::hash_combine(seed, key.draws_texture_rects());
+        fixie::hash_combine(seed, key.uses_matrix_palette());
+        fixie::hash_combine(seed, key.palette_matrix_count());
+        fixie::hash_combine(seed, key.vertex_unit_count());
+        fixie::hash_combine(seed, key.uses_instance_model_view());
+        fixie::hash_combine(seed, key.uses_instance_color());
 
         return seed;
     }
@@ -16,32 +16,80 @@ namespace fixie
         {
         public:
             shader_info();
-            shader_info(const state& state, const caps& caps);
+            shader_info(const state& state, const caps& caps, GLenum primitive_mode, GLboolean draws_instances, GLboolean draws_texture_rects);
 
             const fixie::texture_environment& texture_environment(size_t n) const;
+            GLboolean texture_matrix_identity(size_t n) const;
+            GLenum texture_format(size_t n) const;
             size_t texture_unit_count() const;
 
             GLboolean uses_clip_plane(size_t n) const;
             size_t clip_plane_count() const;
 
+            GLboolean uses_color_array() const;
+            GLboolean uses_normals() const;
+
             GLboolean lighting_enabled() const;
+            GLboolean per_fragment_lighting() const;
             GLboolean two_sided_lighting() const;
+            GLboolean normalize_normals() const;
             GLboolean uses_light(size_t n) const;
+            GLboolean uses_positional_light(size_t n) const;
             GLboolean uses_light_attenuation(size_t n) const;
             GLboolean uses_spot_light(size_t n) const;
             size_t light_count() const;
 
             GLenum shade_model() const;
 
+            GLboolean fog_enabled() const;
+            GLenum fog_mode() const;
+            GLboolean per_fragment_fog() const;
+
+            GLenum alpha_test_func() const;
+
+            GLboolean draws_points() const;
+            GLboolean uses_point_size_array() const;
+            GLboolean uses_point_size_attenuation() const;
+            GLboolean point_sprite_enabled() const;
+
+            GLboolean draws_texture_rects() const;
+
+            GLboolean uses_matrix_palette() const;
+            size_t palette_matrix_count() const;
+            size_t vertex_unit_count() const;
+
+            GLboolean uses_instance_model_view() const;
+            GLboolean uses_instance_color() const;
+
         private:
             std::vector<fixie::texture_environment> _texture_environments;
+            std::vector<GLboolean> _texture_matrices_identity;
+            std::vector<GLenum> _texture_formats;
             std::vector<GLboolean> _uses_clip_planes;
+            GLboolean _uses_color_array;
             GLboolean _lighting_enabled;
+            GLboolean _per_fragment_lighting;
             GLboolean _two_sided_lighting;
+            GLboolean _normalize_normals;
             std::vector<GLboolean> _uses_lights;
+            std::vector<GLboolean> _uses_positional_lights;
             std::vector<GLboolean> _uses_light_attenuation;
             std::vector<GLboolean> _uses_spot_lights;
             GLenum _shade_model;
+            GLboolean _fog_enabled;
+            GLenum _fog_mode;
+            GLboolean _per_fragment_fog;
+            GLenum _alpha_test_func;
+            GLboolean _draws_points;
+            GLboolean _uses_point_size_array;
+            GLboolean _uses_point_size_attenuation;
+            GLboolean _point_sprite_enabled;
+            GLboolean _draws_texture_rects;
+            GLboolean _uses_matrix_palette;
+            size_t _palette_matrix_count;
+            size_t _vertex_unit_count;
+            GLboolean _uses_instance_model_view;
+            GLboolean _uses_instance_color;
         };
 
         bool operator==(const shader_info& a, const shader_info& b);
@@ -1,91 +1,237 @@
 #include "fixie_lib/desktop_gl_impl/texture.hpp"
+#include "fixie_lib/tracer.hpp"
 #include "fixie_lib/desktop_gl_impl/framebuffer.hpp"
+#include "fixie_lib/compressed_texture.hpp"
 #include "fixie_lib/debug.hpp"
 
 #include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace fixie
 {
     namespace desktop_gl_impl
     {
         #define GL_FRAMEBUFFER 0x8D40
+        #define GL_READ_FRAMEBUFFER 0x8CA8
+        #define GL_DRAW_FRAMEBUFFER 0x8CA9
+        #define GL_COLOR_ATTACHMENT0 0x8CE0
 
-        texture::texture(std::shared_ptr<const gl_functions> functions)
+        texture::texture(std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics, GLenum native_etc1_format, GLboolean supports_framebuffer_blit)
             : _functions(functions)
+            , _statistics(statistics)
+            , _native_etc1_format(native_etc1_format)
+            , _supports_framebuffer_blit(supports_framebuffer_blit)
+            , _id(0)
+            , _blit_framebuffer(0)
+            , _storage_revision(0)
+            , _pending_resolve()
         {
             gl_call(_functions, gen_textures, 1, &_id);
         }
 
         texture::~texture()
         {
+            if (_blit_framebuffer)
+            {
+                gl_call_nothrow(_functions, delete_framebuffers, 1, &_blit_framebuffer);
+            }
             gl_call_nothrow(_functions, delete_textures, 1, &_id);
         }
 
+        static GLboolean is_blittable_format(GLenum internal_format)
+        {
+            // Blits cannot convert into the alpha and luminance formats, those are left to glCopyTex(Sub)Image2D
+            switch (internal_format)
+            {
+            case GL_RGB:
+            case GL_RGBA:
+            case GL_RGB8_OES:
+            case GL_RGBA8_OES:
+                return GL_TRUE;
+
+            default:
+                return GL_FALSE;
+            }
+        }
+
         GLuint texture::id() const
         {
             return _id;
         }
 
+        GLuint texture::storage_revision() const
+        {
+            return _storage_revision;
+        }
+
         void texture::set_data(const pixel_store_state& store_state, GLint level, GLenum internal_format, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels)
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::set_data");
+
+            _storage_revision++;
+
             gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
             gl_call(_functions, pixel_store_i, GL_UNPACK_ALIGNMENT, store_state.unpack_alignment());
             gl_call(_functions, tex_image_2d, GL_TEXTURE_2D, level, internal_format, width, height, 0, format, type, pixels);
+            if (pixels != nullptr)
+            {
+                _statistics->texture_upload_bytes() += unpacked_image_size(store_state, width, height, format, type);
+            }
         }
 
         void texture::set_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels)
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::set_sub_data");
+
             gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
             gl_call(_functions, pixel_store_i, GL_UNPACK_ALIGNMENT, store_state.unpack_alignment());
             gl_call(_functions, tex_sub_image_2d, GL_TEXTURE_2D, level, xoffset, yoffset, width, height, format, type, pixels);
+            _statistics->texture_upload_bytes() += unpacked_image_size(store_state, width, height, format, type);
         }
 
         void texture::set_compressed_data(const pixel_store_state& store_state, GLint level, GLenum internal_format, GLsizei width, GLsizei height, GLsizei image_size, const GLvoid *data)
         {
-            gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
-            gl_call(_functions, pixel_store_i, GL_UNPACK_ALIGNMENT, store_state.unpack_alignment());
-            gl_call(_functions, compressed_tex_image_2d, GL_TEXTURE_2D, level, internal_format, width, height, 0, image_size, data);
+            FIXIE_TRACE_SCOPE("upload", "texture::set_compressed_data");
+
+            _storage_revision++;
+
+            pixel_store_state decoded_store_state(store_state);
+            decoded_store_state.unpack_alignment() = 1;
+
+            if (is_paletted_format(internal_format))
+            {
+                // Paletted images hold levels 0 through -level, expand and upload each of them
+                GLenum format = paletted_format_pixel_format(internal_format);
+                GLenum type = paletted_format_pixel_type(internal_format);
+                std::vector<GLubyte> pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * paletted_format_pixel_size(internal_format));
+                for (GLint mip = 0; mip <= -level; mip++)
+                {
+                    decode_paletted_level(internal_format, data, width, height, mip, pixels.data(), get_worker_pool());
+                    set_data(decoded_store_state, mip, format, std::max(width >> mip, 1), std::max(height >> mip, 1), format, type, pixels.data());
+                }
+            }
+            else if (is_etc1_format(internal_format) && _native_etc1_format == 0)
+            {
+                std::vector<GLubyte> pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * 3);
+                decode_etc1(data, width, height, pixels.data(), get_worker_pool());
+                set_data(decoded_store_state, level, GL_RGB, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+            }
+            else
+            {
+                GLenum native_format = is_etc1_format(internal_format) ? _native_etc1_format : internal_format;
+
+                gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
+                gl_call(_functions, pixel_store_i, GL_UNPACK_ALIGNMENT, store_state.unpack_alignment());
+                gl_call(_functions, compressed_tex_image_2d, GL_TEXTURE_2D, level, native_format, width, height, 0, image_size, data);
+                _statistics->texture_upload_bytes() += image_size;
+            }
         }
 
         void texture::set_compressed_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei image_size, const GLvoid *data)
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::set_compressed_sub_data");
+
             gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
             gl_call(_functions, pixel_store_i, GL_UNPACK_ALIGNMENT, store_state.unpack_alignment());
-            gl_call(_functions, tex_sub_image_2d, GL_TEXTURE_2D, level, xoffset, yoffset, width, height, format, image_size, data);
+            gl_call(_functions, compressed_tex_sub_image_2d, GL_TEXTURE_2D, level, xoffset, yoffset, width, height, format, image_size, data);
+            _statistics->texture_upload_bytes() += image_size;
         }
 
         void texture::set_storage(GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height)
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::set_storage");
+
+            _storage_revision++;
+
             gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
             gl_call(_functions, tex_storage_2d, GL_TEXTURE_2D, levels, internal_format, width, height);
         }
 
         void texture::copy_data(GLint level, GLenum internal_format, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source)
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::copy_data");
+
+            _storage_revision++;
+
             std::shared_ptr<const framebuffer_impl> source_locked = source.lock();
             std::shared_ptr<const desktop_gl_impl::framebuffer> desktop_framebuffer = std::dynamic_pointer_cast<const desktop_gl_impl::framebuffer>(source_locked);
             assert(desktop_framebuffer != nullptr);
 
-            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, desktop_framebuffer->id());
-            gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
-            gl_call(_functions, copy_tex_image_2d, GL_TEXTURE_2D, level, internal_format, x, y, width, height, 0);
+            if (_supports_framebuffer_blit && is_blittable_format(internal_format))
+            {
+                GLenum format = (internal_format == GL_RGB || internal_format == GL_RGB8_OES) ? GL_RGB : GL_RGBA;
+                gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
+                gl_call(_functions, tex_image_2d, GL_TEXTURE_2D, level, internal_format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+                blit_sub_data(level, 0, 0, x, y, width, height, desktop_framebuffer->read_framebuffer_id());
+            }
+            else
+            {
+                gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, desktop_framebuffer->read_framebuffer_id());
+                gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
+                gl_call(_functions, copy_tex_image_2d, GL_TEXTURE_2D, level, internal_format, x, y, width, height, 0);
+            }
         }
 
-        void texture::copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, std::weak_ptr<const framebuffer_impl> source)
+        void texture::copy_sub_data(GLint level, GLenum internal_format, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source)
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::copy_sub_data");
+
             std::shared_ptr<const framebuffer_impl> source_locked = source.lock();
             std::shared_ptr<const desktop_gl_impl::framebuffer> desktop_framebuffer = std::dynamic_pointer_cast<const desktop_gl_impl::framebuffer>(source_locked);
             assert(desktop_framebuffer != nullptr);
 
-            gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, desktop_framebuffer->id());
-            gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
-            gl_call(_functions, copy_tex_sub_image_2d, GL_TEXTURE_2D, level, xoffset, yoffset, x, y, width, height);
+            if (_supports_framebuffer_blit && is_blittable_format(internal_format))
+            {
+                blit_sub_data(level, xoffset, yoffset, x, y, width, height, desktop_framebuffer->read_framebuffer_id());
+            }
+            else
+            {
+                gl_call(_functions, bind_framebuffer, GL_FRAMEBUFFER, desktop_framebuffer->read_framebuffer_id());
+                gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
+                gl_call(_functions, copy_tex_sub_image_2d, GL_TEXTURE_2D, level, xoffset, yoffset, x, y, width, height);
+            }
+        }
+
+        void texture::blit_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLuint source_framebuffer)
+        {
+            // Callers pass an already resolved source, blits only resolve multisampled sources when the rectangles
+            // and formats of both sides match
+            if (_blit_framebuffer == 0)
+            {
+                gl_call(_functions, gen_framebuffers, 1, &_blit_framebuffer);
+            }
+
+            gl_call(_functions, bind_framebuffer, GL_READ_FRAMEBUFFER, source_framebuffer);
+            gl_call(_functions, bind_framebuffer, GL_DRAW_FRAMEBUFFER, _blit_framebuffer);
+            gl_call(_functions, framebuffer_texture_2d, GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _id, level);
+            gl_call(_functions, blit_framebuffer, x, y, x + width, y + height, xoffset, yoffset, xoffset + width, yoffset + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
         }
 
         void texture::generate_mipmaps()
         {
+            FIXIE_TRACE_SCOPE("upload", "texture::generate_mipmaps");
+
+            resolve_pending();
             gl_call(_functions, bind_texture, GL_TEXTURE_2D, _id);
             gl_call(_functions, generate_mipmap, GL_TEXTURE_2D);
         }
+
+        void texture::set_pending_resolve(std::weak_ptr<const framebuffer> source) const
+        {
+            _pending_resolve = source;
+        }
+
+        void texture::resolve_pending() const
+        {
+            std::shared_ptr<const framebuffer> source = _pending_resolve.lock();
+            if (source != nullptr)
+            {
+                source->resolve();
+            }
+            _pending_resolve.reset();
+        }
     }
 }
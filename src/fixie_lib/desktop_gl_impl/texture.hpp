@@ -2,32 +2,50 @@
 #define _FIXIE_LIB_DESKTOP_GL_TEXTURE_HPP_
 
 #include "fixie_lib/texture.hpp"
+#include "fixie_lib/statistics.hpp"
 #include "fixie_lib/desktop_gl_impl/gl_functions.hpp"
 
 namespace fixie
 {
     namespace desktop_gl_impl
     {
+        class framebuffer;
+
         class texture : public fixie::texture_impl
         {
         public:
-            explicit texture(std::shared_ptr<const gl_functions> functions);
+            texture(std::shared_ptr<const gl_functions> functions, std::shared_ptr<fixie::statistics> statistics, GLenum native_etc1_format, GLboolean supports_framebuffer_blit);
             virtual ~texture();
 
             GLuint id() const;
 
+            // Incremented whenever the texture images are respecified
+            GLuint storage_revision() const;
+
             virtual void set_data(const pixel_store_state& store_state, GLint level, GLenum internal_format, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels) override;
             virtual void set_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels) override;
             virtual void set_compressed_data(const pixel_store_state& store_state, GLint level, GLenum internal_format, GLsizei width, GLsizei height, GLsizei image_size, const GLvoid *data) override;
             virtual void set_compressed_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei image_size, const GLvoid *data) override;
             virtual void set_storage(GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height) override;
             virtual void copy_data(GLint level, GLenum internal_format, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source) override;
-            virtual void copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, std::weak_ptr<const framebuffer_impl> source) override;
+            virtual void copy_sub_data(GLint level, GLenum internal_format, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source) override;
             virtual void generate_mipmaps() override;
 
+            // Multisampled rendering into this texture is resolved the next time it is used
+            void set_pending_resolve(std::weak_ptr<const framebuffer> source) const;
+            void resolve_pending() const;
+
         private:
+            void blit_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLuint source_framebuffer);
+
             std::shared_ptr<const gl_functions> _functions;
+            std::shared_ptr<fixie::statistics> _statistics;
+            GLenum _native_etc1_format;
+            GLboolean _supports_framebuffer_blit;
             GLuint _id;
+            GLuint _blit_framebuffer;
+            GLuint _storage_revision;
+            mutable std::weak_ptr<const framebuffer> _pending_resolve;
         };
     }
 }
@@ -2,6 +2,7 @@
 #include "fixie_lib/util.hpp"
 
 #include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
 
 namespace fixie
 {
@@ -78,6 +79,11 @@ namespace fixie
     {
     }
 
+    invalid_framebuffer_operation_error::invalid_framebuffer_operation_error(const std::string& msg)
+        : gl_error(GL_INVALID_FRAMEBUFFER_OPERATION_OES, "invalid framebuffer operation", msg)
+    {
+    }
+
     void throw_gl_error(GLenum error_code, const std::string& file, size_t line)
     {
         throw_gl_error(error_code, format("%s:%u", file.c_str(), line));
@@ -94,6 +100,7 @@ namespace fixie
         case GL_STACK_OVERFLOW:    throw stack_overflow_error(msg);
         case GL_STACK_UNDERFLOW:   throw stack_underflow_error(msg);
         case GL_OUT_OF_MEMORY:     throw out_of_memory_error(msg);
+        case GL_INVALID_FRAMEBUFFER_OPERATION_OES: throw invalid_framebuffer_operation_error(msg);
         default:                   break;
         }
     }
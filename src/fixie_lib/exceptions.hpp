@@ -87,6 +87,12 @@ namespace fixie
         out_of_memory_error(const std::string& msg);
     };
 
+    class invalid_framebuffer_operation_error : public gl_error
+    {
+    public:
+        invalid_framebuffer_operation_error(const std::string& msg);
+    };
+
     void throw_gl_error(GLenum error_code, const std::string& file, size_t line);
     void throw_gl_error(GLenum error_code, const std::string& msg);
 }
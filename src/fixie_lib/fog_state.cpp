@@ -63,6 +63,20 @@ namespace fixie
         return _fog_enabled;
     }
 
+    bool operator==(const fog_state& a, const fog_state& b)
+    {
+        return a.fog_color() == b.fog_color() &&
+               a.fog_density() == b.fog_density() &&
+               a.fog_range() == b.fog_range() &&
+               a.fog_mode() == b.fog_mode() &&
+               a.fog_enabled() == b.fog_enabled();
+    }
+
+    bool operator!=(const fog_state& a, const fog_state& b)
+    {
+        return !(a == b);
+    }
+
     fog_state default_fog_state()
     {
         fog_state state;
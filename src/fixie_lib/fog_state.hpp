@@ -35,6 +35,9 @@ namespace fixie
         GLboolean _fog_enabled;
     };
 
+    bool operator==(const fog_state& a, const fog_state& b);
+    bool operator!=(const fog_state& a, const fog_state& b);
+
     fog_state default_fog_state();
 }
 
@@ -66,6 +66,7 @@ namespace fixie
         : _color()
         , _depth()
         , _stencil()
+        , _label()
         , _impl(std::move(impl))
     {
     }
@@ -118,11 +119,41 @@ namespace fixie
         _impl->read_pixels(store_state, x, y, width, height, format, type, data);
     }
 
+    GLuint framebuffer::begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        return _impl->begin_read_pixels(store_state, x, y, width, height, format, type);
+    }
+
+    GLboolean framebuffer::end_read_pixels(GLuint request, GLboolean wait, GLvoid* data)
+    {
+        return _impl->end_read_pixels(request, wait, data);
+    }
+
+    void framebuffer::invalidate(GLbitfield mask)
+    {
+        _impl->invalidate(mask);
+    }
+
+    void framebuffer::invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        _impl->invalidate(mask, x, y, width, height);
+    }
+
     GLenum framebuffer::status() const
     {
         return _impl->status();
     }
 
+    std::string& framebuffer::label()
+    {
+        return _label;
+    }
+
+    const std::string& framebuffer::label() const
+    {
+        return _label;
+    }
+
     std::weak_ptr<framebuffer_impl> framebuffer::impl()
     {
         return _impl;
@@ -2,6 +2,7 @@
 #define _FIXIE_LIB_FRAMEBUFFER_HPP_
 
 #include <memory>
+#include <string>
 
 #include "fixie/fixie_gl_types.h"
 #include "fixie_lib/texture.hpp"
@@ -47,6 +48,14 @@ namespace fixie
         virtual GLenum preferred_read_type() const = 0;
         virtual void read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* data) = 0;
 
+        // Queues a read without waiting for the GPU, end_read_pixels returns GL_FALSE until the pixels are available
+        virtual GLuint begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type) = 0;
+        virtual GLboolean end_read_pixels(GLuint request, GLboolean wait, GLvoid* data) = 0;
+
+        // Tells the implementation that the buffers in mask, a combination of clear bits, hold no useful contents
+        virtual void invalidate(GLbitfield mask) = 0;
+        virtual void invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height) = 0;
+
         virtual GLenum status() const = 0;
     };
 
@@ -67,9 +76,17 @@ namespace fixie
         GLenum preferred_read_format() const;
         GLenum preferred_read_type() const;
         void read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* data);
+        GLuint begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type);
+        GLboolean end_read_pixels(GLuint request, GLboolean wait, GLvoid* data);
+
+        void invalidate(GLbitfield mask);
+        void invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height);
 
         GLenum status() const;
 
+        std::string& label();
+        const std::string& label() const;
+
         std::weak_ptr<framebuffer_impl> impl();
         std::weak_ptr<const framebuffer_impl> impl() const;
 
@@ -78,6 +95,8 @@ namespace fixie
         framebuffer_attachment _depth;
         framebuffer_attachment _stencil;
 
+        std::string _label;
+
         std::shared_ptr<framebuffer_impl> _impl;
     };
 }
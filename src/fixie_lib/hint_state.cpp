@@ -10,6 +10,8 @@ namespace fixie
         , _line_smooth_hint()
         , _fog_hint()
         , _generate_mipmap_hint()
+        , _lighting_hint()
+        , _clear_invalidate_hint()
     {
     }
 
@@ -63,6 +65,26 @@ namespace fixie
         return _generate_mipmap_hint;
     }
 
+    const GLenum& hint_state::lighting_hint() const
+    {
+        return _lighting_hint;
+    }
+
+    GLenum& hint_state::lighting_hint()
+    {
+        return _lighting_hint;
+    }
+
+    const GLenum& hint_state::clear_invalidate_hint() const
+    {
+        return _clear_invalidate_hint;
+    }
+
+    GLenum& hint_state::clear_invalidate_hint()
+    {
+        return _clear_invalidate_hint;
+    }
+
     fixie::hint_state default_hint_state()
     {
         hint_state state;
@@ -71,6 +93,8 @@ namespace fixie
         state.line_smooth_hint() = GL_DONT_CARE;
         state.fog_hint() = GL_DONT_CARE;
         state.generate_mipmap_hint() = GL_DONT_CARE;
+        state.lighting_hint() = GL_DONT_CARE;
+        state.clear_invalidate_hint() = GL_DONT_CARE;
         return state;
     }
 }
@@ -25,12 +25,20 @@ namespace fixie
         const GLenum& generate_mipmap_hint() const;
         GLenum& generate_mipmap_hint();
 
+        const GLenum& lighting_hint() const;
+        GLenum& lighting_hint();
+
+        const GLenum& clear_invalidate_hint() const;
+        GLenum& clear_invalidate_hint();
+
     private:
         GLenum _perspective_correction_hint;
         GLenum _point_smooth_hint;
         GLenum _line_smooth_hint;
         GLenum _fog_hint;
         GLenum _generate_mipmap_hint;
+        GLenum _lighting_hint;
+        GLenum _clear_invalidate_hint;
     };
 
     hint_state default_hint_state();
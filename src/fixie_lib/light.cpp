@@ -12,7 +12,10 @@ namespace fixie
         , _spot_direction()
         , _spot_exponent(0.0f)
         , _spot_cutoff(0.0f)
+        , _spot_cutoff_cosine(1.0f)
+        , _half_vector()
         , _constant_attenuation(0.0f)
+        , _linear_attenuation(0.0f)
         , _quadratic_attenuation(0.0f)
     {
     }
@@ -97,6 +100,26 @@ namespace fixie
         return _spot_cutoff;
     }
 
+    GLfloat& light::spot_cutoff_cosine()
+    {
+        return _spot_cutoff_cosine;
+    }
+
+    const GLfloat& light::spot_cutoff_cosine() const
+    {
+        return _spot_cutoff_cosine;
+    }
+
+    vector3& light::half_vector()
+    {
+        return _half_vector;
+    }
+
+    const vector3& light::half_vector() const
+    {
+        return _half_vector;
+    }
+
     GLfloat& light::constant_attenuation()
     {
         return _constant_attenuation;
@@ -140,9 +163,33 @@ namespace fixie
         light.spot_direction() = vector3(0.0f, 0.0f, -1.0f);
         light.spot_exponent() = 0.0f;
         light.spot_cutoff() = 180.0f;
+        light.spot_cutoff_cosine() = -1.0f;
+        light.half_vector() = vector3(0.0f, 0.0f, 1.0f);
         light.constant_attenuation() = 1.0f;
         light.linear_attenuation() = 0.0f;
         light.quadratic_attenuation() = 0.0f;
         return light;
     }
+
+    bool operator==(const light& a, const light& b)
+    {
+        return a.enabled() == b.enabled() &&
+               a.ambient() == b.ambient() &&
+               a.diffuse() == b.diffuse() &&
+               a.specular() == b.specular() &&
+               a.position() == b.position() &&
+               a.spot_direction() == b.spot_direction() &&
+               a.spot_exponent() == b.spot_exponent() &&
+               a.spot_cutoff() == b.spot_cutoff() &&
+               a.spot_cutoff_cosine() == b.spot_cutoff_cosine() &&
+               a.half_vector() == b.half_vector() &&
+               a.constant_attenuation() == b.constant_attenuation() &&
+               a.linear_attenuation() == b.linear_attenuation() &&
+               a.quadratic_attenuation() == b.quadratic_attenuation();
+    }
+
+    bool operator!=(const light& a, const light& b)
+    {
+        return !(a == b);
+    }
 }
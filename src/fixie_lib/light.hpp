@@ -35,6 +35,12 @@ namespace fixie
         GLfloat& spot_cutoff();
         const GLfloat& spot_cutoff() const;
 
+        GLfloat& spot_cutoff_cosine();
+        const GLfloat& spot_cutoff_cosine() const;
+
+        vector3& half_vector();
+        const vector3& half_vector() const;
+
         GLfloat& constant_attenuation();
         const GLfloat& constant_attenuation() const;
 
@@ -53,12 +59,17 @@ namespace fixie
         vector3 _spot_direction;
         GLfloat _spot_exponent;
         GLfloat _spot_cutoff;
+        GLfloat _spot_cutoff_cosine;
+        vector3 _half_vector;
         GLfloat _constant_attenuation;
         GLfloat _linear_attenuation;
         GLfloat _quadratic_attenuation;
     };
 
     light get_default_light(size_t idx);
+
+    bool operator==(const light& a, const light& b);
+    bool operator!=(const light& a, const light& b);
 }
 
 #endif // _FIXIE_LIB_LIGHT_HPP_
@@ -7,6 +7,8 @@ namespace fixie
 {
     lighting_state::lighting_state(size_t light_count)
         : _lighting_enabled()
+        , _normalize_enabled()
+        , _rescale_normal_enabled()
         , _front_material()
         , _back_material()
         , _light_model()
@@ -24,6 +26,26 @@ namespace fixie
         return _lighting_enabled;
     }
 
+    GLboolean& lighting_state::normalize_enabled()
+    {
+        return _normalize_enabled;
+    }
+
+    const GLboolean& lighting_state::normalize_enabled() const
+    {
+        return _normalize_enabled;
+    }
+
+    GLboolean& lighting_state::rescale_normal_enabled()
+    {
+        return _rescale_normal_enabled;
+    }
+
+    const GLboolean& lighting_state::rescale_normal_enabled() const
+    {
+        return _rescale_normal_enabled;
+    }
+
     material& lighting_state::front_material()
     {
         return _front_material;
@@ -69,6 +91,8 @@ namespace fixie
         lighting_state state(caps.max_lights());
 
         state.lighting_enabled() = GL_FALSE;
+        state.normalize_enabled() = GL_FALSE;
+        state.rescale_normal_enabled() = GL_FALSE;
         state.front_material() = get_default_material();
         state.back_material() = get_default_material();
         state.light_model() = get_default_light_model();
@@ -19,6 +19,12 @@ namespace fixie
         GLboolean& lighting_enabled();
         const GLboolean& lighting_enabled() const;
 
+        GLboolean& normalize_enabled();
+        const GLboolean& normalize_enabled() const;
+
+        GLboolean& rescale_normal_enabled();
+        const GLboolean& rescale_normal_enabled() const;
+
         material& front_material();
         const material& front_material() const;
 
@@ -33,6 +39,8 @@ namespace fixie
 
     private:
         GLboolean _lighting_enabled;
+        GLboolean _normalize_enabled;
+        GLboolean _rescale_normal_enabled;
 
         material _front_material;
         material _back_material;
@@ -1,14 +1,142 @@
 #include "fixie_lib/log.hpp"
+#include "fixie/fixie_gl_es.h"
 
 #include <iostream>
 #include <string>
+#include <algorithm>
 
 namespace fixie
 {
+    debug_message::debug_message(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& message)
+        : _source(source)
+        , _type(type)
+        , _id(id)
+        , _severity(severity)
+        , _message(message, 0, log::max_message_length - 1)
+    {
+    }
+
+    GLenum debug_message::source() const
+    {
+        return _source;
+    }
+
+    GLenum debug_message::type() const
+    {
+        return _type;
+    }
+
+    GLuint debug_message::id() const
+    {
+        return _id;
+    }
+
+    GLenum debug_message::severity() const
+    {
+        return _severity;
+    }
+
+    const std::string& debug_message::message() const
+    {
+        return _message;
+    }
+
+    debug_group::debug_group(GLenum source, GLuint id, const std::string& message)
+        : _source(source)
+        , _id(id)
+        , _message(message, 0, log::max_message_length - 1)
+    {
+    }
+
+    GLenum debug_group::source() const
+    {
+        return _source;
+    }
+
+    GLuint debug_group::id() const
+    {
+        return _id;
+    }
+
+    const std::string& debug_group::message() const
+    {
+        return _message;
+    }
+
+    const GLsizei log::max_message_length;
+    const GLsizei log::max_logged_messages;
+    const GLsizei log::max_group_depth;
+    const GLsizei log::max_label_length;
+
+    static const size_t invalid_index = static_cast<size_t>(-1);
+
+    static size_t get_source_index(GLenum source)
+    {
+        switch (source)
+        {
+        case GL_DEBUG_SOURCE_API_KHR:             return 0;
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM_KHR:   return 1;
+        case GL_DEBUG_SOURCE_SHADER_COMPILER_KHR: return 2;
+        case GL_DEBUG_SOURCE_THIRD_PARTY_KHR:     return 3;
+        case GL_DEBUG_SOURCE_APPLICATION_KHR:     return 4;
+        case GL_DEBUG_SOURCE_OTHER_KHR:           return 5;
+        default:                                  return invalid_index;
+        }
+    }
+
+    static size_t get_type_index(GLenum type)
+    {
+        switch (type)
+        {
+        case GL_DEBUG_TYPE_ERROR_KHR:               return 0;
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR_KHR: return 1;
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR_KHR:  return 2;
+        case GL_DEBUG_TYPE_PORTABILITY_KHR:         return 3;
+        case GL_DEBUG_TYPE_PERFORMANCE_KHR:         return 4;
+        case GL_DEBUG_TYPE_OTHER_KHR:               return 5;
+        case GL_DEBUG_TYPE_MARKER_KHR:              return 6;
+        case GL_DEBUG_TYPE_PUSH_GROUP_KHR:          return 7;
+        case GL_DEBUG_TYPE_POP_GROUP_KHR:           return 8;
+        default:                                    return invalid_index;
+        }
+    }
+
+    static GLubyte get_severity_bit(GLenum severity)
+    {
+        switch (severity)
+        {
+        case GL_DEBUG_SEVERITY_HIGH_KHR:         return 1 << 0;
+        case GL_DEBUG_SEVERITY_MEDIUM_KHR:       return 1 << 1;
+        case GL_DEBUG_SEVERITY_LOW_KHR:          return 1 << 2;
+        case GL_DEBUG_SEVERITY_NOTIFICATION_KHR: return 1 << 3;
+        default:                                 return 0;
+        }
+    }
+
+    static uint64_t get_id_key(size_t source_index, size_t type_index, GLuint id)
+    {
+        return (static_cast<uint64_t>(source_index) << 40) | (static_cast<uint64_t>(type_index) << 32) | static_cast<uint64_t>(id);
+    }
+
+    log::group_entry::group_entry(const debug_group& group, const message_filter& filter)
+        : group(group)
+        , filter(filter)
+    {
+    }
+
     log::log()
         : _callback(get_default_debug_msg_callback())
+        , _application_callback(nullptr)
         , _user_param(nullptr)
+        , _output_enabled(GL_TRUE)
+        , _output_synchronous(GL_FALSE)
+        , _filter()
+        , _groups()
+        , _messages()
     {
+        GLubyte default_mask = get_severity_bit(GL_DEBUG_SEVERITY_HIGH_KHR) | get_severity_bit(GL_DEBUG_SEVERITY_MEDIUM_KHR) |
+                               get_severity_bit(GL_DEBUG_SEVERITY_NOTIFICATION_KHR);
+        _filter.severity_masks.fill(default_mask);
     }
 
     debug_msg_callback& log::callback()
@@ -31,6 +159,151 @@ namespace fixie
         return _user_param;
     }
 
+    GLDEBUGPROCKHR& log::application_callback()
+    {
+        return _application_callback;
+    }
+
+    const GLDEBUGPROCKHR& log::application_callback() const
+    {
+        return _application_callback;
+    }
+
+    GLboolean& log::output_enabled()
+    {
+        return _output_enabled;
+    }
+
+    const GLboolean& log::output_enabled() const
+    {
+        return _output_enabled;
+    }
+
+    GLboolean& log::output_synchronous()
+    {
+        return _output_synchronous;
+    }
+
+    const GLboolean& log::output_synchronous() const
+    {
+        return _output_synchronous;
+    }
+
+    void log::set_messages_enabled(GLenum source, GLenum type, GLenum severity, GLboolean enabled)
+    {
+        size_t source_index = get_source_index(source);
+        size_t type_index = get_type_index(type);
+        GLubyte severity_mask = (severity == GL_DONT_CARE) ? 0xFF : get_severity_bit(severity);
+
+        for (size_t i = 0; i < source_count; i++)
+        {
+            if (source != GL_DONT_CARE && i != source_index)
+            {
+                continue;
+            }
+
+            for (size_t j = 0; j < type_count; j++)
+            {
+                if (type != GL_DONT_CARE && j != type_index)
+                {
+                    continue;
+                }
+
+                GLubyte& mask = _filter.severity_masks[i * type_count + j];
+                mask = enabled ? (mask | severity_mask) : (mask & ~severity_mask);
+            }
+        }
+
+        for (auto iter = begin(_filter.id_overrides); iter != end(_filter.id_overrides);)
+        {
+            bool source_matches = source == GL_DONT_CARE || (iter->first >> 40) == source_index;
+            bool type_matches = type == GL_DONT_CARE || ((iter->first >> 32) & 0xFF) == type_index;
+            if (source_matches && type_matches)
+            {
+                iter->second.severity_mask &= ~severity_mask;
+            }
+            iter = (iter->second.severity_mask == 0) ? _filter.id_overrides.erase(iter) : ++iter;
+        }
+    }
+
+    void log::set_message_enabled(GLenum source, GLenum type, GLuint id, GLboolean enabled)
+    {
+        id_override& entry = _filter.id_overrides[get_id_key(get_source_index(source), get_type_index(type), id)];
+        entry.severity_mask = 0xFF;
+        entry.enabled = enabled;
+    }
+
+    GLboolean log::message_enabled(GLenum source, GLenum type, GLuint id, GLenum severity) const
+    {
+        if (!_output_enabled)
+        {
+            return GL_FALSE;
+        }
+
+        size_t source_index = get_source_index(source);
+        size_t type_index = get_type_index(type);
+        if (source_index == invalid_index || type_index == invalid_index)
+        {
+            return GL_TRUE;
+        }
+
+        if (!_filter.id_overrides.empty())
+        {
+            auto iter = _filter.id_overrides.find(get_id_key(source_index, type_index, id));
+            if (iter != end(_filter.id_overrides) && (iter->second.severity_mask & get_severity_bit(severity)) != 0)
+            {
+                return iter->second.enabled;
+            }
+        }
+
+        return (_filter.severity_masks[source_index * type_count + type_index] & get_severity_bit(severity)) != 0 ? GL_TRUE : GL_FALSE;
+    }
+
+    void log::insert_message(const debug_message& message)
+    {
+        if (_messages.size() >= static_cast<size_t>(max_logged_messages))
+        {
+            _messages.pop_front();
+        }
+        _messages.push_back(message);
+    }
+
+    size_t log::message_count() const
+    {
+        return _messages.size();
+    }
+
+    const debug_message& log::next_message() const
+    {
+        return _messages.front();
+    }
+
+    void log::pop_message()
+    {
+        _messages.pop_front();
+    }
+
+    void log::push_group(const debug_group& group)
+    {
+        _groups.push_back(group_entry(group, _filter));
+    }
+
+    void log::pop_group()
+    {
+        _filter = _groups.back().filter;
+        _groups.pop_back();
+    }
+
+    size_t log::group_depth() const
+    {
+        return _groups.size() + 1;
+    }
+
+    const debug_group& log::top_group() const
+    {
+        return _groups.back().group;
+    }
+
     static void FIXIE_APIENTRY log_to_stream(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message,
                                              const GLvoid* user_param)
     {
@@ -55,6 +328,9 @@ namespace fixie
         case GL_DEBUG_TYPE_PORTABILITY_KHR:         type_text = "portability";         break;
         case GL_DEBUG_TYPE_PERFORMANCE_KHR:         type_text = "performance";         break;
         case GL_DEBUG_TYPE_OTHER_KHR:               type_text = "other";               break;
+        case GL_DEBUG_TYPE_MARKER_KHR:              type_text = "marker";              break;
+        case GL_DEBUG_TYPE_PUSH_GROUP_KHR:          type_text = "push group";          break;
+        case GL_DEBUG_TYPE_POP_GROUP_KHR:           type_text = "pop group";           break;
         default:                                    type_text = "unknown";             break;
         }
         std::ostream& output_stream = (type == GL_DEBUG_TYPE_ERROR_KHR) ? std::cerr : std::clog;
@@ -62,10 +338,11 @@ namespace fixie
         std::string severity_text;
         switch (severity)
         {
-        case GL_DEBUG_SEVERITY_HIGH_KHR:   severity_text = "high";    break;
-        case GL_DEBUG_SEVERITY_MEDIUM_KHR: severity_text = "medium";  break;
-        case GL_DEBUG_SEVERITY_LOW_KHR:    severity_text = "low";     break;
-        default:                           severity_text = "unknown"; break;
+        case GL_DEBUG_SEVERITY_HIGH_KHR:         severity_text = "high";         break;
+        case GL_DEBUG_SEVERITY_MEDIUM_KHR:       severity_text = "medium";       break;
+        case GL_DEBUG_SEVERITY_LOW_KHR:          severity_text = "low";          break;
+        case GL_DEBUG_SEVERITY_NOTIFICATION_KHR: severity_text = "notification"; break;
+        default:                                 severity_text = "unknown";      break;
         }
 
         output_stream << "fixie debug message: " << std::endl;
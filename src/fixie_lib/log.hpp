@@ -2,6 +2,11 @@
 #define _FIXIE_LIB_LOG_HPP_
 
 #include <functional>
+#include <array>
+#include <deque>
+#include <vector>
+#include <string>
+#include <unordered_map>
 
 #include "fixie/fixie.h"
 #include "fixie/fixie_ext.h"
@@ -11,20 +16,114 @@ namespace fixie
 {
     typedef std::function<void FIXIE_APIENTRY (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const GLvoid* user_param)> debug_msg_callback;
 
+    class debug_message
+    {
+    public:
+        debug_message(GLenum source, GLenum type, GLuint id, GLenum severity, const std::string& message);
+
+        GLenum source() const;
+        GLenum type() const;
+        GLuint id() const;
+        GLenum severity() const;
+        const std::string& message() const;
+
+    private:
+        GLenum _source;
+        GLenum _type;
+        GLuint _id;
+        GLenum _severity;
+        std::string _message;
+    };
+
+    class debug_group
+    {
+    public:
+        debug_group(GLenum source, GLuint id, const std::string& message);
+
+        GLenum source() const;
+        GLuint id() const;
+        const std::string& message() const;
+
+    private:
+        GLenum _source;
+        GLuint _id;
+        std::string _message;
+    };
+
     class log
     {
     public:
+        static const GLsizei max_message_length = 1024;
+        static const GLsizei max_logged_messages = 64;
+        static const GLsizei max_group_depth = 64;
+        static const GLsizei max_label_length = 256;
+
         log();
 
         debug_msg_callback& callback();
         const debug_msg_callback& callback() const;
 
+        GLDEBUGPROCKHR& application_callback();
+        const GLDEBUGPROCKHR& application_callback() const;
+
         GLvoid*& user_param();
         const GLvoid* user_param() const;
 
+        GLboolean& output_enabled();
+        const GLboolean& output_enabled() const;
+
+        GLboolean& output_synchronous();
+        const GLboolean& output_synchronous() const;
+
+        void set_messages_enabled(GLenum source, GLenum type, GLenum severity, GLboolean enabled);
+        void set_message_enabled(GLenum source, GLenum type, GLuint id, GLboolean enabled);
+        GLboolean message_enabled(GLenum source, GLenum type, GLuint id, GLenum severity) const;
+
+        void insert_message(const debug_message& message);
+        size_t message_count() const;
+        const debug_message& next_message() const;
+        void pop_message();
+
+        void push_group(const debug_group& group);
+        void pop_group();
+        size_t group_depth() const;
+        const debug_group& top_group() const;
+
     private:
         debug_msg_callback _callback;
+        GLDEBUGPROCKHR _application_callback;
         GLvoid* _user_param;
+
+        GLboolean _output_enabled;
+        GLboolean _output_synchronous;
+
+        static const size_t source_count = 6;
+        static const size_t type_count = 9;
+
+        // An id override applies to the severities that no later severity based control has covered
+        struct id_override
+        {
+            GLubyte severity_mask;
+            GLboolean enabled;
+        };
+
+        struct message_filter
+        {
+            std::array<GLubyte, source_count * type_count> severity_masks;
+            std::unordered_map<uint64_t, id_override> id_overrides;
+        };
+
+        struct group_entry
+        {
+            group_entry(const debug_group& group, const message_filter& filter);
+
+            debug_group group;
+            message_filter filter;
+        };
+
+        message_filter _filter;
+        std::vector<group_entry> _groups;
+        std::deque<debug_message> _messages;
     };
 
     debug_msg_callback get_default_debug_msg_callback();
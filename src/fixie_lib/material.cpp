@@ -73,4 +73,18 @@ namespace fixie
         mat.specular_exponent() = 0.0f;
         return mat;
     }
+
+    bool operator==(const material& a, const material& b)
+    {
+        return a.ambient() == b.ambient() &&
+               a.diffuse() == b.diffuse() &&
+               a.specular() == b.specular() &&
+               a.emissive() == b.emissive() &&
+               a.specular_exponent() == b.specular_exponent();
+    }
+
+    bool operator!=(const material& a, const material& b)
+    {
+        return !(a == b);
+    }
 }
@@ -35,6 +35,9 @@ namespace fixie
     };
 
     material get_default_material();
+
+    bool operator==(const material& a, const material& b);
+    bool operator!=(const material& a, const material& b);
 }
 
 #endif // _FIXIE_LIB_MATERIAL_HPP_
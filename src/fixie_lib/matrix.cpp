@@ -4,6 +4,25 @@
 
 namespace fixie
 {
+#if defined(FIXIE_SSE2)
+    #define FIXIE_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), _MM_SHUFFLE((w), (z), (y), (x)))
+
+    static inline __m128 matrix2_multiply(__m128 a, __m128 b)
+    {
+        return _mm_add_ps(_mm_mul_ps(a, FIXIE_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(FIXIE_SWIZZLE(a, 1, 0, 3, 2), FIXIE_SWIZZLE(b, 2, 1, 2, 1)));
+    }
+
+    static inline __m128 matrix2_adjoint_multiply(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(FIXIE_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(FIXIE_SWIZZLE(a, 1, 1, 2, 2), FIXIE_SWIZZLE(b, 2, 3, 0, 1)));
+    }
+
+    static inline __m128 matrix2_multiply_adjoint(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(a, FIXIE_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(FIXIE_SWIZZLE(a, 1, 0, 3, 2), FIXIE_SWIZZLE(b, 2, 1, 2, 1)));
+    }
+#endif
+
     matrix4::matrix4()
     {
         _data[ 0] = 1.0f; _data[ 4] = 0.0f; _data[ 8] = 0.0f; _data[12] = 0.0f;
@@ -101,6 +120,55 @@ namespace fixie
 
     matrix4 matrix4::invert(const matrix4& mat)
     {
+#if defined(FIXIE_SSE2)
+        // Block-wise inversion of the 2x2 sub matrices, each stored as a single register
+        __m128 col0 = _mm_loadu_ps(&mat._data[ 0]);
+        __m128 col1 = _mm_loadu_ps(&mat._data[ 4]);
+        __m128 col2 = _mm_loadu_ps(&mat._data[ 8]);
+        __m128 col3 = _mm_loadu_ps(&mat._data[12]);
+
+        __m128 a = _mm_movelh_ps(col0, col1);
+        __m128 b = _mm_movehl_ps(col1, col0);
+        __m128 c = _mm_movelh_ps(col2, col3);
+        __m128 d = _mm_movehl_ps(col3, col2);
+
+        __m128 sub_determinants = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(col0, col2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(col1, col3, _MM_SHUFFLE(3, 1, 3, 1))),
+                                             _mm_mul_ps(_mm_shuffle_ps(col0, col2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(col1, col3, _MM_SHUFFLE(2, 0, 2, 0))));
+        __m128 determinant_a = FIXIE_SWIZZLE(sub_determinants, 0, 0, 0, 0);
+        __m128 determinant_b = FIXIE_SWIZZLE(sub_determinants, 1, 1, 1, 1);
+        __m128 determinant_c = FIXIE_SWIZZLE(sub_determinants, 2, 2, 2, 2);
+        __m128 determinant_d = FIXIE_SWIZZLE(sub_determinants, 3, 3, 3, 3);
+
+        __m128 d_adjoint_c = matrix2_adjoint_multiply(d, c);
+        __m128 a_adjoint_b = matrix2_adjoint_multiply(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(determinant_d, a), matrix2_multiply(b, d_adjoint_c));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(determinant_a, d), matrix2_multiply(c, a_adjoint_b));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(determinant_b, c), matrix2_multiply_adjoint(d, a_adjoint_b));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(determinant_c, b), matrix2_multiply_adjoint(a, d_adjoint_c));
+
+        __m128 trace = _mm_mul_ps(a_adjoint_b, FIXIE_SWIZZLE(d_adjoint_c, 0, 2, 1, 3));
+        trace = _mm_add_ps(trace, FIXIE_SWIZZLE(trace, 2, 3, 0, 1));
+        trace = _mm_add_ps(trace, FIXIE_SWIZZLE(trace, 1, 0, 3, 2));
+
+        __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinant_a, determinant_d), _mm_mul_ps(determinant_b, determinant_c)), trace);
+        if (_mm_cvtss_f32(determinant) == 0.0f)
+        {
+            return identity();
+        }
+
+        __m128 inverse_determinant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+        x = _mm_mul_ps(x, inverse_determinant);
+        y = _mm_mul_ps(y, inverse_determinant);
+        z = _mm_mul_ps(z, inverse_determinant);
+        w = _mm_mul_ps(w, inverse_determinant);
+
+        matrix4 inverted;
+        _mm_storeu_ps(&inverted._data[ 0], _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(&inverted._data[ 4], _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(&inverted._data[ 8], _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(&inverted._data[12], _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+        return inverted;
+#else
         matrix4 inverted( mat._data[ 5] * mat._data[10] * mat._data[15] - mat._data[5] * mat._data[11] * mat._data[14] - mat._data[ 9] * mat._data[ 6] * mat._data[15] + mat._data[ 9] * mat._data[ 7] * mat._data[14] + mat._data[13] * mat._data[ 6] * mat._data[11] - mat._data[13] * mat._data[ 7] * mat._data[10],
                          -mat._data[ 4] * mat._data[10] * mat._data[15] + mat._data[4] * mat._data[11] * mat._data[14] + mat._data[ 8] * mat._data[ 6] * mat._data[15] - mat._data[ 8] * mat._data[ 7] * mat._data[14] - mat._data[12] * mat._data[ 6] * mat._data[11] + mat._data[12] * mat._data[ 7] * mat._data[10],
                           mat._data[ 4] * mat._data[ 9] * mat._data[15] - mat._data[4] * mat._data[11] * mat._data[13] - mat._data[ 8] * mat._data[ 5] * mat._data[15] + mat._data[ 8] * mat._data[ 7] * mat._data[13] + mat._data[12] * mat._data[ 5] * mat._data[11] - mat._data[12] * mat._data[ 7] * mat._data[ 9],
@@ -130,6 +198,7 @@ namespace fixie
         }
 
         return inverted;
+#endif
     }
 
     matrix4 matrix4::transpose(const matrix4& mat)
@@ -149,22 +218,43 @@ namespace fixie
 
     matrix4 operator*(const matrix4& a, const matrix4& b)
     {
-        return matrix4(b(0, 0) * a(0, 0) + b(0, 1) * a(1, 0) + b(0, 2) * a(2, 0) + b(0, 3) * a(3, 0),
-                       b(0, 0) * a(0, 1) + b(0, 1) * a(1, 1) + b(0, 2) * a(2, 1) + b(0, 3) * a(3, 1),
-                       b(0, 0) * a(0, 2) + b(0, 1) * a(1, 2) + b(0, 2) * a(2, 2) + b(0, 3) * a(3, 2),
-                       b(0, 0) * a(0, 3) + b(0, 1) * a(1, 3) + b(0, 2) * a(2, 3) + b(0, 3) * a(3, 3),
-                       b(1, 0) * a(0, 0) + b(1, 1) * a(1, 0) + b(1, 2) * a(2, 0) + b(1, 3) * a(3, 0),
-                       b(1, 0) * a(0, 1) + b(1, 1) * a(1, 1) + b(1, 2) * a(2, 1) + b(1, 3) * a(3, 1),
-                       b(1, 0) * a(0, 2) + b(1, 1) * a(1, 2) + b(1, 2) * a(2, 2) + b(1, 3) * a(3, 2),
-                       b(1, 0) * a(0, 3) + b(1, 1) * a(1, 3) + b(1, 2) * a(2, 3) + b(1, 3) * a(3, 3),
-                       b(2, 0) * a(0, 0) + b(2, 1) * a(1, 0) + b(2, 2) * a(2, 0) + b(2, 3) * a(3, 0),
-                       b(2, 0) * a(0, 1) + b(2, 1) * a(1, 1) + b(2, 2) * a(2, 1) + b(2, 3) * a(3, 1),
-                       b(2, 0) * a(0, 2) + b(2, 1) * a(1, 2) + b(2, 2) * a(2, 2) + b(2, 3) * a(3, 2),
-                       b(2, 0) * a(0, 3) + b(2, 1) * a(1, 3) + b(2, 2) * a(2, 3) + b(2, 3) * a(3, 3),
-                       b(3, 0) * a(0, 0) + b(3, 1) * a(1, 0) + b(3, 2) * a(2, 0) + b(3, 3) * a(3, 0),
-                       b(3, 0) * a(0, 1) + b(3, 1) * a(1, 1) + b(3, 2) * a(2, 1) + b(3, 3) * a(3, 1),
-                       b(3, 0) * a(0, 2) + b(3, 1) * a(1, 2) + b(3, 2) * a(2, 2) + b(3, 3) * a(3, 2),
-                       b(3, 0) * a(0, 3) + b(3, 1) * a(1, 3) + b(3, 2) * a(2, 3) + b(3, 3) * a(3, 3));
+        matrix4 result;
+#if defined(FIXIE_SSE2)
+        __m128 a_col0 = _mm_loadu_ps(&a(0, 0));
+        __m128 a_col1 = _mm_loadu_ps(&a(0, 1));
+        __m128 a_col2 = _mm_loadu_ps(&a(0, 2));
+        __m128 a_col3 = _mm_loadu_ps(&a(0, 3));
+        for (size_t col = 0; col < 4; ++col)
+        {
+            __m128 result_col = _mm_mul_ps(a_col0, _mm_set1_ps(b(0, col)));
+            result_col = _mm_add_ps(result_col, _mm_mul_ps(a_col1, _mm_set1_ps(b(1, col))));
+            result_col = _mm_add_ps(result_col, _mm_mul_ps(a_col2, _mm_set1_ps(b(2, col))));
+            result_col = _mm_add_ps(result_col, _mm_mul_ps(a_col3, _mm_set1_ps(b(3, col))));
+            _mm_storeu_ps(&result(0, col), result_col);
+        }
+#elif defined(FIXIE_NEON)
+        float32x4_t a_col0 = vld1q_f32(&a(0, 0));
+        float32x4_t a_col1 = vld1q_f32(&a(0, 1));
+        float32x4_t a_col2 = vld1q_f32(&a(0, 2));
+        float32x4_t a_col3 = vld1q_f32(&a(0, 3));
+        for (size_t col = 0; col < 4; ++col)
+        {
+            float32x4_t result_col = vmulq_n_f32(a_col0, b(0, col));
+            result_col = vmlaq_n_f32(result_col, a_col1, b(1, col));
+            result_col = vmlaq_n_f32(result_col, a_col2, b(2, col));
+            result_col = vmlaq_n_f32(result_col, a_col3, b(3, col));
+            vst1q_f32(&result(0, col), result_col);
+        }
+#else
+        for (size_t col = 0; col < 4; ++col)
+        {
+            for (size_t row = 0; row < 4; ++row)
+            {
+                result(row, col) = a(row, 0) * b(0, col) + a(row, 1) * b(1, col) + a(row, 2) * b(2, col) + a(row, 3) * b(3, col);
+            }
+        }
+#endif
+        return result;
     }
 
     matrix4& operator*=(matrix4& a, const matrix4& b)
@@ -176,18 +266,24 @@ namespace fixie
     matrix4 operator*(const matrix4& a, GLfloat b)
     {
         matrix4 ret(a);
-        for (size_t i = 0; i < 4; ++i)
-        {
-            for (size_t j = 0; j < 4; ++j)
-            {
-                ret(i, j) *= b;
-            }
-        }
+        ret *= b;
         return ret;
     }
 
     matrix4& operator*=(matrix4& a, GLfloat b)
     {
+#if defined(FIXIE_SSE2)
+        __m128 scale = _mm_set1_ps(b);
+        for (size_t col = 0; col < 4; ++col)
+        {
+            _mm_storeu_ps(&a(0, col), _mm_mul_ps(_mm_loadu_ps(&a(0, col)), scale));
+        }
+#elif defined(FIXIE_NEON)
+        for (size_t col = 0; col < 4; ++col)
+        {
+            vst1q_f32(&a(0, col), vmulq_n_f32(vld1q_f32(&a(0, col)), b));
+        }
+#else
         for (size_t i = 0; i < 4; ++i)
         {
             for (size_t j = 0; j < 4; ++j)
@@ -195,15 +291,36 @@ namespace fixie
                 a(i, j) *= b;
             }
         }
+#endif
         return a;
     }
 
     vector4 operator*(const matrix4& a, const vector4& b)
     {
+#if defined(FIXIE_SSE2)
+        __m128 result = _mm_mul_ps(_mm_loadu_ps(&a(0, 0)), _mm_set1_ps(b.x()));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(&a(0, 1)), _mm_set1_ps(b.y())));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(&a(0, 2)), _mm_set1_ps(b.z())));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(&a(0, 3)), _mm_set1_ps(b.w())));
+
+        vector4 ret;
+        _mm_storeu_ps(&ret.x(), result);
+        return ret;
+#elif defined(FIXIE_NEON)
+        float32x4_t result = vmulq_n_f32(vld1q_f32(&a(0, 0)), b.x());
+        result = vmlaq_n_f32(result, vld1q_f32(&a(0, 1)), b.y());
+        result = vmlaq_n_f32(result, vld1q_f32(&a(0, 2)), b.z());
+        result = vmlaq_n_f32(result, vld1q_f32(&a(0, 3)), b.w());
+
+        vector4 ret;
+        vst1q_f32(&ret.x(), result);
+        return ret;
+#else
         return vector4(a(0, 0) * b.x() + a(0, 1) * b.y() + a(0, 2) * b.z() + a(0, 3) * b.w(),
                        a(1, 0) * b.x() + a(1, 1) * b.y() + a(1, 2) * b.z() + a(1, 3) * b.w(),
                        a(2, 0) * b.x() + a(2, 1) * b.y() + a(2, 2) * b.z() + a(2, 3) * b.w(),
                        a(3, 0) * b.x() + a(3, 1) * b.y() + a(3, 2) * b.z() + a(3, 3) * b.w());
+#endif
     }
 
     bool operator==(const matrix4& a, const matrix4& b)
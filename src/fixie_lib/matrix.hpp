@@ -3,6 +3,7 @@
 
 #include "fixie/fixie_gl_types.h"
 #include "fixie_lib/vector.hpp"
+#include "fixie_lib/simd.hpp"
 
 #include <array>
 
@@ -35,7 +36,7 @@ namespace fixie
         static vector3 transform(const matrix4& mat, const vector3& pt);
 
     private:
-        std::array<GLfloat, 16> _data;
+        FIXIE_ALIGN(16) std::array<GLfloat, 16> _data;
     };
 
     matrix4 operator*(const matrix4& a, const matrix4& b);
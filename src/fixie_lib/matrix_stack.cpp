@@ -1,10 +1,22 @@
 #include "fixie_lib/matrix_stack.hpp"
 
-#include <assert.h>
+#include <atomic>
 
 namespace fixie
 {
+    static uint64_t next_matrix_stack_version()
+    {
+        static std::atomic<uint64_t> version(1);
+        return version.fetch_add(1, std::memory_order_relaxed);
+    }
+
     matrix_stack::matrix_stack()
+        : _stack()
+        , _version(next_matrix_stack_version())
+        , _inverse_transpose()
+        , _inverse_transpose_version(0)
+        , _is_identity(true)
+        , _is_identity_version(0)
     {
         _stack.push_back(matrix4::identity());
     }
@@ -16,23 +28,22 @@ namespace fixie
 
     void matrix_stack::push()
     {
-        _multiplied.push_back(_multiplied.back() * _stack.back());
         _stack.push_back(_stack.back());
+        invalidate();
     }
 
     void matrix_stack::pop()
     {
         if (_stack.size() > 1)
         {
-            assert(_multiplied.size() > 0);
-
             _stack.pop_back();
-            _multiplied.pop_back();
+            invalidate();
         }
     }
 
     matrix4& matrix_stack::top()
     {
+        invalidate();
         return _stack.back();
     }
 
@@ -41,15 +52,45 @@ namespace fixie
         return _stack.back();
     }
 
-    matrix4 matrix_stack::top_multiplied() const
+    const matrix4& matrix_stack::top_multiplied() const
     {
-        return (_multiplied.size() > 0) ? _multiplied.back() * _stack.back() : _stack.back();
+        return _stack.back();
+    }
+
+    const matrix4& matrix_stack::top_inverse_transpose() const
+    {
+        if (_inverse_transpose_version != _version)
+        {
+            _inverse_transpose = matrix4::transpose(matrix4::invert(_stack.back()));
+            _inverse_transpose_version = _version;
+        }
+        return _inverse_transpose;
+    }
+
+    bool matrix_stack::top_is_identity() const
+    {
+        if (_is_identity_version != _version)
+        {
+            _is_identity = (_stack.back() == matrix4::identity());
+            _is_identity_version = _version;
+        }
+        return _is_identity;
+    }
+
+    uint64_t matrix_stack::version() const
+    {
+        return _version;
     }
 
     void matrix_stack::clear()
     {
         _stack.clear();
         _stack.push_back(matrix4::identity());
-        _multiplied.clear();
+        invalidate();
+    }
+
+    void matrix_stack::invalidate()
+    {
+        _version = next_matrix_stack_version();
     }
 }
@@ -2,6 +2,7 @@
 #define _FIXIE_LIB_MATRIX_STACK_HPP_
 
 #include <vector>
+#include <cstdint>
 
 #include "fixie_lib/matrix.hpp"
 
@@ -20,13 +21,25 @@ namespace fixie
         matrix4& top();
         const matrix4& top() const;
 
-        matrix4 top_multiplied() const;
+        const matrix4& top_multiplied() const;
+        const matrix4& top_inverse_transpose() const;
+        bool top_is_identity() const;
+
+        uint64_t version() const;
 
         void clear();
 
     private:
+        void invalidate();
+
         std::vector<matrix4> _stack;
-        std::vector<matrix4> _multiplied;
+        uint64_t _version;
+
+        mutable matrix4 _inverse_transpose;
+        mutable uint64_t _inverse_transpose_version;
+
+        mutable bool _is_identity;
+        mutable uint64_t _is_identity_version;
     };
 }
 
@@ -4,16 +4,26 @@ namespace fixie
 {
     namespace null_impl
     {
+        buffer::buffer(std::shared_ptr<fixie::statistics> statistics)
+            : _statistics(statistics)
+        {
+        }
+
         void buffer::set_type(GLenum type)
         {
         }
 
         void buffer::set_data(GLsizeiptr size, const GLvoid* data, GLenum usage)
         {
+            if (data != nullptr)
+            {
+                _statistics->buffer_upload_bytes() += size;
+            }
         }
 
         void buffer::set_sub_data(GLintptr offset, GLsizeiptr size, const GLvoid* data)
         {
+            _statistics->buffer_upload_bytes() += size;
         }
     }
 }
@@ -2,6 +2,7 @@
 #define _FIXIE_LIB_NULL_BUFFER_HPP_
 
 #include "fixie_lib/buffer.hpp"
+#include "fixie_lib/statistics.hpp"
 
 namespace fixie
 {
@@ -10,9 +11,14 @@ namespace fixie
         class buffer : public fixie::buffer_impl
         {
         public:
+            explicit buffer(std::shared_ptr<fixie::statistics> statistics);
+
             virtual void set_type(GLenum type) override;
             virtual void set_data(GLsizeiptr size, const GLvoid* data, GLenum usage) override;
             virtual void set_sub_data(GLintptr offset, GLsizeiptr size, const GLvoid* data) override;
+
+        private:
+            std::shared_ptr<fixie::statistics> _statistics;
         };
     }
 }
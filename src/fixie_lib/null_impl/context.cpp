@@ -3,11 +3,17 @@
 #include "fixie_lib/null_impl/renderbuffer.hpp"
 #include "fixie_lib/null_impl/framebuffer.hpp"
 #include "fixie_lib/null_impl/buffer.hpp"
+#include "fixie_lib/null_impl/query.hpp"
 
 namespace fixie
 {
     namespace null_impl
     {
+        context::context()
+            : _statistics(std::make_shared<fixie::statistics>())
+        {
+        }
+
         const fixie::caps& context::caps()
         {
             static const fixie::caps caps;
@@ -26,7 +32,7 @@ namespace fixie
 
         std::unique_ptr<texture_impl> context::create_texture()
         {
-            return std::unique_ptr<texture_impl>(new texture());
+            return std::unique_ptr<texture_impl>(new texture(_statistics));
         }
 
         std::unique_ptr<renderbuffer_impl> context::create_renderbuffer()
@@ -46,15 +52,37 @@ namespace fixie
 
         std::unique_ptr<buffer_impl> context::create_buffer()
         {
-            return std::unique_ptr<buffer_impl>(new buffer());
+            return std::unique_ptr<buffer_impl>(new buffer(_statistics));
+        }
+
+        std::unique_ptr<query_impl> context::create_query()
+        {
+            return std::unique_ptr<query_impl>(new query());
         }
 
         void context::draw_arrays(const state& state, GLenum mode, GLint first, GLsizei count)
         {
+            _statistics->draw_calls()++;
         }
 
         void context::draw_elements(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
         {
+            _statistics->draw_calls()++;
+        }
+
+        void context::draw_arrays_instanced(const state& state, GLenum mode, GLint first, GLsizei count, GLsizei instance_count)
+        {
+            _statistics->draw_calls()++;
+        }
+
+        void context::draw_elements_instanced(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count)
+        {
+            _statistics->draw_calls()++;
+        }
+
+        void context::draw_texture_rects(const state& state, const texture_rect_batch& rects)
+        {
+            _statistics->draw_calls()++;
         }
 
         void context::clear(const state& state, GLbitfield mask)
@@ -68,5 +96,39 @@ namespace fixie
         void context::finish()
         {
         }
+
+        void context::push_debug_group(GLenum source, GLuint id, const std::string& message)
+        {
+        }
+
+        void context::pop_debug_group()
+        {
+        }
+
+        void context::set_texture_label(std::weak_ptr<const texture_impl> texture, const std::string& label)
+        {
+        }
+
+        void context::set_buffer_label(std::weak_ptr<const buffer_impl> buffer, const std::string& label)
+        {
+        }
+
+        void context::set_renderbuffer_label(std::weak_ptr<const renderbuffer_impl> renderbuffer, const std::string& label)
+        {
+        }
+
+        void context::set_framebuffer_label(std::weak_ptr<const framebuffer_impl> framebuffer, const std::string& label)
+        {
+        }
+
+        GLuint64 context::timestamp()
+        {
+            return 0;
+        }
+
+        fixie::statistics& context::statistics()
+        {
+            return *_statistics;
+        }
     }
 }
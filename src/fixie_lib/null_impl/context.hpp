@@ -10,6 +10,8 @@ namespace fixie
         class context : public fixie::context_impl
         {
         public:
+            context();
+
             virtual const fixie::caps& caps() override;
             virtual const std::string& renderer_desc() override;
 
@@ -20,14 +22,33 @@ namespace fixie
             virtual std::unique_ptr<framebuffer_impl> create_default_framebuffer() override;
             virtual std::unique_ptr<framebuffer_impl> create_framebuffer() override;
             virtual std::unique_ptr<buffer_impl> create_buffer() override;
+            virtual std::unique_ptr<query_impl> create_query() override;
 
             virtual void draw_arrays(const state& state, GLenum mode, GLint first, GLsizei count) override;
             virtual void draw_elements(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) override;
+            virtual void draw_arrays_instanced(const state& state, GLenum mode, GLint first, GLsizei count, GLsizei instance_count) override;
+            virtual void draw_elements_instanced(const state& state, GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instance_count) override;
+            virtual void draw_texture_rects(const state& state, const texture_rect_batch& rects) override;
 
             virtual void clear(const state& state, GLbitfield mask) override;
 
             virtual void flush() override;
             virtual void finish() override;
+
+            virtual void push_debug_group(GLenum source, GLuint id, const std::string& message) override;
+            virtual void pop_debug_group() override;
+
+            virtual void set_texture_label(std::weak_ptr<const texture_impl> texture, const std::string& label) override;
+            virtual void set_buffer_label(std::weak_ptr<const buffer_impl> buffer, const std::string& label) override;
+            virtual void set_renderbuffer_label(std::weak_ptr<const renderbuffer_impl> renderbuffer, const std::string& label) override;
+            virtual void set_framebuffer_label(std::weak_ptr<const framebuffer_impl> framebuffer, const std::string& label) override;
+
+            virtual GLuint64 timestamp() override;
+
+            virtual fixie::statistics& statistics() override;
+
+        private:
+            std::shared_ptr<fixie::statistics> _statistics;
         };
     }
 }
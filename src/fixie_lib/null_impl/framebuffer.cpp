@@ -7,6 +7,11 @@ namespace fixie
 {
     namespace null_impl
     {
+        framebuffer::framebuffer()
+            : _next_read_pixels_request(0)
+        {
+        }
+
         void framebuffer::set_color_attachment(const framebuffer_attachment& attachment)
         {
         }
@@ -33,6 +38,24 @@ namespace fixie
         {
         }
 
+        GLuint framebuffer::begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type)
+        {
+            return ++_next_read_pixels_request;
+        }
+
+        GLboolean framebuffer::end_read_pixels(GLuint request, GLboolean wait, GLvoid* data)
+        {
+            return GL_TRUE;
+        }
+
+        void framebuffer::invalidate(GLbitfield mask)
+        {
+        }
+
+        void framebuffer::invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height)
+        {
+        }
+
         GLenum framebuffer::status() const 
         {
             return GL_FRAMEBUFFER_COMPLETE_OES;
@@ -10,6 +10,8 @@ namespace fixie
         class framebuffer : public fixie::framebuffer_impl
         {
         public:
+            framebuffer();
+
             virtual void set_color_attachment(const framebuffer_attachment& attachment) override;
             virtual void set_depth_attachment(const framebuffer_attachment& attachment) override;
             virtual void set_stencil_attachment(const framebuffer_attachment& attachment) override;
@@ -17,8 +19,16 @@ namespace fixie
             virtual GLenum preferred_read_format() const override;
             virtual GLenum preferred_read_type() const override;
             virtual void read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* data) override;
+            virtual GLuint begin_read_pixels(const pixel_store_state& store_state, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type) override;
+            virtual GLboolean end_read_pixels(GLuint request, GLboolean wait, GLvoid* data) override;
+
+            virtual void invalidate(GLbitfield mask) override;
+            virtual void invalidate(GLbitfield mask, GLint x, GLint y, GLsizei width, GLsizei height) override;
 
             virtual GLenum status() const override;
+
+        private:
+            GLuint _next_read_pixels_request;
         };
     }
 }
@@ -0,0 +1,31 @@
+#include "fixie_lib/null_impl/query.hpp"
+
+#include "fixie/fixie_gl_es.h"
+
+namespace fixie
+{
+    namespace null_impl
+    {
+        void query::begin(GLenum target)
+        {
+        }
+
+        void query::end(GLenum target)
+        {
+        }
+
+        void query::query_counter(GLenum target)
+        {
+        }
+
+        GLboolean query::result_available()
+        {
+            return GL_TRUE;
+        }
+
+        GLuint64 query::result()
+        {
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef _FIXIE_LIB_NULL_QUERY_HPP_
+#define _FIXIE_LIB_NULL_QUERY_HPP_
+
+#include "fixie_lib/query.hpp"
+
+namespace fixie
+{
+    namespace null_impl
+    {
+        class query : public fixie::query_impl
+        {
+        public:
+            virtual void begin(GLenum target) override;
+            virtual void end(GLenum target) override;
+            virtual void query_counter(GLenum target) override;
+            virtual GLboolean result_available() override;
+            virtual GLuint64 result() override;
+        };
+    }
+}
+
+#endif // _FIXIE_LIB_NULL_QUERY_HPP_
@@ -4,20 +4,32 @@ namespace fixie
 {
     namespace null_impl
     {
+        texture::texture(std::shared_ptr<fixie::statistics> statistics)
+            : _statistics(statistics)
+        {
+        }
+
         void texture::set_data(const pixel_store_state& store_state, GLint level, GLenum internal_format, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels)
         {
+            if (pixels != nullptr)
+            {
+                _statistics->texture_upload_bytes() += unpacked_image_size(store_state, width, height, format, type);
+            }
         }
 
         void texture::set_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels)
         {
+            _statistics->texture_upload_bytes() += unpacked_image_size(store_state, width, height, format, type);
         }
 
         void texture::set_compressed_data(const pixel_store_state& store_state, GLint level, GLenum internal_format, GLsizei width, GLsizei height, GLsizei image_size, const GLvoid *data)
         {
+            _statistics->texture_upload_bytes() += image_size;
         }
 
         void texture::set_compressed_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei image_size, const GLvoid *data)
         {
+            _statistics->texture_upload_bytes() += image_size;
         }
 
         void texture::set_storage(GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height)
@@ -28,7 +40,7 @@ namespace fixie
         {
         }
 
-        void texture::copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, std::weak_ptr<const framebuffer_impl> source)
+        void texture::copy_sub_data(GLint level, GLenum internal_format, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source)
         {
         }
 
@@ -0,0 +1,67 @@
+#include "fixie_lib/pixel_conversion.hpp"
+#include "fixie_lib/simd.hpp"
+#include "fixie_lib/tracer.hpp"
+
+#include <cstring>
+
+namespace fixie
+{
+    static void swap_red_blue_row(const GLubyte* source, GLubyte* destination, size_t pixel_count)
+    {
+        size_t pixel = 0;
+#if defined(FIXIE_SSE2)
+        const __m128i green_alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+        const __m128i low_byte_mask = _mm_set1_epi32(0x000000FF);
+        for (; pixel + 4 <= pixel_count; pixel += 4)
+        {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + pixel * 4));
+            __m128i green_alpha = _mm_and_si128(pixels, green_alpha_mask);
+            __m128i first = _mm_and_si128(pixels, low_byte_mask);
+            __m128i third = _mm_and_si128(_mm_srli_epi32(pixels, 16), low_byte_mask);
+            __m128i swapped = _mm_or_si128(green_alpha, _mm_or_si128(_mm_slli_epi32(first, 16), third));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + pixel * 4), swapped);
+        }
+#elif defined(FIXIE_NEON)
+        for (; pixel + 16 <= pixel_count; pixel += 16)
+        {
+            uint8x16x4_t pixels = vld4q_u8(source + pixel * 4);
+            uint8x16_t first = pixels.val[0];
+            pixels.val[0] = pixels.val[2];
+            pixels.val[2] = first;
+            vst4q_u8(destination + pixel * 4, pixels);
+        }
+#endif
+        for (; pixel < pixel_count; pixel++)
+        {
+            const GLubyte* source_pixel = source + pixel * 4;
+            GLubyte* destination_pixel = destination + pixel * 4;
+            GLubyte first = source_pixel[0];
+            destination_pixel[0] = source_pixel[2];
+            destination_pixel[1] = source_pixel[1];
+            destination_pixel[2] = first;
+            destination_pixel[3] = source_pixel[3];
+        }
+    }
+
+    void copy_packed_pixels(const GLvoid* source, GLvoid* destination, GLsizeiptr row_size, GLsizeiptr row_pitch, GLsizei height,
+                            GLboolean swap_red_blue, GLboolean reverse_rows)
+    {
+        FIXIE_TRACE_SCOPE("readback", "copy_packed_pixels");
+
+        const GLubyte* source_bytes = static_cast<const GLubyte*>(source);
+        GLubyte* destination_bytes = static_cast<GLubyte*>(destination);
+        for (GLsizei row = 0; row < height; row++)
+        {
+            const GLubyte* source_row = source_bytes + row * row_pitch;
+            GLubyte* destination_row = destination_bytes + (reverse_rows ? (height - 1 - row) : row) * row_pitch;
+            if (swap_red_blue)
+            {
+                swap_red_blue_row(source_row, destination_row, static_cast<size_t>(row_size / 4));
+            }
+            else
+            {
+                std::memcpy(destination_row, source_row, static_cast<size_t>(row_size));
+            }
+        }
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef _FIXIE_LIB_PIXEL_CONVERSION_HPP_
+#define _FIXIE_LIB_PIXEL_CONVERSION_HPP_
+
+#include "fixie/fixie_gl_types.h"
+
+namespace fixie
+{
+    // Copies height rows of row_size bytes between images with row_pitch byte rows. Four byte pixels have their first
+    // and third channels exchanged when swap_red_blue is set and the rows are written bottom up when reverse_rows is set.
+    void copy_packed_pixels(const GLvoid* source, GLvoid* destination, GLsizeiptr row_size, GLsizeiptr row_pitch, GLsizei height,
+                            GLboolean swap_red_blue, GLboolean reverse_rows);
+}
+
+#endif // _FIXIE_LIB_PIXEL_CONVERSION_HPP_
@@ -1,10 +1,16 @@
 #include "fixie_lib/pixel_store_state.hpp"
 
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+
+#include <algorithm>
+
 namespace fixie
 {
     pixel_store_state::pixel_store_state()
         : _unpack_alignment()
         , _pack_alignment()
+        , _pack_reverse_row_order()
     {
     }
 
@@ -28,11 +34,90 @@ namespace fixie
         return _pack_alignment;
     }
 
+    const GLboolean& pixel_store_state::pack_reverse_row_order() const
+    {
+        return _pack_reverse_row_order;
+    }
+
+    GLboolean& pixel_store_state::pack_reverse_row_order()
+    {
+        return _pack_reverse_row_order;
+    }
+
     pixel_store_state default_pixel_store_state()
     {
         pixel_store_state state;
         state.unpack_alignment() = 4;
         state.pack_alignment() = 4;
+        state.pack_reverse_row_order() = GL_FALSE;
         return state;
     }
+
+    static GLsizei format_component_count(GLenum format)
+    {
+        switch (format)
+        {
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+            return 1;
+
+        case GL_LUMINANCE_ALPHA:
+            return 2;
+
+        case GL_RGB:
+            return 3;
+
+        case GL_RGBA:
+        case GL_BGRA_EXT:
+            return 4;
+
+        default:
+            return 0;
+        }
+    }
+
+    GLsizei pixel_size(GLenum format, GLenum type)
+    {
+        switch (type)
+        {
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            return 2;
+
+        case GL_FLOAT:
+            return format_component_count(format) * 4;
+
+        default:
+            return format_component_count(format);
+        }
+    }
+
+    static GLsizeiptr aligned_row_size(GLint alignment, GLsizei width, GLenum format, GLenum type)
+    {
+        const GLsizeiptr row_alignment = std::max(alignment, 1);
+        const GLsizeiptr row_size = static_cast<GLsizeiptr>(width) * pixel_size(format, type);
+        return ((row_size + row_alignment - 1) / row_alignment) * row_alignment;
+    }
+
+    static GLsizeiptr aligned_image_size(GLint alignment, GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        const GLsizeiptr row_size = static_cast<GLsizeiptr>(width) * pixel_size(format, type);
+        return (height > 0) ? aligned_row_size(alignment, width, format, type) * (height - 1) + row_size : 0;
+    }
+
+    GLsizeiptr packed_row_pitch(const pixel_store_state& store_state, GLsizei width, GLenum format, GLenum type)
+    {
+        return aligned_row_size(store_state.pack_alignment(), width, format, type);
+    }
+
+    GLsizeiptr unpacked_image_size(const pixel_store_state& store_state, GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        return aligned_image_size(store_state.unpack_alignment(), width, height, format, type);
+    }
+
+    GLsizeiptr packed_image_size(const pixel_store_state& store_state, GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        return aligned_image_size(store_state.pack_alignment(), width, height, format, type);
+    }
 }
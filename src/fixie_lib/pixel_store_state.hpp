@@ -16,12 +16,22 @@ namespace fixie
         const GLint& pack_alignment() const;
         GLint& pack_alignment();
 
+        const GLboolean& pack_reverse_row_order() const;
+        GLboolean& pack_reverse_row_order();
+
     private:
         GLint _unpack_alignment;
         GLint _pack_alignment;
+        GLboolean _pack_reverse_row_order;
     };
 
     pixel_store_state default_pixel_store_state();
+
+    GLsizei pixel_size(GLenum format, GLenum type);
+    GLsizeiptr packed_row_pitch(const pixel_store_state& store_state, GLsizei width, GLenum format, GLenum type);
+
+    GLsizeiptr unpacked_image_size(const pixel_store_state& store_state, GLsizei width, GLsizei height, GLenum format, GLenum type);
+    GLsizeiptr packed_image_size(const pixel_store_state& store_state, GLsizei width, GLsizei height, GLenum format, GLenum type);
 }
 
 #endif // _FIXIE_LIB_PIXEL_STORE_STATE_HPP_
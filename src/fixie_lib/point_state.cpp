@@ -74,12 +74,12 @@ namespace fixie
         return _point_sprite_enabled;
     }
 
-    point_state default_point_state()
+    point_state default_point_state(const caps& caps)
     {
         point_state state;
         state.point_size() = 1.0f;
         state.point_smooth_enabled() = GL_FALSE;
-        state.point_size_range() = range(0.0f, 1.0f);
+        state.point_size_range() = range(0.0f, caps.aliased_point_size_range().far());
         state.point_fade_threshold() = 1.0f;
         state.point_distance_attenuation() = vector3(1.0f, 0.0f, 0.0f);
         state.point_sprite_enabled() = GL_FALSE;
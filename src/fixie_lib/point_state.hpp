@@ -4,6 +4,7 @@
 #include "fixie/fixie_gl_types.h"
 #include "fixie_lib/range.hpp"
 #include "fixie_lib/vector.hpp"
+#include "fixie_lib/caps.hpp"
 
 namespace fixie
 {
@@ -39,7 +40,7 @@ namespace fixie
         GLboolean _point_sprite_enabled;
     };
 
-    point_state default_point_state();
+    point_state default_point_state(const caps& caps);
 }
 
 #endif // _FIXIE_LIB_POINT_STATE_HPP_
@@ -0,0 +1,206 @@
+#include "fixie_lib/profiler.hpp"
+#include "fixie_lib/debug.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+
+namespace fixie
+{
+    static const size_t max_entry_points = 1024;
+    static const size_t no_entry_point = static_cast<size_t>(-1);
+
+    struct thread_entry_point_counter
+    {
+        std::atomic<GLuint64> calls;
+        std::atomic<GLuint64> total_ns;
+        std::atomic<GLuint64> max_ns;
+        std::atomic<GLuint64> errors;
+    };
+
+    struct thread_entry_point_counters
+    {
+        thread_entry_point_counters()
+            : counters()
+            , current(no_entry_point)
+        {
+        }
+
+        std::array<thread_entry_point_counter, max_entry_points> counters;
+        size_t current;
+    };
+
+    struct retired_entry_point_counter
+    {
+        GLuint64 calls;
+        GLuint64 total_ns;
+        GLuint64 max_ns;
+        GLuint64 errors;
+    };
+
+    static std::mutex registry_mutex;
+    static std::vector<std::string> entry_point_names;
+    static std::vector< std::shared_ptr<thread_entry_point_counters> > all_thread_counters;
+    static std::array<retired_entry_point_counter, max_entry_points> retired_counters;
+
+    // Owns the table of the calling thread, when the thread exits its counts are folded into the retired totals and
+    // the table is released
+    struct thread_counters_owner
+    {
+        ~thread_counters_owner();
+
+        std::shared_ptr<thread_entry_point_counters> counters;
+    };
+
+    static thread_local thread_entry_point_counters* thread_counters = nullptr;
+    static thread_local thread_counters_owner thread_owner;
+
+    thread_counters_owner::~thread_counters_owner()
+    {
+        if (counters == nullptr)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (size_t i = 0; i < entry_point_names.size(); i++)
+        {
+            const thread_entry_point_counter& counter = counters->counters[i];
+            retired_entry_point_counter& retired = retired_counters[i];
+            retired.calls += counter.calls.load(std::memory_order_relaxed);
+            retired.total_ns += counter.total_ns.load(std::memory_order_relaxed);
+            retired.max_ns = std::max(retired.max_ns, counter.max_ns.load(std::memory_order_relaxed));
+            retired.errors += counter.errors.load(std::memory_order_relaxed);
+        }
+
+        all_thread_counters.erase(std::remove(begin(all_thread_counters), end(all_thread_counters), counters), end(all_thread_counters));
+        thread_counters = nullptr;
+    }
+
+    static thread_entry_point_counters* get_thread_counters()
+    {
+        if (thread_counters == nullptr)
+        {
+            std::shared_ptr<thread_entry_point_counters> counters = std::make_shared<thread_entry_point_counters>();
+
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            all_thread_counters.push_back(counters);
+            thread_owner.counters = counters;
+            thread_counters = counters.get();
+        }
+        return thread_counters;
+    }
+
+    static void increment(std::atomic<GLuint64>& value, GLuint64 amount)
+    {
+        // Resets from other threads may land at any time, an atomic add never overwrites them
+        value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    static void update_max(std::atomic<GLuint64>& value, GLuint64 candidate)
+    {
+        GLuint64 current = value.load(std::memory_order_relaxed);
+        while (candidate > current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    entry_point_counters::entry_point_counters()
+        : name()
+        , calls(0)
+        , total_ns(0)
+        , max_ns(0)
+        , errors(0)
+    {
+    }
+
+    size_t register_entry_point(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (entry_point_names.size() >= max_entry_points)
+        {
+            UNREACHABLE();
+            return no_entry_point;
+        }
+
+        entry_point_names.push_back(name);
+        return entry_point_names.size() - 1;
+    }
+
+    void record_entry_point_error()
+    {
+        thread_entry_point_counters* counters = get_thread_counters();
+        if (counters->current != no_entry_point)
+        {
+            increment(counters->counters[counters->current].errors, 1);
+        }
+    }
+
+    std::vector<entry_point_counters> get_entry_point_counters()
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        std::vector<entry_point_counters> result(entry_point_names.size());
+        for (size_t i = 0; i < entry_point_names.size(); i++)
+        {
+            result[i].name = entry_point_names[i];
+            result[i].calls = retired_counters[i].calls;
+            result[i].total_ns = retired_counters[i].total_ns;
+            result[i].max_ns = retired_counters[i].max_ns;
+            result[i].errors = retired_counters[i].errors;
+            for (auto iter = begin(all_thread_counters); iter != end(all_thread_counters); ++iter)
+            {
+                const thread_entry_point_counter& counter = (*iter)->counters[i];
+                result[i].calls += counter.calls.load(std::memory_order_relaxed);
+                result[i].total_ns += counter.total_ns.load(std::memory_order_relaxed);
+                result[i].max_ns = std::max(result[i].max_ns, counter.max_ns.load(std::memory_order_relaxed));
+                result[i].errors += counter.errors.load(std::memory_order_relaxed);
+            }
+        }
+
+        return result;
+    }
+
+    void reset_entry_point_counters()
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        retired_counters.fill(retired_entry_point_counter());
+        for (auto iter = begin(all_thread_counters); iter != end(all_thread_counters); ++iter)
+        {
+            for (size_t i = 0; i < entry_point_names.size(); i++)
+            {
+                thread_entry_point_counter& counter = (*iter)->counters[i];
+                counter.calls.exchange(0, std::memory_order_relaxed);
+                counter.total_ns.exchange(0, std::memory_order_relaxed);
+                counter.max_ns.exchange(0, std::memory_order_relaxed);
+                counter.errors.exchange(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    entry_point_timer::entry_point_timer(size_t id)
+        : _counters(get_thread_counters())
+        , _id(id)
+        , _parent_id(_counters->current)
+        , _start(std::chrono::steady_clock::now())
+    {
+        _counters->current = _id;
+    }
+
+    entry_point_timer::~entry_point_timer()
+    {
+        if (_id != no_entry_point)
+        {
+            GLuint64 elapsed = static_cast<GLuint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count());
+
+            thread_entry_point_counter& counter = _counters->counters[_id];
+            increment(counter.calls, 1);
+            increment(counter.total_ns, elapsed);
+            update_max(counter.max_ns, elapsed);
+        }
+
+        _counters->current = _parent_id;
+    }
+}
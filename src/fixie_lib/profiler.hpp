@@ -0,0 +1,62 @@
+#ifndef _FIXIE_LIB_PROFILER_HPP_
+#define _FIXIE_LIB_PROFILER_HPP_
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "fixie/fixie_gl_types.h"
+#include "fixie_lib/tracer.hpp"
+
+namespace fixie
+{
+    struct thread_entry_point_counters;
+
+    struct entry_point_counters
+    {
+        entry_point_counters();
+
+        std::string name;
+        GLuint64 calls;
+        GLuint64 total_ns;
+        GLuint64 max_ns;
+        GLuint64 errors;
+    };
+
+    size_t register_entry_point(const char* name);
+    void record_entry_point_error();
+
+    std::vector<entry_point_counters> get_entry_point_counters();
+    void reset_entry_point_counters();
+
+    class entry_point_timer
+    {
+    public:
+        explicit entry_point_timer(size_t id);
+        ~entry_point_timer();
+
+    private:
+        thread_entry_point_counters* _counters;
+        size_t _id;
+        size_t _parent_id;
+        std::chrono::steady_clock::time_point _start;
+    };
+}
+
+// Entry points are always traced, the runtime tracer decides whether the scope is recorded, call counters and
+// timings are only compiled in profiling builds
+#if defined(FIXIE_PROFILING)
+    #define FIXIE_COUNT_ENTRY_POINT() \
+        static const size_t fixie_entry_point_id = fixie::register_entry_point(__FUNCTION__); \
+        fixie::entry_point_timer fixie_entry_point_timer(fixie_entry_point_id)
+#else
+    #define FIXIE_COUNT_ENTRY_POINT() \
+        do { } while (0)
+#endif
+
+#define FIXIE_PROFILE_ENTRY_POINT() \
+    FIXIE_COUNT_ENTRY_POINT(); \
+    FIXIE_TRACE_SCOPE("entry_point", __FUNCTION__)
+
+#endif // _FIXIE_LIB_PROFILER_HPP_
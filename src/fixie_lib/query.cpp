@@ -0,0 +1,62 @@
+#include "fixie_lib/query.hpp"
+
+#include "fixie/fixie_gl_es.h"
+
+namespace fixie
+{
+    query::query(std::unique_ptr<query_impl> impl)
+        : _target(0)
+        , _active(GL_FALSE)
+        , _impl(std::move(impl))
+    {
+    }
+
+    GLenum query::target() const
+    {
+        return _target;
+    }
+
+    GLboolean query::active() const
+    {
+        return _active;
+    }
+
+    void query::begin(GLenum target)
+    {
+        _impl->begin(target);
+        _target = target;
+        _active = GL_TRUE;
+    }
+
+    void query::end()
+    {
+        _impl->end(_target);
+        _active = GL_FALSE;
+    }
+
+    void query::query_counter(GLenum target)
+    {
+        _impl->query_counter(target);
+        _target = target;
+    }
+
+    GLboolean query::result_available()
+    {
+        return _impl->result_available();
+    }
+
+    GLuint64 query::result()
+    {
+        return _impl->result();
+    }
+
+    std::weak_ptr<query_impl> query::impl()
+    {
+        return _impl;
+    }
+
+    std::weak_ptr<const query_impl> query::impl() const
+    {
+        return _impl;
+    }
+}
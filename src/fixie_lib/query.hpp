@@ -0,0 +1,49 @@
+#ifndef _FIXIE_LIB_QUERY_HPP_
+#define _FIXIE_LIB_QUERY_HPP_
+
+#include <memory>
+
+#include "fixie/fixie_gl_types.h"
+#include "fixie_lib/noncopyable.hpp"
+
+namespace fixie
+{
+    class query_impl : public noncopyable
+    {
+    public:
+        virtual ~query_impl() { }
+
+        virtual void begin(GLenum target) = 0;
+        virtual void end(GLenum target) = 0;
+        virtual void query_counter(GLenum target) = 0;
+        virtual GLboolean result_available() = 0;
+        virtual GLuint64 result() = 0;
+    };
+
+    class query : public noncopyable
+    {
+    public:
+        explicit query(std::unique_ptr<query_impl> impl);
+
+        GLenum target() const;
+        GLboolean active() const;
+
+        void begin(GLenum target);
+        void end();
+        void query_counter(GLenum target);
+
+        GLboolean result_available();
+        GLuint64 result();
+
+        std::weak_ptr<query_impl> impl();
+        std::weak_ptr<const query_impl> impl() const;
+
+    private:
+        GLenum _target;
+        GLboolean _active;
+
+        std::shared_ptr<query_impl> _impl;
+    };
+}
+
+#endif // _FIXIE_LIB_QUERY_HPP_
@@ -7,6 +7,7 @@ namespace fixie
         , _samples(0)
         , _width(0)
         , _height(0)
+        , _label()
         , _impl(std::move(impl))
     {
     }
@@ -56,6 +57,11 @@ namespace fixie
         return _internal_format;
     }
 
+    GLsizei renderbuffer::samples() const
+    {
+        return _samples;
+    }
+
     void renderbuffer::set_storage(GLenum target, GLenum internal_format, GLsizei width, GLsizei height)
     {
         _impl->set_storage(target, internal_format, width, height);
@@ -76,6 +82,16 @@ namespace fixie
         _height = height;
     }
 
+    std::string& renderbuffer::label()
+    {
+        return _label;
+    }
+
+    const std::string& renderbuffer::label() const
+    {
+        return _label;
+    }
+
     std::weak_ptr<renderbuffer_impl> renderbuffer::impl()
     {
         return _impl;
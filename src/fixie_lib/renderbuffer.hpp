@@ -2,6 +2,7 @@
 #define _FIXIE_LIB_RENDERBUFFER_HPP_
 
 #include <memory>
+#include <string>
 
 #include "fixie/fixie_gl_types.h"
 #include "fixie_lib/noncopyable.hpp"
@@ -38,10 +39,14 @@ namespace fixie
         GLsizei height() const;
 
         GLenum internal_format() const;
+        GLsizei samples() const;
 
         void set_storage(GLenum target, GLenum internal_format, GLsizei width, GLsizei height);
         void set_storage_multisample(GLenum target, GLsizei samples, GLenum internal_format, GLsizei width, GLsizei height);
 
+        std::string& label();
+        const std::string& label() const;
+
         std::weak_ptr<renderbuffer_impl> impl();
         std::weak_ptr<const renderbuffer_impl> impl() const;
 
@@ -51,6 +56,8 @@ namespace fixie
         GLsizei _width;
         GLsizei _height;
 
+        std::string _label;
+
         std::shared_ptr<renderbuffer_impl> _impl;
     };
 }
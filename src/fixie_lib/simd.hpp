@@ -0,0 +1,20 @@
+#ifndef _FIXIE_LIB_SIMD_HPP_
+#define _FIXIE_LIB_SIMD_HPP_
+
+#if !defined(FIXIE_DISABLE_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define FIXIE_SSE2 1
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define FIXIE_NEON 1
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(_MSC_VER)
+    #define FIXIE_ALIGN(alignment) __declspec(align(alignment))
+#else
+    #define FIXIE_ALIGN(alignment) alignas(alignment)
+#endif
+
+#endif // _FIXIE_LIB_SIMD_HPP_
@@ -15,7 +15,7 @@ namespace fixie
         , _color_buffer_state(default_color_buffer_state())
         , _depth_buffer_state(default_depth_buffer_state())
         , _stencil_buffer_state(default_stencil_buffer_state())
-        , _point_state(default_point_state())
+        , _point_state(default_point_state(caps))
         , _line_state(default_line_state())
         , _polygon_state(default_polygon_state())
         , _multisample_state(default_multisample_state())
@@ -27,12 +27,16 @@ namespace fixie
         , _active_texture_unit(0)
         , _matrix_mode(GL_MODELVIEW)
         , _texture_matrix_stacks(caps.max_texture_units())
+        , _matrix_palette_enabled(GL_FALSE)
+        , _current_palette_matrix(0)
+        , _palette_matrix_stacks(caps.max_palette_matrices())
         , _bound_textures(caps.max_texture_units())
         , _texture_environments(caps.max_texture_units())
         , _bound_framebuffer()
         , _bound_array_buffer()
         , _bound_element_array_buffer()
         , _bound_vertex_array()
+        , _active_query()
         , _active_client_texture(0)
         , _shade_model(GL_SMOOTH)
         , _error(GL_NO_ERROR)
@@ -221,6 +225,36 @@ namespace fixie
         return _projection_matrix_stack;
     }
 
+    GLboolean& state::matrix_palette_enabled()
+    {
+        return _matrix_palette_enabled;
+    }
+
+    const GLboolean& state::matrix_palette_enabled() const
+    {
+        return _matrix_palette_enabled;
+    }
+
+    size_t& state::current_palette_matrix()
+    {
+        return _current_palette_matrix;
+    }
+
+    const size_t& state::current_palette_matrix() const
+    {
+        return _current_palette_matrix;
+    }
+
+    matrix_stack& state::palette_matrix_stack(size_t idx)
+    {
+        return _palette_matrix_stacks[idx];
+    }
+
+    const matrix_stack& state::palette_matrix_stack(size_t idx) const
+    {
+        return _palette_matrix_stacks[idx];
+    }
+
     size_t& state::active_texture_unit()
     {
         return _active_texture_unit;
@@ -351,6 +385,21 @@ namespace fixie
         return _bound_vertex_array;
     }
 
+    void state::set_active_query(std::weak_ptr<fixie::query> query)
+    {
+        _active_query = query;
+    }
+
+    std::weak_ptr<const fixie::query> state::active_query() const
+    {
+        return _active_query;
+    }
+
+    std::weak_ptr<fixie::query> state::active_query()
+    {
+        return _active_query;
+    }
+
     size_t& state::active_client_texture()
     {
         return _active_client_texture;
@@ -31,6 +31,7 @@
 #include "fixie_lib/buffer.hpp"
 #include "fixie_lib/framebuffer.hpp"
 #include "fixie_lib/vertex_array.hpp"
+#include "fixie_lib/query.hpp"
 #include "fixie_lib/texture_environment.hpp"
 
 namespace fixie
@@ -94,6 +95,15 @@ namespace fixie
         matrix_stack& projection_matrix_stack();
         const matrix_stack& projection_matrix_stack() const;
 
+        GLboolean& matrix_palette_enabled();
+        const GLboolean& matrix_palette_enabled() const;
+
+        size_t& current_palette_matrix();
+        const size_t& current_palette_matrix() const;
+
+        matrix_stack& palette_matrix_stack(size_t idx);
+        const matrix_stack& palette_matrix_stack(size_t idx) const;
+
         size_t& active_texture_unit();
         const size_t& active_texture_unit() const;
 
@@ -124,6 +134,10 @@ namespace fixie
         std::weak_ptr<const fixie::vertex_array> bound_vertex_array() const;
         std::weak_ptr<fixie::vertex_array> bound_vertex_array();
 
+        void set_active_query(std::weak_ptr<fixie::query> query);
+        std::weak_ptr<const fixie::query> active_query() const;
+        std::weak_ptr<fixie::query> active_query();
+
         size_t& active_client_texture();
         const size_t& active_client_texture() const;
 
@@ -164,6 +178,10 @@ namespace fixie
         matrix_stack _model_view_matrix_stack;
         matrix_stack _projection_matrix_stack;
 
+        GLboolean _matrix_palette_enabled;
+        size_t _current_palette_matrix;
+        std::vector<matrix_stack> _palette_matrix_stacks;
+
         std::vector< std::weak_ptr<fixie::texture> > _bound_textures;
         std::vector<fixie::texture_environment> _texture_environments;
 
@@ -176,6 +194,8 @@ namespace fixie
 
         std::weak_ptr<fixie::vertex_array> _bound_vertex_array;
 
+        std::weak_ptr<fixie::query> _active_query;
+
         size_t _active_client_texture;
 
         GLenum _shade_model;
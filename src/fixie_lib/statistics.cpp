@@ -0,0 +1,107 @@
+#include "fixie_lib/statistics.hpp"
+
+namespace fixie
+{
+    statistics::statistics()
+        : _draw_calls()
+        , _state_changes()
+        , _redundant_state_changes()
+        , _uniform_uploads()
+        , _shader_cache_hits()
+        , _shader_cache_misses()
+        , _shader_compile_time()
+        , _buffer_upload_bytes()
+        , _texture_upload_bytes()
+    {
+    }
+
+    const GLuint64& statistics::draw_calls() const
+    {
+        return _draw_calls;
+    }
+
+    GLuint64& statistics::draw_calls()
+    {
+        return _draw_calls;
+    }
+
+    const GLuint64& statistics::state_changes() const
+    {
+        return _state_changes;
+    }
+
+    GLuint64& statistics::state_changes()
+    {
+        return _state_changes;
+    }
+
+    const GLuint64& statistics::redundant_state_changes() const
+    {
+        return _redundant_state_changes;
+    }
+
+    GLuint64& statistics::redundant_state_changes()
+    {
+        return _redundant_state_changes;
+    }
+
+    const GLuint64& statistics::uniform_uploads() const
+    {
+        return _uniform_uploads;
+    }
+
+    GLuint64& statistics::uniform_uploads()
+    {
+        return _uniform_uploads;
+    }
+
+    const GLuint64& statistics::shader_cache_hits() const
+    {
+        return _shader_cache_hits;
+    }
+
+    GLuint64& statistics::shader_cache_hits()
+    {
+        return _shader_cache_hits;
+    }
+
+    const GLuint64& statistics::shader_cache_misses() const
+    {
+        return _shader_cache_misses;
+    }
+
+    GLuint64& statistics::shader_cache_misses()
+    {
+        return _shader_cache_misses;
+    }
+
+    const GLuint64& statistics::shader_compile_time() const
+    {
+        return _shader_compile_time;
+    }
+
+    GLuint64& statistics::shader_compile_time()
+    {
+        return _shader_compile_time;
+    }
+
+    const GLuint64& statistics::buffer_upload_bytes() const
+    {
+        return _buffer_upload_bytes;
+    }
+
+    GLuint64& statistics::buffer_upload_bytes()
+    {
+        return _buffer_upload_bytes;
+    }
+
+    const GLuint64& statistics::texture_upload_bytes() const
+    {
+        return _texture_upload_bytes;
+    }
+
+    GLuint64& statistics::texture_upload_bytes()
+    {
+        return _texture_upload_bytes;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef _FIXIE_LIB_STATISTICS_HPP_
+#define _FIXIE_LIB_STATISTICS_HPP_
+
+#include "fixie/fixie_gl_types.h"
+
+namespace fixie
+{
+    class statistics
+    {
+    public:
+        statistics();
+
+        const GLuint64& draw_calls() const;
+        GLuint64& draw_calls();
+
+        const GLuint64& state_changes() const;
+        GLuint64& state_changes();
+
+        const GLuint64& redundant_state_changes() const;
+        GLuint64& redundant_state_changes();
+
+        const GLuint64& uniform_uploads() const;
+        GLuint64& uniform_uploads();
+
+        const GLuint64& shader_cache_hits() const;
+        GLuint64& shader_cache_hits();
+
+        const GLuint64& shader_cache_misses() const;
+        GLuint64& shader_cache_misses();
+
+        const GLuint64& shader_compile_time() const;
+        GLuint64& shader_compile_time();
+
+        const GLuint64& buffer_upload_bytes() const;
+        GLuint64& buffer_upload_bytes();
+
+        const GLuint64& texture_upload_bytes() const;
+        GLuint64& texture_upload_bytes();
+
+    private:
+        GLuint64 _draw_calls;
+        GLuint64 _state_changes;
+        GLuint64 _redundant_state_changes;
+        GLuint64 _uniform_uploads;
+        GLuint64 _shader_cache_hits;
+        GLuint64 _shader_cache_misses;
+        GLuint64 _shader_compile_time;
+        GLuint64 _buffer_upload_bytes;
+        GLuint64 _texture_upload_bytes;
+    };
+}
+
+#endif // _FIXIE_LIB_STATISTICS_HPP_
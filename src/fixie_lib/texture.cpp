@@ -11,7 +11,9 @@ namespace fixie
     texture::texture(std::unique_ptr<texture_impl> impl)
         : _sampler_state(get_default_sampler_state())
         , _auto_generate_mipmap(GL_FALSE)
+        , _crop_rect(0, 0, 0, 0)
         , _immutable(GL_FALSE)
+        , _label()
         , _impl(std::move(impl))
     {
     }
@@ -44,6 +46,16 @@ namespace fixie
         return _auto_generate_mipmap;
     }
 
+    fixie::rectangle& texture::crop_rect()
+    {
+        return _crop_rect;
+    }
+
+    const fixie::rectangle& texture::crop_rect() const
+    {
+        return _crop_rect;
+    }
+
     size_t texture::mip_levels() const
     {
         return _mips.size();
@@ -145,14 +157,20 @@ namespace fixie
 
         _impl->set_compressed_data(store_state, level, internal_format, width, height, image_size, data);
 
-        if (_mips.size() <= static_cast<size_t>(level))
+        // Paletted images use negative levels to provide levels 0 through -level in one upload
+        GLint first_level = std::max(level, 0);
+        GLint last_level = std::max(level, -level);
+        if (_mips.size() <= static_cast<size_t>(last_level))
         {
-            _mips.resize(level + 1);
+            _mips.resize(last_level + 1);
+        }
+        for (GLint mip = first_level; mip <= last_level; mip++)
+        {
+            _mips[mip].internal_format = internal_format;
+            _mips[mip].width = std::max(width >> (mip - first_level), 1);
+            _mips[mip].height = std::max(height >> (mip - first_level), 1);
+            _mips[mip].compressed = GL_TRUE;
         }
-        _mips[level].internal_format = internal_format;
-        _mips[level].width = width;
-        _mips[level].height = width;
-        _mips[level].compressed = GL_TRUE;
     }
 
     void texture::set_compressed_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
@@ -191,7 +209,7 @@ namespace fixie
         }
         _mips[level].internal_format = internal_format;
         _mips[level].width = width;
-        _mips[level].height = width;
+        _mips[level].height = height;
         _mips[level].compressed = GL_FALSE;
 
         if (level == 0 && auto_generate_mipmap())
@@ -201,12 +219,12 @@ namespace fixie
     }
 
     void texture::copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width,
-                                GLsizei height, GLenum format, GLenum type, std::weak_ptr<const framebuffer> source)
+                                GLsizei height, std::weak_ptr<const framebuffer> source)
     {
         std::shared_ptr<const framebuffer> source_locked = source.lock();
         std::weak_ptr<const framebuffer_impl> source_impl = source_locked ? source_locked->impl()
                                                                           : std::weak_ptr<const framebuffer_impl>();
-        _impl->copy_sub_data(level, xoffset, yoffset, x, y, width, height, format, type, source_impl);
+        _impl->copy_sub_data(level, mip_level_internal_format(level), xoffset, yoffset, x, y, width, height, source_impl);
         if (level == 0 && auto_generate_mipmap())
         {
             generate_mipmaps();
@@ -226,6 +244,16 @@ namespace fixie
         }
     }
 
+    std::string& texture::label()
+    {
+        return _label;
+    }
+
+    const std::string& texture::label() const
+    {
+        return _label;
+    }
+
     std::weak_ptr<texture_impl> texture::impl()
     {
         return _impl;
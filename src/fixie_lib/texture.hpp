@@ -3,10 +3,12 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 #include "fixie/fixie_gl_types.h"
 #include "fixie_lib/sampler_state.hpp"
 #include "fixie_lib/pixel_store_state.hpp"
+#include "fixie_lib/rectangle.hpp"
 #include "fixie_lib/noncopyable.hpp"
 
 namespace fixie
@@ -23,7 +25,7 @@ namespace fixie
         virtual void set_compressed_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei image_size, const GLvoid *data) = 0;
         virtual void set_storage(GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height) = 0;
         virtual void copy_data(GLint level, GLenum internal_format, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source) = 0;
-        virtual void copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, std::weak_ptr<const framebuffer_impl> source) = 0;
+        virtual void copy_sub_data(GLint level, GLenum internal_format, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer_impl> source) = 0;
         virtual void generate_mipmaps() = 0;
     };
 
@@ -38,6 +40,9 @@ namespace fixie
         GLboolean& auto_generate_mipmap();
         const GLboolean& auto_generate_mipmap() const;
 
+        fixie::rectangle& crop_rect();
+        const fixie::rectangle& crop_rect() const;
+
         size_t mip_levels() const;
         GLsizei mip_level_width(size_t mip) const;
         GLsizei mip_level_height(size_t mip) const;
@@ -52,16 +57,20 @@ namespace fixie
         void set_compressed_sub_data(const pixel_store_state& store_state, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei image_size, const GLvoid *data);
         void set_storage(GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height);
         void copy_data(GLint level, GLenum internal_format, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer> source);
-        void copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, std::weak_ptr<const framebuffer> source);
+        void copy_sub_data(GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height, std::weak_ptr<const framebuffer> source);
 
         void generate_mipmaps();
 
+        std::string& label();
+        const std::string& label() const;
+
         std::weak_ptr<texture_impl> impl();
         std::weak_ptr<const texture_impl> impl() const;
 
     private:
         fixie::sampler_state _sampler_state;
         GLboolean _auto_generate_mipmap;
+        fixie::rectangle _crop_rect;
 
         GLboolean _immutable;
 
@@ -79,6 +88,8 @@ namespace fixie
 
         size_t required_mip_levels(GLsizei width, GLsizei height) const;
 
+        std::string _label;
+
         std::shared_ptr<texture_impl> _impl;
     };
 }
@@ -25,6 +25,7 @@ namespace fixie
         , _operand2_alpha(0)
         , _rgb_scale(0.0f)
         , _alpha_scale(0.0f)
+        , _coord_replace(GL_FALSE)
     {
     }
 
@@ -38,6 +39,16 @@ namespace fixie
         return _alpha_scale;
     }
 
+    GLboolean& texture_environment::coord_replace()
+    {
+        return _coord_replace;
+    }
+
+    const GLboolean& texture_environment::coord_replace() const
+    {
+        return _coord_replace;
+    }
+
     GLfloat& texture_environment::rgb_scale()
     {
         return _rgb_scale;
@@ -242,6 +253,7 @@ namespace fixie
         env.operand2_alpha() = GL_SRC_ALPHA;
         env.rgb_scale() = 1.0f;
         env.alpha_scale() = 1.0f;
+        env.coord_replace() = GL_FALSE;
 
         return env;
     }
@@ -266,7 +278,8 @@ namespace fixie
                a.operand1_alpha() == b.operand1_alpha() &&
                a.operand2_alpha() == b.operand2_alpha() &&
                a.rgb_scale() == b.rgb_scale() &&
-               a.alpha_scale() == b.alpha_scale();
+               a.alpha_scale() == b.alpha_scale() &&
+               a.coord_replace() == b.coord_replace();
     }
 
     bool operator!=(const texture_environment& a, const texture_environment& b)
@@ -299,6 +312,7 @@ namespace std
         fixie::hash_combine(seed, key.operand2_alpha());
         fixie::hash_combine(seed, key.rgb_scale());
         fixie::hash_combine(seed, key.alpha_scale());
+        fixie::hash_combine(seed, key.coord_replace());
         return seed;
     }
 }
@@ -71,6 +71,9 @@ namespace fixie
         const GLfloat& alpha_scale() const;
         GLfloat& alpha_scale();
 
+        const GLboolean& coord_replace() const;
+        GLboolean& coord_replace();
+
     private:
         GLboolean _texture_enabled;
         GLenum _mode;
@@ -97,6 +100,8 @@ namespace fixie
 
         GLfloat _rgb_scale;
         GLfloat _alpha_scale;
+
+        GLboolean _coord_replace;
     };
 
     bool operator==(const texture_environment& a, const texture_environment& b);
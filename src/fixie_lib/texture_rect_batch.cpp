@@ -0,0 +1,83 @@
+#include "fixie_lib/texture_rect_batch.hpp"
+
+#include <assert.h>
+
+namespace fixie
+{
+    static const size_t rect_float_count = 4;
+    static const size_t depth_float_count = 1;
+    static const size_t texcoord_float_count = 4;
+
+    texture_rect_batch::texture_rect_batch(size_t texture_unit_count)
+        : _texture_unit_count(texture_unit_count)
+        , _floats_per_rect(rect_float_count + depth_float_count + texture_unit_count * texcoord_float_count)
+        , _data()
+    {
+    }
+
+    size_t texture_rect_batch::texture_unit_count() const
+    {
+        return _texture_unit_count;
+    }
+
+    size_t texture_rect_batch::size() const
+    {
+        return _data.size() / _floats_per_rect;
+    }
+
+    bool texture_rect_batch::empty() const
+    {
+        return _data.empty();
+    }
+
+    void texture_rect_batch::add_rect(GLfloat x, GLfloat y, GLfloat depth, GLfloat width, GLfloat height)
+    {
+        size_t offset = _data.size();
+        _data.resize(offset + _floats_per_rect, 0.0f);
+        _data[offset + 0] = x;
+        _data[offset + 1] = y;
+        _data[offset + 2] = width;
+        _data[offset + 3] = height;
+        _data[offset + rect_float_count] = depth;
+    }
+
+    void texture_rect_batch::set_texcoord_rect(size_t unit, GLfloat s0, GLfloat t0, GLfloat s1, GLfloat t1)
+    {
+        assert(!empty() && unit < _texture_unit_count);
+        size_t offset = _data.size() - _floats_per_rect + rect_float_count + depth_float_count + unit * texcoord_float_count;
+        _data[offset + 0] = s0;
+        _data[offset + 1] = t0;
+        _data[offset + 2] = s1;
+        _data[offset + 3] = t1;
+    }
+
+    void texture_rect_batch::clear()
+    {
+        _data.clear();
+    }
+
+    const GLfloat* texture_rect_batch::data() const
+    {
+        return _data.data();
+    }
+
+    GLsizei texture_rect_batch::stride() const
+    {
+        return static_cast<GLsizei>(_floats_per_rect * sizeof(GLfloat));
+    }
+
+    size_t texture_rect_batch::rect_offset() const
+    {
+        return 0;
+    }
+
+    size_t texture_rect_batch::depth_offset() const
+    {
+        return rect_float_count * sizeof(GLfloat);
+    }
+
+    size_t texture_rect_batch::texcoord_offset(size_t unit) const
+    {
+        return (rect_float_count + depth_float_count + unit * texcoord_float_count) * sizeof(GLfloat);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef _FIXIE_LIB_TEXTURE_RECT_BATCH_HPP_
+#define _FIXIE_LIB_TEXTURE_RECT_BATCH_HPP_
+
+#include <vector>
+#include <cstddef>
+
+#include "fixie/fixie_gl_types.h"
+
+namespace fixie
+{
+    // Window space rectangles from OES_draw_texture, interleaved so they can be used directly as per instance
+    // vertex data. Each rectangle is stored as x, y, width, height, depth followed by an s0, t0, s1, t1
+    // texture coordinate rectangle for every texture unit.
+    class texture_rect_batch
+    {
+    public:
+        explicit texture_rect_batch(size_t texture_unit_count);
+
+        size_t texture_unit_count() const;
+        size_t size() const;
+        bool empty() const;
+
+        void add_rect(GLfloat x, GLfloat y, GLfloat depth, GLfloat width, GLfloat height);
+        void set_texcoord_rect(size_t unit, GLfloat s0, GLfloat t0, GLfloat s1, GLfloat t1);
+        void clear();
+
+        const GLfloat* data() const;
+        GLsizei stride() const;
+        size_t rect_offset() const;
+        size_t depth_offset() const;
+        size_t texcoord_offset(size_t unit) const;
+
+    private:
+        size_t _texture_unit_count;
+        size_t _floats_per_rect;
+        std::vector<GLfloat> _data;
+    };
+}
+
+#endif // _FIXIE_LIB_TEXTURE_RECT_BATCH_HPP_
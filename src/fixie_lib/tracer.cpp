@@ -0,0 +1,241 @@
+#include "fixie_lib/tracer.hpp"
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <cstdlib>
+#include <cstdint>
+
+namespace fixie
+{
+    struct trace_event
+    {
+        const char* category;
+        const char* name;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    struct thread_trace_buffer
+    {
+        explicit thread_trace_buffer(size_t thread_id)
+            : thread_id(thread_id)
+            , events(max_trace_events_per_thread)
+            , written(0)
+            , cleared(0)
+        {
+        }
+
+        // The owning thread appends under the lock and only it moves the write cursor, readers and clear_trace take
+        // the same lock and clearing just hides the events written so far
+        mutable std::mutex mutex;
+        size_t thread_id;
+        std::vector<trace_event> events;
+        uint64_t written;
+        uint64_t cleared;
+    };
+
+    struct retired_trace_event
+    {
+        size_t thread_id;
+        trace_event event;
+    };
+
+    static std::mutex trace_registry_mutex;
+    static std::vector< std::shared_ptr<thread_trace_buffer> > all_trace_buffers;
+    static std::deque<retired_trace_event> retired_trace_events;
+    static size_t next_trace_thread_id = 1;
+
+    // Owns the buffer of the calling thread, when the thread exits its events move to the retired list and the
+    // buffer is released
+    struct thread_trace_buffer_owner
+    {
+        ~thread_trace_buffer_owner();
+
+        std::shared_ptr<thread_trace_buffer> buffer;
+    };
+
+    static thread_local thread_trace_buffer* thread_buffer = nullptr;
+    static thread_local thread_trace_buffer_owner thread_buffer_owner;
+
+    template <typename visitor_type>
+    static void visit_trace_events(const thread_trace_buffer& buffer, visitor_type visitor)
+    {
+        uint64_t first_event = (buffer.written > buffer.events.size()) ? buffer.written - buffer.events.size() : 0;
+        for (uint64_t i = std::max(first_event, buffer.cleared); i < buffer.written; i++)
+        {
+            visitor(buffer.events[static_cast<size_t>(i % buffer.events.size())]);
+        }
+    }
+
+    thread_trace_buffer_owner::~thread_trace_buffer_owner()
+    {
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(trace_registry_mutex);
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            size_t thread_id = buffer->thread_id;
+            visit_trace_events(*buffer, [&](const trace_event& event)
+            {
+                // Retired events share one ring of the same size as a thread buffer
+                if (retired_trace_events.size() >= max_trace_events_per_thread)
+                {
+                    retired_trace_events.pop_front();
+                }
+                retired_trace_event retired = { thread_id, event };
+                retired_trace_events.push_back(retired);
+            });
+        }
+
+        all_trace_buffers.erase(std::remove(begin(all_trace_buffers), end(all_trace_buffers), buffer), end(all_trace_buffers));
+        thread_buffer = nullptr;
+    }
+
+    static const std::chrono::steady_clock::time_point& trace_epoch()
+    {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return epoch;
+    }
+
+    static std::atomic<bool>& tracing_enabled_flag()
+    {
+        static std::atomic<bool> enabled((trace_epoch(), !default_trace_path().empty()));
+        return enabled;
+    }
+
+    static thread_trace_buffer* get_thread_trace_buffer()
+    {
+        if (thread_buffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(trace_registry_mutex);
+            std::shared_ptr<thread_trace_buffer> buffer = std::make_shared<thread_trace_buffer>(next_trace_thread_id++);
+            all_trace_buffers.push_back(buffer);
+            thread_buffer_owner.buffer = buffer;
+            thread_buffer = buffer.get();
+        }
+        return thread_buffer;
+    }
+
+    static uint64_t nanoseconds_since_epoch(std::chrono::steady_clock::time_point time)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time - trace_epoch()).count());
+    }
+
+    bool tracing_enabled()
+    {
+        return tracing_enabled_flag().load(std::memory_order_relaxed);
+    }
+
+    void set_tracing_enabled(bool enabled)
+    {
+        tracing_enabled_flag().store(enabled, std::memory_order_relaxed);
+    }
+
+    const std::string& default_trace_path()
+    {
+        static const std::string path = []() -> std::string
+        {
+            const char* env_path = std::getenv("FIXIE_TRACE");
+            return (env_path != nullptr) ? env_path : "";
+        }();
+        return path;
+    }
+
+    static void write_microseconds(std::ostream& stream, uint64_t ns)
+    {
+        stream << (ns / 1000) << "." << static_cast<char>('0' + (ns / 100) % 10) << static_cast<char>('0' + (ns / 10) % 10) << static_cast<char>('0' + ns % 10);
+    }
+
+    void write_trace(std::ostream& stream)
+    {
+        std::lock_guard<std::mutex> lock(trace_registry_mutex);
+
+        stream << "{\"traceEvents\":[";
+        bool first = true;
+        auto write_event = [&](size_t thread_id, const trace_event& event)
+        {
+            stream << (first ? "" : ",") << std::endl;
+            stream << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":";
+            write_microseconds(stream, event.start_ns);
+            stream << ",\"dur\":";
+            write_microseconds(stream, event.duration_ns);
+            stream << ",\"pid\":1,\"tid\":" << thread_id << "}";
+            first = false;
+        };
+
+        for (auto iter = begin(retired_trace_events); iter != end(retired_trace_events); ++iter)
+        {
+            write_event(iter->thread_id, iter->event);
+        }
+
+        for (auto iter = begin(all_trace_buffers); iter != end(all_trace_buffers); ++iter)
+        {
+            const thread_trace_buffer& buffer = **iter;
+            std::lock_guard<std::mutex> buffer_lock(buffer.mutex);
+            visit_trace_events(buffer, [&](const trace_event& event){ write_event(buffer.thread_id, event); });
+        }
+        stream << std::endl << "],\"displayTimeUnit\":\"ns\"}" << std::endl;
+    }
+
+    bool dump_trace(const std::string& path)
+    {
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+
+        write_trace(file);
+        return file.good();
+    }
+
+    void clear_trace()
+    {
+        std::lock_guard<std::mutex> lock(trace_registry_mutex);
+        retired_trace_events.clear();
+        for (auto iter = begin(all_trace_buffers); iter != end(all_trace_buffers); ++iter)
+        {
+            std::lock_guard<std::mutex> buffer_lock((*iter)->mutex);
+            (*iter)->cleared = (*iter)->written;
+        }
+    }
+
+    trace_scope::trace_scope(const char* category, const char* name)
+        : _category(category)
+        , _name(name)
+        , _start()
+        , _enabled(tracing_enabled())
+    {
+        if (_enabled)
+        {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    trace_scope::~trace_scope()
+    {
+        if (_enabled)
+        {
+            std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+            thread_trace_buffer* buffer = get_thread_trace_buffer();
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+
+            trace_event& event = buffer->events[static_cast<size_t>(buffer->written % buffer->events.size())];
+            event.category = _category;
+            event.name = _name;
+            event.start_ns = nanoseconds_since_epoch(_start);
+            event.duration_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - _start).count());
+
+            buffer->written++;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef _FIXIE_LIB_TRACER_HPP_
+#define _FIXIE_LIB_TRACER_HPP_
+
+#include <chrono>
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+namespace fixie
+{
+    static const size_t max_trace_events_per_thread = 1 << 16;
+
+    bool tracing_enabled();
+    void set_tracing_enabled(bool enabled);
+
+    const std::string& default_trace_path();
+
+    void write_trace(std::ostream& stream);
+    bool dump_trace(const std::string& path);
+    void clear_trace();
+
+    class trace_scope
+    {
+    public:
+        trace_scope(const char* category, const char* name);
+        ~trace_scope();
+
+    private:
+        const char* _category;
+        const char* _name;
+        std::chrono::steady_clock::time_point _start;
+        bool _enabled;
+    };
+}
+
+#define FIXIE_TRACE_CONCAT_IMPL(a, b) a##b
+#define FIXIE_TRACE_CONCAT(a, b) FIXIE_TRACE_CONCAT_IMPL(a, b)
+#define FIXIE_TRACE_SCOPE(category, name) fixie::trace_scope FIXIE_TRACE_CONCAT(fixie_trace_scope_, __LINE__)(category, name)
+
+#endif // _FIXIE_LIB_TRACER_HPP_
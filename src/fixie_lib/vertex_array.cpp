@@ -7,6 +7,11 @@ namespace fixie
         : _vertex_attribute()
         , _normal_attribute()
         , _color_attribute()
+        , _point_size_attribute()
+        , _matrix_index_attribute()
+        , _weight_attribute()
+        , _instance_model_view_attribute()
+        , _instance_color_attribute()
         , _texcoord_attributes(texcoord_count)
     {
     }
@@ -41,6 +46,56 @@ namespace fixie
         return _color_attribute;
     }
 
+    fixie::vertex_attribute& vertex_array::point_size_attribute()
+    {
+        return _point_size_attribute;
+    }
+
+    const fixie::vertex_attribute& vertex_array::point_size_attribute() const
+    {
+        return _point_size_attribute;
+    }
+
+    fixie::vertex_attribute& vertex_array::matrix_index_attribute()
+    {
+        return _matrix_index_attribute;
+    }
+
+    const fixie::vertex_attribute& vertex_array::matrix_index_attribute() const
+    {
+        return _matrix_index_attribute;
+    }
+
+    fixie::vertex_attribute& vertex_array::weight_attribute()
+    {
+        return _weight_attribute;
+    }
+
+    const fixie::vertex_attribute& vertex_array::weight_attribute() const
+    {
+        return _weight_attribute;
+    }
+
+    fixie::vertex_attribute& vertex_array::instance_model_view_attribute()
+    {
+        return _instance_model_view_attribute;
+    }
+
+    const fixie::vertex_attribute& vertex_array::instance_model_view_attribute() const
+    {
+        return _instance_model_view_attribute;
+    }
+
+    fixie::vertex_attribute& vertex_array::instance_color_attribute()
+    {
+        return _instance_color_attribute;
+    }
+
+    const fixie::vertex_attribute& vertex_array::instance_color_attribute() const
+    {
+        return _instance_color_attribute;
+    }
+
     size_t vertex_array::texcoord_attribute_count() const
     {
         return _texcoord_attributes.size();
@@ -62,6 +117,11 @@ namespace fixie
         vao.vertex_attribute() = default_vertex_attribute();
         vao.normal_attribute() = default_normal_attribute();
         vao.color_attribute() = default_color_attribute();
+        vao.point_size_attribute() = default_point_size_attribute();
+        vao.matrix_index_attribute() = default_matrix_index_attribute();
+        vao.weight_attribute() = default_weight_attribute();
+        vao.instance_model_view_attribute() = default_instance_model_view_attribute();
+        vao.instance_color_attribute() = default_instance_color_attribute();
         for_each_n<size_t>(0U, vao.texcoord_attribute_count(), [&](size_t i){ vao.texcoord_attribute(i) = default_texcoord_attribute(); });
         return vao;
     }
@@ -71,6 +131,11 @@ namespace fixie
         return a.vertex_attribute() == b.vertex_attribute() &&
                a.normal_attribute() == b.normal_attribute() &&
                a.color_attribute() == b.color_attribute() &&
+               a.point_size_attribute() == b.point_size_attribute() &&
+               a.matrix_index_attribute() == b.matrix_index_attribute() &&
+               a.weight_attribute() == b.weight_attribute() &&
+               a.instance_model_view_attribute() == b.instance_model_view_attribute() &&
+               a.instance_color_attribute() == b.instance_color_attribute() &&
                a.texcoord_attribute_count() == b.texcoord_attribute_count() &&
                equal_n<size_t>(0U, a.texcoord_attribute_count(), [&](size_t i){ return a.texcoord_attribute(i) == b.texcoord_attribute(i); });
     }
@@ -90,6 +155,11 @@ namespace std
         fixie::hash_combine(seed, key.vertex_attribute());
         fixie::hash_combine(seed, key.normal_attribute());
         fixie::hash_combine(seed, key.color_attribute());
+        fixie::hash_combine(seed, key.point_size_attribute());
+        fixie::hash_combine(seed, key.matrix_index_attribute());
+        fixie::hash_combine(seed, key.weight_attribute());
+        fixie::hash_combine(seed, key.instance_model_view_attribute());
+        fixie::hash_combine(seed, key.instance_color_attribute());
         fixie::for_each_n<size_t>(0U, key.texcoord_attribute_count(), [&](size_t i){ fixie::hash_combine(seed, key.texcoord_attribute(i)); });
 
         return seed;
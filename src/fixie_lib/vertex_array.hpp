@@ -23,6 +23,21 @@ namespace fixie
         fixie::vertex_attribute& color_attribute();
         const fixie::vertex_attribute& color_attribute() const;
 
+        fixie::vertex_attribute& point_size_attribute();
+        const fixie::vertex_attribute& point_size_attribute() const;
+
+        fixie::vertex_attribute& matrix_index_attribute();
+        const fixie::vertex_attribute& matrix_index_attribute() const;
+
+        fixie::vertex_attribute& weight_attribute();
+        const fixie::vertex_attribute& weight_attribute() const;
+
+        fixie::vertex_attribute& instance_model_view_attribute();
+        const fixie::vertex_attribute& instance_model_view_attribute() const;
+
+        fixie::vertex_attribute& instance_color_attribute();
+        const fixie::vertex_attribute& instance_color_attribute() const;
+
         size_t texcoord_attribute_count() const;
         fixie::vertex_attribute& texcoord_attribute(size_t unit);
         const fixie::vertex_attribute& texcoord_attribute(size_t unit) const;
@@ -31,6 +46,11 @@ namespace fixie
         fixie::vertex_attribute _vertex_attribute;
         fixie::vertex_attribute _normal_attribute;
         fixie::vertex_attribute _color_attribute;
+        fixie::vertex_attribute _point_size_attribute;
+        fixie::vertex_attribute _matrix_index_attribute;
+        fixie::vertex_attribute _weight_attribute;
+        fixie::vertex_attribute _instance_model_view_attribute;
+        fixie::vertex_attribute _instance_color_attribute;
         std::vector<fixie::vertex_attribute> _texcoord_attributes;
     };
 
@@ -11,6 +11,7 @@ namespace fixie
         , _type(GL_FLOAT)
         , _stride(0)
         , _pointer(nullptr)
+        , _divisor(0)
         , _generic_values(0.0f, 0.0f, 0.0f, 1.0f)
         , _buffer()
     {
@@ -66,6 +67,16 @@ namespace fixie
         return _pointer;
     }
 
+    GLuint& vertex_attribute::divisor()
+    {
+        return _divisor;
+    }
+
+    const GLuint& vertex_attribute::divisor() const
+    {
+        return _divisor;
+    }
+
     vector4& vertex_attribute::generic_values()
     {
         return _generic_values;
@@ -94,6 +105,7 @@ namespace fixie
         attribute.type() = GL_FALSE;
         attribute.stride() = 0;
         attribute.pointer() = nullptr;
+        attribute.divisor() = 0;
         attribute.generic_values() = vector4(0.0f, 0.0f, 0.0f, 1.0f);
         attribute.buffer().reset();
         return attribute;
@@ -127,6 +139,51 @@ namespace fixie
         return attribute;
     }
 
+    vertex_attribute default_point_size_attribute()
+    {
+        vertex_attribute attribute = get_default_common_attribute();
+        attribute.size() = 1;
+        attribute.generic_values() = vector4(1.0f, 0.0f, 0.0f, 1.0f);
+        return attribute;
+    }
+
+    vertex_attribute default_matrix_index_attribute()
+    {
+        vertex_attribute attribute = get_default_common_attribute();
+        attribute.size() = 0;
+        attribute.type() = GL_UNSIGNED_BYTE;
+        attribute.generic_values() = vector4(0.0f, 0.0f, 0.0f, 0.0f);
+        return attribute;
+    }
+
+    vertex_attribute default_weight_attribute()
+    {
+        vertex_attribute attribute = get_default_common_attribute();
+        attribute.size() = 0;
+        attribute.type() = GL_FIXED;
+        attribute.generic_values() = vector4(1.0f, 0.0f, 0.0f, 0.0f);
+        return attribute;
+    }
+
+    vertex_attribute default_instance_model_view_attribute()
+    {
+        vertex_attribute attribute = get_default_common_attribute();
+        attribute.size() = 16;
+        attribute.type() = GL_FLOAT;
+        attribute.divisor() = 1;
+        return attribute;
+    }
+
+    vertex_attribute default_instance_color_attribute()
+    {
+        vertex_attribute attribute = get_default_common_attribute();
+        attribute.size() = 4;
+        attribute.type() = GL_FLOAT;
+        attribute.divisor() = 1;
+        attribute.generic_values() = vector4(1.0f, 1.0f, 1.0f, 1.0f);
+        return attribute;
+    }
+
     bool operator==(const vertex_attribute& a, const vertex_attribute& b)
     {
         return a.attribute_enabled() == b.attribute_enabled() &&
@@ -134,6 +191,7 @@ namespace fixie
                a.type() == b.type() &&
                a.stride() == b.stride() &&
                a.pointer() == b.pointer() &&
+               a.divisor() == b.divisor() &&
                a.generic_values() == b.generic_values() &&
                a.buffer().lock() == b.buffer().lock();
     }
@@ -157,6 +215,7 @@ namespace std
             fixie::hash_combine(seed, key.type());
             fixie::hash_combine(seed, key.stride());
             fixie::hash_combine(seed, key.pointer());
+            fixie::hash_combine(seed, key.divisor());
             fixie::hash_combine(seed, key.generic_values());
             fixie::hash_combine(seed, key.buffer().lock());
         }
@@ -28,6 +28,9 @@ namespace fixie
         const GLvoid*& pointer();
         const GLvoid* const& pointer() const;
 
+        GLuint& divisor();
+        const GLuint& divisor() const;
+
         vector4& generic_values();
         const vector4& generic_values() const;
 
@@ -40,6 +43,7 @@ namespace fixie
         GLenum _type;
         GLsizei _stride;
         const GLvoid* _pointer;
+        GLuint _divisor;
 
         vector4 _generic_values;
         std::weak_ptr<fixie::buffer> _buffer;
@@ -52,6 +56,11 @@ namespace fixie
     vertex_attribute default_normal_attribute();
     vertex_attribute default_color_attribute();
     vertex_attribute default_texcoord_attribute();
+    vertex_attribute default_point_size_attribute();
+    vertex_attribute default_matrix_index_attribute();
+    vertex_attribute default_weight_attribute();
+    vertex_attribute default_instance_model_view_attribute();
+    vertex_attribute default_instance_color_attribute();
 }
 
 namespace std
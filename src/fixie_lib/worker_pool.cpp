@@ -0,0 +1,126 @@
+#include "fixie_lib/worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace fixie
+{
+    worker_pool::worker_pool(size_t thread_count)
+        : _threads()
+        , _mutex()
+        , _task_available()
+        , _task_finished()
+        , _tasks()
+        , _stopping(false)
+    {
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            _threads.push_back(std::thread([this](){ worker_main(); }));
+        }
+    }
+
+    worker_pool::~worker_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _task_available.notify_all();
+        std::for_each(begin(_threads), end(_threads), [](std::thread& thread){ thread.join(); });
+    }
+
+    size_t worker_pool::thread_count() const
+    {
+        return _threads.size();
+    }
+
+    void worker_pool::parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& func)
+    {
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunk_count = (count + grain - 1) / grain;
+        if (chunk_count <= 1 || _threads.empty())
+        {
+            if (count > 0)
+            {
+                func(0, count);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next_chunk(0);
+        auto run_chunks = [&]()
+        {
+            for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++)
+            {
+                func(chunk * grain, std::min(count, (chunk + 1) * grain));
+            }
+        };
+
+        // Helpers reference this stack frame, wait for every one of them to leave before returning
+        size_t running_helpers = std::min(_threads.size(), chunk_count - 1);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (size_t i = 0; i < running_helpers; i++)
+            {
+                _tasks.push_back([&]()
+                {
+                    run_chunks();
+
+                    std::lock_guard<std::mutex> finished_lock(_mutex);
+                    running_helpers--;
+                    _task_finished.notify_all();
+                });
+            }
+        }
+        _task_available.notify_all();
+
+        run_chunks();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _task_finished.wait(lock, [&](){ return running_helpers == 0; });
+    }
+
+    void worker_pool::worker_main()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _task_available.wait(lock, [this](){ return _stopping || !_tasks.empty(); });
+                if (_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    static std::mutex shared_pool_mutex;
+    static worker_pool* shared_pool = nullptr;
+
+    worker_pool& get_worker_pool()
+    {
+        std::lock_guard<std::mutex> lock(shared_pool_mutex);
+        if (shared_pool == nullptr)
+        {
+            // The calling thread always works too, leave one hardware thread for it
+            shared_pool = new worker_pool(std::max(std::thread::hardware_concurrency(), 1U) - 1);
+        }
+        return *shared_pool;
+    }
+
+    void shutdown_worker_pool()
+    {
+        worker_pool* pool = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(shared_pool_mutex);
+            std::swap(pool, shared_pool);
+        }
+        delete pool;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef _FIXIE_LIB_WORKER_POOL_HPP_
+#define _FIXIE_LIB_WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+#include "fixie_lib/noncopyable.hpp"
+
+namespace fixie
+{
+    class worker_pool : public noncopyable
+    {
+    public:
+        explicit worker_pool(size_t thread_count);
+        ~worker_pool();
+
+        size_t thread_count() const;
+
+        // Splits [0, count) into chunks of at most grain items and runs func(first, last) on each, the calling
+        // thread takes chunks as well and does not return until every chunk has finished
+        void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& func);
+
+    private:
+        void worker_main();
+
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _task_available;
+        std::condition_variable _task_finished;
+        std::deque< std::function<void()> > _tasks;
+        bool _stopping;
+    };
+
+    // The shared pool is created on first use and only joined by shutdown_worker_pool, never from a static
+    // destructor where joining can deadlock under the Windows loader lock
+    worker_pool& get_worker_pool();
+    void shutdown_worker_pool();
+}
+
+#endif // _FIXIE_LIB_WORKER_POOL_HPP_
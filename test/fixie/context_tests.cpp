@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "fixie/fixie.h"
+#include "fixie/fixie_gl_es.h"
 
 namespace fixie
 {
@@ -9,4 +10,19 @@ namespace fixie
         fixie_context ctx = fixie_create_context();
         fixie_destroy_context(ctx);
     }
+
+    TEST(context_tests, alpha_test_capability)
+    {
+        fixie_context ctx = fixie_create_context();
+        fixie_set_context(ctx);
+
+        EXPECT_EQ(glIsEnabled(GL_ALPHA_TEST), GL_FALSE);
+        glEnable(GL_ALPHA_TEST);
+        EXPECT_EQ(glIsEnabled(GL_ALPHA_TEST), GL_TRUE);
+        glDisable(GL_ALPHA_TEST);
+        EXPECT_EQ(glIsEnabled(GL_ALPHA_TEST), GL_FALSE);
+        EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+
+        fixie_destroy_context(ctx);
+    }
 }
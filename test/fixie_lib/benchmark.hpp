@@ -0,0 +1,32 @@
+#ifndef _FIXIE_TEST_BENCHMARK_HPP_
+#define _FIXIE_TEST_BENCHMARK_HPP_
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <cstddef>
+
+namespace fixie
+{
+    template <typename benchmark_func>
+    double run_benchmark(const std::string& name, size_t iterations, benchmark_func func)
+    {
+        func();
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            func();
+        }
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+        double ns_per_iteration = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+        std::cout << "[ BENCHMARK] " << name << ": " << ns_per_iteration << " ns/iteration (" << iterations << " iterations)" << std::endl;
+        ::testing::Test::RecordProperty(name, static_cast<int>(ns_per_iteration + 0.5));
+        return ns_per_iteration;
+    }
+}
+
+#endif // _FIXIE_TEST_BENCHMARK_HPP_
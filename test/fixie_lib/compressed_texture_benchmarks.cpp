@@ -0,0 +1,64 @@
+#include "benchmark.hpp"
+
+#include "fixie_lib/compressed_texture.hpp"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+
+#include <vector>
+
+namespace fixie
+{
+    static const GLsizei compressed_benchmark_size = 1024;
+    static const size_t compressed_benchmark_iterations = 32;
+
+    static std::vector<GLubyte> compressed_benchmark_data(GLenum format)
+    {
+        std::vector<GLubyte> data(compressed_image_size(format, compressed_benchmark_size, compressed_benchmark_size, 1));
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<GLubyte>(i * 2654435761U >> 13);
+        }
+        return data;
+    }
+
+    static void benchmark_etc1(const std::string& name, worker_pool& pool)
+    {
+        std::vector<GLubyte> data = compressed_benchmark_data(GL_ETC1_RGB8_OES);
+        std::vector<GLubyte> pixels(compressed_benchmark_size * compressed_benchmark_size * 3);
+        run_benchmark(name, compressed_benchmark_iterations, [&]()
+        {
+            decode_etc1(data.data(), compressed_benchmark_size, compressed_benchmark_size, pixels.data(), pool);
+        });
+    }
+
+    static void benchmark_paletted(const std::string& name, GLenum format, worker_pool& pool)
+    {
+        std::vector<GLubyte> data = compressed_benchmark_data(format);
+        std::vector<GLubyte> pixels(compressed_benchmark_size * compressed_benchmark_size * paletted_format_pixel_size(format));
+        run_benchmark(name, compressed_benchmark_iterations, [&]()
+        {
+            decode_paletted_level(format, data.data(), compressed_benchmark_size, compressed_benchmark_size, 0, pixels.data(), pool);
+        });
+    }
+
+    TEST(compressed_texture_benchmarks, decode_etc1)
+    {
+        worker_pool serial_pool(0);
+        benchmark_etc1("decode_etc1_serial", serial_pool);
+        benchmark_etc1("decode_etc1_pooled", get_worker_pool());
+    }
+
+    TEST(compressed_texture_benchmarks, decode_palette4_rgba8)
+    {
+        worker_pool serial_pool(0);
+        benchmark_paletted("decode_palette4_rgba8_serial", GL_PALETTE4_RGBA8_OES, serial_pool);
+        benchmark_paletted("decode_palette4_rgba8_pooled", GL_PALETTE4_RGBA8_OES, get_worker_pool());
+    }
+
+    TEST(compressed_texture_benchmarks, decode_palette8_rgb8)
+    {
+        worker_pool serial_pool(0);
+        benchmark_paletted("decode_palette8_rgb8_serial", GL_PALETTE8_RGB8_OES, serial_pool);
+        benchmark_paletted("decode_palette8_rgb8_pooled", GL_PALETTE8_RGB8_OES, get_worker_pool());
+    }
+}
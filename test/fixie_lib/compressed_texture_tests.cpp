@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/compressed_texture.hpp"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_gl_es_ext.h"
+
+#include <vector>
+
+namespace fixie
+{
+    TEST(compressed_texture_tests, image_sizes)
+    {
+        EXPECT_EQ(compressed_image_size(GL_ETC1_RGB8_OES, 4, 4, 1), 8);
+        EXPECT_EQ(compressed_image_size(GL_ETC1_RGB8_OES, 5, 3, 1), 16);
+        EXPECT_EQ(compressed_image_size(GL_PALETTE4_RGBA8_OES, 2, 2, 2), 16 * 4 + 2 + 1);
+        EXPECT_EQ(compressed_image_size(GL_PALETTE8_R5_G6_B5_OES, 4, 4, 1), 256 * 2 + 16);
+    }
+
+    TEST(compressed_texture_tests, decode_etc1)
+    {
+        // Individual mode, base colors 0x88 and 0x44, tables 0 and 7 with vertical subblocks
+        const GLubyte blocks[] =
+        {
+            0x84, 0x84, 0x84, 0x1C, 0x00, 0x00, 0x00, 0x00,
+            0x84, 0x84, 0x84, 0x1C, 0xFF, 0xFF, 0xFF, 0xFF,
+        };
+
+        worker_pool pool(2);
+        std::vector<GLubyte> pixels(8 * 4 * 3);
+        decode_etc1(blocks, 8, 4, pixels.data(), pool);
+
+        EXPECT_EQ(pixels[(1 * 8 + 1) * 3], 0x88 + 2);
+        EXPECT_EQ(pixels[(2 * 8 + 3) * 3 + 1], 0x44 + 47);
+        EXPECT_EQ(pixels[(0 * 8 + 4) * 3 + 2], 0x88 - 8);
+        EXPECT_EQ(pixels[(3 * 8 + 7) * 3], 0);
+    }
+
+    TEST(compressed_texture_tests, decode_paletted_levels)
+    {
+        std::vector<GLubyte> data(compressed_image_size(GL_PALETTE4_RGBA8_OES, 2, 2, 2), 0);
+        for (GLubyte i = 0; i < 16; i++)
+        {
+            data[i * 4 + 0] = i;
+            data[i * 4 + 3] = 255 - i;
+        }
+        data[64] = 0x12;
+        data[65] = 0x34;
+        data[66] = 0xF0;
+
+        worker_pool pool(0);
+        std::vector<GLubyte> pixels(2 * 2 * 4);
+        decode_paletted_level(GL_PALETTE4_RGBA8_OES, data.data(), 2, 2, 0, pixels.data(), pool);
+        EXPECT_EQ(pixels[0 * 4], 1);
+        EXPECT_EQ(pixels[1 * 4], 2);
+        EXPECT_EQ(pixels[3 * 4], 4);
+        EXPECT_EQ(pixels[3 * 4 + 3], 255 - 4);
+
+        decode_paletted_level(GL_PALETTE4_RGBA8_OES, data.data(), 2, 2, 1, pixels.data(), pool);
+        EXPECT_EQ(pixels[0], 15);
+    }
+}
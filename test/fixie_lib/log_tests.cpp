@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/log.hpp"
+#include "fixie/fixie_gl_es.h"
+
+namespace fixie
+{
+    TEST(log_tests, default_filter)
+    {
+        log log;
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_MEDIUM_KHR) != GL_FALSE);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_NOTIFICATION_KHR) != GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_LOW_KHR) != GL_FALSE);
+
+        log.output_enabled() = GL_FALSE;
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+    }
+
+    TEST(log_tests, message_control)
+    {
+        log log;
+        log.set_messages_enabled(GL_DONT_CARE, GL_DEBUG_TYPE_PERFORMANCE_KHR, GL_DONT_CARE, GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+
+        log.set_message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 7, GL_TRUE);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 7, GL_DEBUG_SEVERITY_LOW_KHR) != GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 8, GL_DEBUG_SEVERITY_LOW_KHR) != GL_FALSE);
+
+        log.set_messages_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DONT_CARE, GL_DONT_CARE, GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR, 7, GL_DEBUG_SEVERITY_LOW_KHR) != GL_FALSE);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_APPLICATION_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+    }
+
+    TEST(log_tests, severity_control_replaces_id_control)
+    {
+        log log;
+        log.set_message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 3, GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 3, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 3, GL_DEBUG_SEVERITY_MEDIUM_KHR) != GL_FALSE);
+
+        log.set_messages_enabled(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_HIGH_KHR, GL_TRUE);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 3, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 3, GL_DEBUG_SEVERITY_MEDIUM_KHR) != GL_FALSE);
+    }
+
+    TEST(log_tests, bounded_message_log)
+    {
+        log log;
+        for (GLuint i = 0; i < static_cast<GLuint>(log::max_logged_messages) + 10; i++)
+        {
+            log.insert_message(debug_message(GL_DEBUG_SOURCE_APPLICATION_KHR, GL_DEBUG_TYPE_OTHER_KHR, i, GL_DEBUG_SEVERITY_HIGH_KHR, "message"));
+        }
+
+        EXPECT_EQ(log.message_count(), static_cast<size_t>(log::max_logged_messages));
+        EXPECT_EQ(log.next_message().id(), 10u);
+
+        log.pop_message();
+        EXPECT_EQ(log.next_message().id(), 11u);
+    }
+
+    TEST(log_tests, debug_groups_restore_filter)
+    {
+        log log;
+        EXPECT_EQ(log.group_depth(), 1u);
+
+        log.push_group(debug_group(GL_DEBUG_SOURCE_APPLICATION_KHR, 1, "frame"));
+        EXPECT_EQ(log.group_depth(), 2u);
+        EXPECT_EQ(log.top_group().message(), "frame");
+
+        log.set_messages_enabled(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, GL_FALSE);
+        EXPECT_FALSE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+
+        log.pop_group();
+        EXPECT_EQ(log.group_depth(), 1u);
+        EXPECT_TRUE(log.message_enabled(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, 0, GL_DEBUG_SEVERITY_HIGH_KHR) != GL_FALSE);
+    }
+}
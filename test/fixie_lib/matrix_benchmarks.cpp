@@ -0,0 +1,72 @@
+#include "benchmark.hpp"
+
+#include "fixie_lib/matrix.hpp"
+
+namespace fixie
+{
+    static const size_t matrix_benchmark_iterations = 1 << 22;
+
+    static GLfloat benchmark_sink = 0.0f;
+
+    TEST(matrix_benchmarks, multiply)
+    {
+        matrix4 a = matrix4::rotate(30.0f, vector3(0.0f, 1.0f, 0.0f));
+        matrix4 b = matrix4::translate(vector3(1.0f, 2.0f, 3.0f));
+        matrix4 result;
+        run_benchmark("multiply", matrix_benchmark_iterations, [&]()
+        {
+            result = result * a;
+            result *= b;
+        });
+        benchmark_sink += result(0, 0);
+    }
+
+    TEST(matrix_benchmarks, transform_vector)
+    {
+        matrix4 mat = matrix4::frustum(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 100.0f) * matrix4::translate(vector3(0.0f, 0.0f, -5.0f));
+        vector4 vec(1.0f, 2.0f, 3.0f, 1.0f);
+        run_benchmark("transform_vector", matrix_benchmark_iterations, [&]()
+        {
+            vec = mat * vec;
+            vec.w() = 1.0f;
+        });
+        benchmark_sink += vec.x();
+    }
+
+    TEST(matrix_benchmarks, invert)
+    {
+        matrix4 mat(1.0f,  0.5f,  0.75f, -2.0f,
+                    1.2f,  2.5f,  0.75f,  0.1f,
+                    0.1f,  3.5f,  0.65f, -1.0f,
+                    5.0f,  0.5f,  0.15f, -2.0f);
+        run_benchmark("invert", matrix_benchmark_iterations, [&]()
+        {
+            mat = matrix4::invert(mat);
+        });
+        benchmark_sink += mat(0, 0);
+    }
+
+    TEST(matrix_benchmarks, rotate)
+    {
+        GLfloat angle = 0.0f;
+        matrix4 result;
+        run_benchmark("rotate", matrix_benchmark_iterations, [&]()
+        {
+            result = matrix4::rotate(angle, vector3(1.0f, 1.0f, 0.0f));
+            angle += 1.0f;
+        });
+        benchmark_sink += result(0, 0);
+    }
+
+    TEST(matrix_benchmarks, frustum)
+    {
+        GLfloat near_plane = 0.1f;
+        matrix4 result;
+        run_benchmark("frustum", matrix_benchmark_iterations, [&]()
+        {
+            result = matrix4::frustum(-1.0f, 1.0f, -1.0f, 1.0f, near_plane, 100.0f);
+            near_plane += 0.0001f;
+        });
+        benchmark_sink += result(0, 0);
+    }
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/matrix_stack.hpp"
+
+namespace fixie
+{
+    TEST(matrix_stack_tests, push_and_pop)
+    {
+        matrix_stack stack;
+        EXPECT_EQ(stack.size(), 1u);
+        EXPECT_EQ(stack.top_multiplied(), matrix4::identity());
+
+        matrix4 translation = matrix4::translate(vector3(1.0f, 2.0f, 3.0f));
+        stack.top() = translation;
+        stack.push();
+        EXPECT_EQ(stack.size(), 2u);
+        EXPECT_EQ(stack.top_multiplied(), translation);
+
+        matrix4 scale = matrix4::scale(vector3(2.0f, 2.0f, 2.0f));
+        stack.top() *= scale;
+        EXPECT_EQ(stack.top_multiplied(), translation * scale);
+
+        stack.top() = matrix4::identity();
+        EXPECT_EQ(stack.top_multiplied(), matrix4::identity());
+
+        stack.pop();
+        EXPECT_EQ(stack.size(), 1u);
+        EXPECT_EQ(stack.top_multiplied(), translation);
+
+        stack.pop();
+        EXPECT_EQ(stack.size(), 1u);
+    }
+
+    TEST(matrix_stack_tests, version_changes_on_mutation)
+    {
+        matrix_stack stack;
+        matrix_stack other;
+        EXPECT_NE(stack.version(), other.version());
+
+        uint64_t version = stack.version();
+        stack.top_multiplied();
+        static_cast<const matrix_stack&>(stack).top();
+        EXPECT_EQ(stack.version(), version);
+
+        stack.top() = matrix4::scale(vector3(2.0f, 2.0f, 2.0f));
+        EXPECT_NE(stack.version(), version);
+
+        version = stack.version();
+        stack.push();
+        EXPECT_NE(stack.version(), version);
+
+        version = stack.version();
+        stack.pop();
+        EXPECT_NE(stack.version(), version);
+
+        version = stack.version();
+        stack.pop();
+        EXPECT_EQ(stack.version(), version);
+
+        stack.clear();
+        EXPECT_NE(stack.version(), version);
+        EXPECT_EQ(stack.top_multiplied(), matrix4::identity());
+    }
+
+    TEST(matrix_stack_tests, inverse_transpose)
+    {
+        matrix_stack stack;
+        EXPECT_EQ(stack.top_inverse_transpose(), matrix4::identity());
+
+        matrix4 scale = matrix4::scale(vector3(2.0f, 4.0f, 0.5f));
+        stack.top() = scale;
+        EXPECT_EQ(stack.top_inverse_transpose(), matrix4::scale(vector3(0.5f, 0.25f, 2.0f)));
+
+        stack.push();
+        stack.top() *= matrix4::translate(vector3(1.0f, 2.0f, 3.0f));
+        EXPECT_EQ(stack.top_inverse_transpose(), matrix4::transpose(matrix4::invert(stack.top_multiplied())));
+
+        stack.pop();
+        EXPECT_EQ(stack.top_inverse_transpose(), matrix4::scale(vector3(0.5f, 0.25f, 2.0f)));
+    }
+
+    TEST(matrix_stack_tests, identity_tracking)
+    {
+        matrix_stack stack;
+        EXPECT_TRUE(stack.top_is_identity());
+
+        stack.top() = matrix4::translate(vector3(1.0f, 0.0f, 0.0f));
+        EXPECT_FALSE(stack.top_is_identity());
+
+        stack.push();
+        stack.top() = matrix4::identity();
+        EXPECT_TRUE(stack.top_is_identity());
+
+        stack.pop();
+        EXPECT_FALSE(stack.top_is_identity());
+
+        stack.clear();
+        EXPECT_TRUE(stack.top_is_identity());
+    }
+}
@@ -77,7 +77,19 @@ namespace fixie
         matrix4 double_inverted(matrix4::invert(matrix4::invert(mat)));
         EXPECT_LT(max_matrix_diff(mat, double_inverted), epsilon);
 
+        EXPECT_LT(max_matrix_diff(mat * matrix4::invert(mat), matrix4::identity()), epsilon);
+        EXPECT_LT(max_matrix_diff(matrix4::invert(mat) * mat, matrix4::identity()), epsilon);
+
         EXPECT_EQ(matrix4::invert(matrix4::identity()), matrix4::identity());
+
+        matrix4 translation = matrix4::translate(vector3(1.0f, -2.0f, 3.0f));
+        EXPECT_LT(max_matrix_diff(matrix4::invert(translation), matrix4::translate(vector3(-1.0f, 2.0f, -3.0f))), epsilon);
+
+        matrix4 singular(1.0f, 2.0f, 3.0f, 4.0f,
+                         2.0f, 4.0f, 6.0f, 8.0f,
+                         0.0f, 1.0f, 0.0f, 1.0f,
+                         1.0f, 0.0f, 1.0f, 0.0f);
+        EXPECT_EQ(matrix4::invert(singular), matrix4::identity());
     }
 
     TEST(matrix_tests, transpose)
@@ -107,5 +119,33 @@ namespace fixie
 
     TEST(matrix_tests, multiply)
     {
+        matrix4 a(1.0f,  0.5f,  0.75f, -2.0f,
+                  1.2f,  2.5f,  0.75f,  0.1f,
+                  0.1f,  3.5f,  0.65f, -1.0f,
+                  5.0f,  0.5f,  0.15f, -2.0f);
+        matrix4 b(2.0f, -1.0f,  0.0f,  3.0f,
+                  0.5f,  1.0f,  4.0f,  0.0f,
+                  1.0f,  0.0f, -2.0f,  1.5f,
+                  0.0f,  2.0f,  1.0f,  1.0f);
+
+        matrix4 product = a * b;
+        matrix4 scaled = a * 2.0f;
+        for (size_t row = 0; row < 4; ++row)
+        {
+            for (size_t col = 0; col < 4; ++col)
+            {
+                GLfloat expected = a(row, 0) * b(0, col) + a(row, 1) * b(1, col) + a(row, 2) * b(2, col) + a(row, 3) * b(3, col);
+                EXPECT_NEAR(product(row, col), expected, epsilon);
+                EXPECT_EQ(scaled(row, col), a(row, col) * 2.0f);
+            }
+        }
+
+        matrix4 accumulated(a);
+        accumulated *= b;
+        EXPECT_EQ(accumulated, product);
+
+        matrix4 transform = matrix4::translate(vector3(10.0f, 0.0f, 0.0f)) * matrix4::scale(vector3(2.0f, 2.0f, 2.0f));
+        vector4 transformed = transform * vector4(1.0f, 1.0f, 0.0f, 1.0f);
+        EXPECT_EQ(transformed, vector4(12.0f, 2.0f, 0.0f, 1.0f));
     }
 }
@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/pixel_conversion.hpp"
+#include "fixie/fixie_gl_es.h"
+
+#include <vector>
+
+namespace fixie
+{
+    TEST(pixel_conversion_tests, swap_red_blue)
+    {
+        // Seven pixels covers both the vector loop and the scalar tail
+        const GLsizei width = 7;
+        std::vector<GLubyte> source(width * 4);
+        for (size_t i = 0; i < source.size(); i++)
+        {
+            source[i] = static_cast<GLubyte>(i);
+        }
+
+        std::vector<GLubyte> destination(source.size());
+        copy_packed_pixels(source.data(), destination.data(), width * 4, width * 4, 1, GL_TRUE, GL_FALSE);
+
+        for (GLsizei pixel = 0; pixel < width; pixel++)
+        {
+            EXPECT_EQ(destination[pixel * 4 + 0], source[pixel * 4 + 2]);
+            EXPECT_EQ(destination[pixel * 4 + 1], source[pixel * 4 + 1]);
+            EXPECT_EQ(destination[pixel * 4 + 2], source[pixel * 4 + 0]);
+            EXPECT_EQ(destination[pixel * 4 + 3], source[pixel * 4 + 3]);
+        }
+    }
+
+    TEST(pixel_conversion_tests, reverse_rows)
+    {
+        // Three byte rows padded to a four byte pitch, the padding of the last row is not written
+        const GLubyte source[] =
+        {
+            1, 2, 3, 0,
+            4, 5, 6, 0,
+            7, 8, 9,
+        };
+
+        std::vector<GLubyte> destination(sizeof(source), 0xFF);
+        copy_packed_pixels(source, destination.data(), 3, 4, 3, GL_FALSE, GL_TRUE);
+
+        const GLubyte expected[] =
+        {
+            7, 8, 9, 0xFF,
+            4, 5, 6, 0xFF,
+            1, 2, 3,
+        };
+        EXPECT_EQ(std::vector<GLubyte>(expected, expected + sizeof(expected)), destination);
+    }
+}
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/profiler.hpp"
+
+#include <thread>
+
+namespace fixie
+{
+    static entry_point_counters find_counters(const std::string& name)
+    {
+        std::vector<entry_point_counters> counters = get_entry_point_counters();
+        for (auto iter = begin(counters); iter != end(counters); ++iter)
+        {
+            if (iter->name == name)
+            {
+                return *iter;
+            }
+        }
+        return entry_point_counters();
+    }
+
+    TEST(profiler_tests, counts_calls_and_errors)
+    {
+        size_t id = register_entry_point("profiler_tests_entry_point");
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            entry_point_timer timer(id);
+        }
+
+        {
+            entry_point_timer timer(id);
+            record_entry_point_error();
+        }
+
+        std::thread([&](){ entry_point_timer timer(id); }).join();
+
+        entry_point_counters counters = find_counters("profiler_tests_entry_point");
+        EXPECT_EQ(counters.calls, 5u);
+        EXPECT_EQ(counters.errors, 1u);
+        EXPECT_GE(counters.total_ns, counters.max_ns);
+
+        reset_entry_point_counters();
+        counters = find_counters("profiler_tests_entry_point");
+        EXPECT_EQ(counters.calls, 0u);
+        EXPECT_EQ(counters.errors, 0u);
+    }
+}
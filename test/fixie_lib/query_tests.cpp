@@ -0,0 +1,33 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/query.hpp"
+#include "fixie_lib/null_impl/query.hpp"
+#include "fixie/fixie_gl_es.h"
+#include "fixie/fixie_ext.h"
+
+namespace fixie
+{
+    TEST(query_tests, target_and_activity)
+    {
+        query query(std::unique_ptr<query_impl>(new null_impl::query()));
+        EXPECT_EQ(query.target(), 0u);
+        EXPECT_FALSE(query.active() != GL_FALSE);
+
+        query.begin(GL_TIME_ELAPSED_EXT);
+        EXPECT_EQ(query.target(), static_cast<GLenum>(GL_TIME_ELAPSED_EXT));
+        EXPECT_TRUE(query.active() != GL_FALSE);
+
+        query.end();
+        EXPECT_EQ(query.target(), static_cast<GLenum>(GL_TIME_ELAPSED_EXT));
+        EXPECT_FALSE(query.active() != GL_FALSE);
+        EXPECT_TRUE(query.result_available() != GL_FALSE);
+    }
+
+    TEST(query_tests, counter_does_not_activate)
+    {
+        query query(std::unique_ptr<query_impl>(new null_impl::query()));
+        query.query_counter(GL_TIMESTAMP_EXT);
+        EXPECT_EQ(query.target(), static_cast<GLenum>(GL_TIMESTAMP_EXT));
+        EXPECT_FALSE(query.active() != GL_FALSE);
+    }
+}
@@ -0,0 +1,28 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/desktop_gl_impl/shader_info.hpp"
+#include "fixie/fixie_gl_es.h"
+
+namespace fixie
+{
+    namespace desktop_gl_impl
+    {
+        TEST(shader_info_tests, alpha_test_changes_key)
+        {
+            caps caps;
+            state state(caps);
+            state.color_buffer_state().alpha_test_func() = GL_GREATER;
+
+            shader_info disabled_info(state, caps, GL_TRIANGLES, GL_FALSE, GL_FALSE);
+            EXPECT_EQ(disabled_info.alpha_test_func(), static_cast<GLenum>(GL_ALWAYS));
+
+            state.color_buffer_state().alpha_test_enabled() = GL_TRUE;
+            shader_info enabled_info(state, caps, GL_TRIANGLES, GL_FALSE, GL_FALSE);
+            EXPECT_EQ(enabled_info.alpha_test_func(), static_cast<GLenum>(GL_GREATER));
+
+            // Programs are cached by key, a different key selects a different program
+            EXPECT_TRUE(disabled_info != enabled_info);
+            EXPECT_NE(std::hash<shader_info>()(disabled_info), std::hash<shader_info>()(enabled_info));
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/null_impl/context.hpp"
+#include "fixie_lib/pixel_store_state.hpp"
+#include "fixie/fixie_gl_es.h"
+
+namespace fixie
+{
+    TEST(statistics_tests, unpacked_image_size)
+    {
+        pixel_store_state store_state = default_pixel_store_state();
+        EXPECT_EQ(unpacked_image_size(store_state, 4, 4, GL_RGBA, GL_UNSIGNED_BYTE), 64);
+        EXPECT_EQ(unpacked_image_size(store_state, 3, 2, GL_RGB, GL_UNSIGNED_BYTE), 12 + 9);
+        EXPECT_EQ(unpacked_image_size(store_state, 3, 2, GL_RGB, GL_UNSIGNED_SHORT_5_6_5), 8 + 6);
+
+        store_state.unpack_alignment() = 1;
+        EXPECT_EQ(unpacked_image_size(store_state, 3, 2, GL_RGB, GL_UNSIGNED_BYTE), 18);
+        EXPECT_EQ(unpacked_image_size(store_state, 3, 0, GL_RGB, GL_UNSIGNED_BYTE), 0);
+    }
+
+    TEST(statistics_tests, null_context_counters)
+    {
+        null_impl::context context;
+        state state(context.caps());
+
+        context.draw_arrays(state, GL_TRIANGLES, 0, 3);
+        context.draw_elements(state, GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, nullptr);
+        EXPECT_EQ(context.statistics().draw_calls(), 2u);
+
+        std::vector<GLubyte> data(128);
+
+        std::unique_ptr<buffer_impl> buffer = context.create_buffer();
+        buffer->set_data(128, nullptr, GL_STATIC_DRAW);
+        EXPECT_EQ(context.statistics().buffer_upload_bytes(), 0u);
+        buffer->set_data(128, data.data(), GL_STATIC_DRAW);
+        buffer->set_sub_data(32, 16, data.data());
+        EXPECT_EQ(context.statistics().buffer_upload_bytes(), 144u);
+
+        std::unique_ptr<texture_impl> texture = context.create_texture();
+        texture->set_data(default_pixel_store_state(), 0, GL_RGBA, 2, 2, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        EXPECT_EQ(context.statistics().texture_upload_bytes(), 0u);
+        texture->set_data(default_pixel_store_state(), 0, GL_RGBA, 2, 2, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+        EXPECT_EQ(context.statistics().texture_upload_bytes(), 16u);
+
+        context.statistics() = statistics();
+        EXPECT_EQ(context.statistics().draw_calls(), 0u);
+        EXPECT_EQ(context.statistics().buffer_upload_bytes(), 0u);
+    }
+}
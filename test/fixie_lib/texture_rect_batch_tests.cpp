@@ -0,0 +1,30 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/texture_rect_batch.hpp"
+
+namespace fixie
+{
+    TEST(texture_rect_batch_tests, interleaves_rects_and_texcoords)
+    {
+        texture_rect_batch batch(2);
+        EXPECT_TRUE(batch.empty());
+        EXPECT_EQ(batch.stride(), static_cast<GLsizei>(13 * sizeof(GLfloat)));
+
+        batch.add_rect(1.0f, 2.0f, 0.5f, 3.0f, 4.0f);
+        batch.set_texcoord_rect(1, 0.25f, 0.5f, 0.75f, 1.0f);
+        batch.add_rect(5.0f, 6.0f, 0.0f, 7.0f, 8.0f);
+        EXPECT_EQ(batch.size(), 2u);
+
+        const GLfloat* rect = batch.data();
+        EXPECT_EQ(rect[batch.rect_offset() / sizeof(GLfloat) + 2], 3.0f);
+        EXPECT_EQ(rect[batch.depth_offset() / sizeof(GLfloat)], 0.5f);
+        EXPECT_EQ(rect[batch.texcoord_offset(0) / sizeof(GLfloat)], 0.0f);
+        EXPECT_EQ(rect[batch.texcoord_offset(1) / sizeof(GLfloat) + 3], 1.0f);
+
+        const GLfloat* second_rect = batch.data() + batch.stride() / sizeof(GLfloat);
+        EXPECT_EQ(second_rect[batch.rect_offset() / sizeof(GLfloat)], 5.0f);
+
+        batch.clear();
+        EXPECT_TRUE(batch.empty());
+    }
+}
@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+
+#include "fixie_lib/tracer.hpp"
+
+#include <sstream>
+#include <thread>
+
+namespace fixie
+{
+    static size_t count_occurrences(const std::string& str, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + pattern.length()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    static std::string trace_string()
+    {
+        std::ostringstream stream;
+        write_trace(stream);
+        return stream.str();
+    }
+
+    TEST(tracer_tests, disabled_scopes_are_not_recorded)
+    {
+        set_tracing_enabled(false);
+        clear_trace();
+        {
+            FIXIE_TRACE_SCOPE("test", "disabled_scope");
+        }
+        EXPECT_EQ(count_occurrences(trace_string(), "disabled_scope"), 0u);
+    }
+
+    TEST(tracer_tests, scopes_from_multiple_threads)
+    {
+        set_tracing_enabled(true);
+        clear_trace();
+        {
+            FIXIE_TRACE_SCOPE("test", "outer_scope");
+            FIXIE_TRACE_SCOPE("test", "inner_scope");
+        }
+        std::thread thread([]() { FIXIE_TRACE_SCOPE("test", "thread_scope"); });
+        thread.join();
+        set_tracing_enabled(false);
+
+        std::string trace = trace_string();
+        EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+        EXPECT_EQ(count_occurrences(trace, "\"name\":\"outer_scope\",\"cat\":\"test\",\"ph\":\"X\""), 1u);
+        EXPECT_EQ(count_occurrences(trace, "\"name\":\"inner_scope\""), 1u);
+        EXPECT_EQ(count_occurrences(trace, "\"name\":\"thread_scope\""), 1u);
+    }
+
+    TEST(tracer_tests, ring_buffer_keeps_newest_events)
+    {
+        set_tracing_enabled(true);
+        clear_trace();
+        {
+            FIXIE_TRACE_SCOPE("test", "oldest_scope");
+        }
+        for (size_t i = 0; i < max_trace_events_per_thread; i++)
+        {
+            FIXIE_TRACE_SCOPE("test", "filler_scope");
+        }
+        set_tracing_enabled(false);
+
+        std::string trace = trace_string();
+        EXPECT_EQ(count_occurrences(trace, "oldest_scope"), 0u);
+        EXPECT_EQ(count_occurrences(trace, "filler_scope"), max_trace_events_per_thread);
+    }
+}